@@ -0,0 +1,328 @@
+﻿#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "app.h"
+#include "BatchHull.h"
+#include "ConvexHull.h"
+#include "DataGenerator.h"
+#include "DynamicHull.h"
+#include "QuickHull3D.h"
+
+// Default arguments, placed in front of the command line arguments so they can be overridden
+constexpr const char* DEFAULT_ARGUMENTS[] = {"--benchmark_min_warmup_time=0.2", "--benchmark_repetitions=3",
+                                             "--benchmark_display_aggregates_only=true"};
+constexpr std::size_t MIN_POINTS = 1000;
+constexpr std::size_t DEFAULT_MAX_POINTS = 100000000;
+constexpr double QUADRATIC_WORK_LIMIT = 1e10; // Jarvis March is O(N*h), skipped above this number of steps
+constexpr std::size_t MIN_SETS = 10000;
+constexpr std::uint32_t MIN_SET_SIZE = 10;          // Small sets of the batch benchmark have 10 to 200 points
+constexpr std::uint32_t SET_SIZE_RANGE = 191;
+constexpr std::size_t MAX_DYNAMIC_POINTS = 1000000;
+constexpr std::size_t MAX_3D_POINTS = 10000000;
+constexpr std::size_t MAX_SPHERE_POINTS = 1000000;   // Every point of the sphere is a hull vertex (2n faces)
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Allocation counting: every operator new of the process increments these counters, the benchmark reports the
+// difference over the hull computation (all threads, including the OpenMP workers)
+
+static std::atomic<std::uint64_t> allocationCount{0};
+static std::atomic<std::uint64_t> allocationBytes{0};
+
+static void* countedAllocate(std::size_t size, std::size_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0)
+        size = 1;
+    void* memory;
+#ifdef _WIN32
+    memory = _aligned_malloc(size, alignment);
+#else
+    memory = alignment <= alignof(std::max_align_t) ? std::malloc(size)
+                                                    : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    if (memory == nullptr)
+        throw std::bad_alloc();
+    return memory;
+}
+
+static void countedFree(void* memory)
+{
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size) { return countedAllocate(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAllocate(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAllocate(size, static_cast<std::size_t>(alignment)); }
+void operator delete(void* memory) noexcept { countedFree(memory); }
+void operator delete[](void* memory) noexcept { countedFree(memory); }
+void operator delete(void* memory, std::size_t) noexcept { countedFree(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { countedFree(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { countedFree(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { countedFree(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { countedFree(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { countedFree(memory); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+// The benchmarks are registered generator by generator, so consecutive benchmarks share the generated points
+static const std::vector<ei::Vec2>& dataset(Generator generator, std::size_t numPoints)
+{
+    static int cachedGenerator = -1;
+    static std::vector<ei::Vec2> cachedPoints;
+    if (cachedGenerator != generator || cachedPoints.size() != numPoints)
+    {
+        cachedPoints.clear();
+        cachedPoints.shrink_to_fit();
+        cachedPoints = DataGenerator::GeneratePoints(generator, numPoints);
+        cachedGenerator = generator;
+    }
+    return cachedPoints;
+}
+
+static void hullBenchmark(benchmark::State& state, Algorithm algorithm, Generator generator)
+{
+    const std::size_t numPoints = static_cast<std::size_t>(state.range(0));
+    const std::vector<ei::Vec2>& points = dataset(generator, numPoints);
+    std::vector<ei::Vec2> input;
+    std::size_t hullSize = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        // NOTE: computeHull takes the points by reference, every iteration gets a fresh copy (same capacity, no allocation)
+        state.PauseTiming();
+        input = points;
+        state.ResumeTiming();
+
+        const std::uint64_t countBefore = allocationCount.load(std::memory_order_relaxed);
+        const std::uint64_t bytesBefore = allocationBytes.load(std::memory_order_relaxed);
+        std::vector<ei::Vec2> hull = computeHull(algorithm, input);
+        allocations += allocationCount.load(std::memory_order_relaxed) - countBefore;
+        bytes += allocationBytes.load(std::memory_order_relaxed) - bytesBefore;
+
+        hullSize = hull.size();
+        benchmark::DoNotOptimize(hull.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(numPoints));
+    state.counters["hull_size"] = static_cast<double>(hullSize);
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    state.counters["alloc_bytes"] = benchmark::Counter(static_cast<double>(bytes), benchmark::Counter::kAvgIterations,
+                                                       benchmark::Counter::kIs1024);
+}
+
+/**
+ * Many small independent point sets in CSR layout (random points, 10 to 200 per set): one batch_hull_indices call
+ * against one hull_indices call per set. Items are points, hull_size is the total number of hull indices.
+ */
+static void batchBenchmark(benchmark::State& state, bool batched)
+{
+    const std::size_t sets = static_cast<std::size_t>(state.range(0));
+    std::vector<std::uint32_t> offsets(sets + 1, 0);
+    for (std::size_t set = 0; set < sets; ++set)
+        offsets[set + 1] = offsets[set] + MIN_SET_SIZE + static_cast<std::uint32_t>(set * 37 % SET_SIZE_RANGE);
+    const std::vector<ei::Vec2>& points = dataset(RANDOM_POINTS, offsets.back());
+    std::vector<float> xs(points.size()), ys(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+    }
+    std::vector<std::uint32_t> hullOffsets(sets + 1);
+    std::vector<std::uint32_t> hullIndices(points.size());
+    std::size_t hullSize = 0;
+
+    for (auto _ : state)
+    {
+        if (batched)
+        {
+            hullSize = batch_hull_indices(offsets, xs, ys, hullOffsets, hullIndices);
+        }
+        else
+        {
+            hullSize = 0;
+            for (std::size_t set = 0; set < sets; ++set)
+            {
+                const std::size_t first = offsets[set];
+                const std::size_t size = offsets[set + 1] - first;
+                hullSize += hull_indices({xs.data() + first, size}, {ys.data() + first, size},
+                                         {hullIndices.data() + first, size});
+            }
+        }
+        benchmark::DoNotOptimize(hullIndices.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(points.size()));
+    state.counters["hull_size"] = static_cast<double>(hullSize);
+}
+
+// Online updates: every point is inserted into a DynamicHull, then all points are erased again in random order
+static void dynamicHullBenchmark(benchmark::State& state, Generator generator)
+{
+    const std::size_t numPoints = static_cast<std::size_t>(state.range(0));
+    const std::vector<ei::Vec2>& points = dataset(generator, numPoints);
+    std::vector<ei::Vec2> erased(points);
+    std::shuffle(erased.begin(), erased.end(), std::mt19937_64(DataGenerator::DEFAULT_SEED));
+    std::size_t hullSize = 0;
+
+    for (auto _ : state)
+    {
+        DynamicHull hull;
+        for (const auto& point : points)
+            hull.insert(point);
+        hullSize = hull.hullSize();
+        for (const auto& point : erased)
+            hull.erase(point);
+        benchmark::DoNotOptimize(hull.size());
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * 2 * static_cast<std::int64_t>(numPoints));
+    state.counters["hull_size"] = static_cast<double>(hullSize);
+}
+
+// QuickHull 3D on the 3D counterpart of the generator, hull_size is the number of faces
+static void quickHull3DBenchmark(benchmark::State& state, Generator generator)
+{
+    const std::size_t numPoints = static_cast<std::size_t>(state.range(0));
+    const std::vector<ei::Vec3> points = DataGenerator::GeneratePoints3D(generator, numPoints);
+    std::size_t faces = 0;
+
+    for (auto _ : state)
+    {
+        std::vector<std::uint32_t> triangles = quick_hull_3d(points);
+        faces = triangles.size() / 3;
+        benchmark::DoNotOptimize(triangles.data());
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(numPoints));
+    state.counters["hull_size"] = static_cast<double>(faces);
+}
+
+// "QuickHull (SIMD)" -> "quickhull_simd", so the names work in --benchmark_filter without quoting
+static std::string identifier(const std::string& name)
+{
+    std::string result;
+    for (char character : name)
+    {
+        if (std::isalnum(static_cast<unsigned char>(character)))
+            result += static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+        else if (character != '\'' && !result.empty() && result.back() != '_')
+            result += '_';
+    }
+    while (!result.empty() && result.back() == '_')
+        result.pop_back();
+    return result;
+}
+
+// Registers algorithm x generator x n (powers of 10 up to maxPoints), QuickHull 3D, the small set batches and the
+// dynamic hull
+static void registerBenchmarks(std::size_t maxPoints)
+{
+    // Test case 4 (large dataset) is the random distribution
+    constexpr Generator GENERATORS[] = {RANDOM_POINTS, STRAIGHT_LINE, CIRCLE, SQUARE, GAUSSIAN_CLUSTER, ANNULUS, CLUSTERS};
+    for (Generator generator : GENERATORS)
+    {
+        for (std::size_t numPoints = MIN_POINTS; numPoints <= maxPoints; numPoints *= 10)
+        {
+            for (int algorithm = 0; algorithm < INVALID_ALGORITHM; ++algorithm)
+            {
+                // Every point of the circle is a hull point
+                const bool quadratic = algorithm == JARVIS_MARCH;
+                if (quadratic && generator == CIRCLE && static_cast<double>(numPoints) * numPoints > QUADRATIC_WORK_LIMIT)
+                    continue;
+
+                const std::string name = identifier(algorithmToString(static_cast<Algorithm>(algorithm))) + "/" +
+                                         identifier(generatorToString(generator));
+                benchmark::RegisterBenchmark(name.c_str(), hullBenchmark, static_cast<Algorithm>(algorithm), generator)
+                    ->Arg(static_cast<std::int64_t>(numPoints))
+                    ->ArgName("n")
+                    ->UseRealTime()
+                    ->Unit(benchmark::kMillisecond);
+            }
+        }
+    }
+
+    for (Generator generator : GENERATORS)
+    {
+        const std::size_t limit = std::min(maxPoints, generator == CIRCLE ? MAX_SPHERE_POINTS : MAX_3D_POINTS);
+        for (std::size_t numPoints = MIN_POINTS; numPoints <= limit; numPoints *= 10)
+        {
+            const std::string name = "quickhull_3d/" + identifier(generatorToString(generator));
+            benchmark::RegisterBenchmark(name.c_str(), quickHull3DBenchmark, generator)
+                ->Arg(static_cast<std::int64_t>(numPoints))
+                ->ArgName("n")
+                ->UseRealTime()
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+
+    for (Generator generator : {RANDOM_POINTS, CIRCLE})
+    {
+        for (std::size_t numPoints = MIN_POINTS; numPoints <= std::min(maxPoints, MAX_DYNAMIC_POINTS); numPoints *= 10)
+        {
+            const std::string name = "dynamic_hull/" + identifier(generatorToString(generator));
+            benchmark::RegisterBenchmark(name.c_str(), dynamicHullBenchmark, generator)
+                ->Arg(static_cast<std::int64_t>(numPoints))
+                ->ArgName("n")
+                ->UseRealTime()
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+
+    // About 105 points per set on average
+    for (std::size_t sets = MIN_SETS; sets * (MIN_SET_SIZE + SET_SIZE_RANGE / 2) <= maxPoints; sets *= 10)
+    {
+        for (bool batched : {true, false})
+        {
+            benchmark::RegisterBenchmark(batched ? "batch/small_sets" : "per_set/small_sets", batchBenchmark, batched)
+                ->Arg(static_cast<std::int64_t>(sets))
+                ->ArgName("sets")
+                ->UseRealTime()
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // --max_points=N limits the largest dataset (the remaining arguments are passed to Google Benchmark)
+    std::size_t maxPoints = DEFAULT_MAX_POINTS;
+    std::vector<char*> arguments = {argv[0]};
+    for (const char* argument : DEFAULT_ARGUMENTS)
+        arguments.push_back(const_cast<char*>(argument));
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        const std::string option = "--max_points=";
+        if (argument.rfind(option, 0) == 0)
+            maxPoints = std::strtoull(argument.c_str() + option.size(), nullptr, 10);
+        else
+            arguments.push_back(argv[i]);
+    }
+    int count = static_cast<int>(arguments.size());
+
+    registerBenchmarks(maxPoints);
+    benchmark::Initialize(&count, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(count, arguments.data()))
+        return EXIT_FAILURE;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return EXIT_SUCCESS;
+}
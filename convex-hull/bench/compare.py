@@ -0,0 +1,69 @@
+﻿import argparse
+import json
+import sys
+
+# Compares two JSON results of convex_hull_bench (--benchmark_out=FILE --benchmark_out_format=json).
+# The median of the repetitions is compared (or the mean of the iterations for runs without repetitions).
+# Exits with 1 if a hull size differs or if the throughput of a benchmark dropped by more than the threshold.
+
+
+def load_results(filename):
+    with open(filename) as f:
+        benchmarks = json.load(f)["benchmarks"]
+
+    results = {}
+    runs = {}
+    for benchmark in benchmarks:
+        name = benchmark["run_name"]
+        if benchmark.get("run_type") == "aggregate":
+            if benchmark.get("aggregate_name") == "median":
+                results[name] = benchmark
+        elif "error_occurred" not in benchmark:
+            runs.setdefault(name, []).append(benchmark)
+
+    for name, iterations in runs.items():
+        if name not in results:
+            results[name] = {
+                "items_per_second": sum(run["items_per_second"] for run in iterations) / len(iterations),
+                "hull_size": iterations[0]["hull_size"],
+                "allocs": iterations[0]["allocs"],
+            }
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare convex_hull_bench results against a baseline")
+    parser.add_argument("baseline", help="JSON result of the baseline run")
+    parser.add_argument("current", help="JSON result of the current run")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="Allowed throughput drop in percent (default: 10)")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    failed = False
+    print(f"{'Benchmark':<48}{'Baseline [pts/s]':>18}{'Current [pts/s]':>18}{'Change':>10}{'Allocs':>16}")
+    for name in sorted(current.keys() & baseline.keys()):
+        old, new = baseline[name], current[name]
+        change = (new["items_per_second"] / old["items_per_second"] - 1.0) * 100.0
+        note = ""
+        if new["hull_size"] != old["hull_size"]:
+            note = f"  hull size {old['hull_size']:.0f} -> {new['hull_size']:.0f}"
+            failed = True
+        elif change < -args.threshold:
+            note = "  slower"
+            failed = True
+        allocs = f"{old['allocs']:.0f} -> {new['allocs']:.0f}"
+        print(f"{name:<48}{old['items_per_second']:>18.4g}{new['items_per_second']:>18.4g}{change:>9.1f}%{allocs:>16}{note}")
+
+    for name in sorted(baseline.keys() - current.keys()):
+        print(f"{name:<48} missing in current run")
+    for name in sorted(current.keys() - baseline.keys()):
+        print(f"{name:<48} not in baseline")
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
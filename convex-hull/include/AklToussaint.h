@@ -0,0 +1,15 @@
+﻿#ifndef AKLTOUSSAINT_H
+#define AKLTOUSSAINT_H
+
+#include <vector>
+#include "ei/2dtypes.hpp"
+
+/**
+ * Akl-Toussaint heuristic: finds the 8 extreme points (min/max of x, y, x+y and x-y), which are all hull points,
+ * and removes every point strictly inside their octagon. The remaining points (in input order) have the same
+ * convex hull as the input, so they can be fed to any hull algorithm.
+ * Both the search for the extremes and the inside test run as SIMD loops (OpenMP simd) over blocks of points.
+ */
+std::vector<ei::Vec2> akl_toussaint_cull(const std::vector<ei::Vec2>& points);
+
+#endif //AKLTOUSSAINT_H
@@ -0,0 +1,28 @@
+﻿#ifndef BATCHHULL_H
+#define BATCHHULL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * Hulls of many independent point sets in CSR layout: set i consists of the points [offsets[i], offsets[i + 1]) of
+ * the flat coordinate arrays xs/ys. The hull of set i is written to hullIndices[hullOffsets[i], hullOffsets[i + 1])
+ * as indices into xs/ys, in counterclockwise order starting at the lexicographically smallest point (like
+ * monotone_chain_performance). Collinear points are not part of a hull, a repeated hull point is reported with its
+ * smallest index.
+ *
+ * The sets are processed on all cores. They are grouped by size, so the threads first take the large sets
+ * (index-based QuickHull) and then the small ones, which run through a cull + sort + monotone chain kernel over a
+ * per-thread scratch arena without any allocation per set.
+ *
+ * hullOffsets receives offsets.size() entries (starting at 0), hullIndices needs room for
+ * offsets.back() - offsets.front() indices (every point can be a hull point). Throws std::invalid_argument if the spans do not fit together or the
+ * offsets are not ascending.
+ * @return Total number of hull indices (hullOffsets.back()).
+ */
+std::size_t batch_hull_indices(std::span<const std::uint32_t> offsets, std::span<const float> xs,
+                               std::span<const float> ys, std::span<std::uint32_t> hullOffsets,
+                               std::span<std::uint32_t> hullIndices);
+
+#endif //BATCHHULL_H
@@ -0,0 +1,16 @@
+﻿#ifndef CHANSALGORITHM_H
+#define CHANSALGORITHM_H
+#include <vector>
+#include "ei/2dtypes.hpp"
+#include "app.h"
+
+/**
+ * Chan's algorithm, output-sensitive O(N Log(h)).
+ * The points are split into groups of m points and the hull of every group is built in parallel (monotone chain).
+ * Then at most m gift wrapping steps are made over the group hulls, where the tangent from the current hull point
+ * to every group hull is found with a binary search. If the hull is not closed after m steps, m is squared.
+ * Returns the hull in counterclockwise order (screen coordinates: clockwise), starting at the leftmost point.
+ */
+std::vector<ei::Vec2> chans_algorithm_performance(const INPUT_PARAMETER& points);
+
+#endif //CHANSALGORITHM_H
@@ -0,0 +1,30 @@
+﻿#ifndef CONVEXHULL_H
+#define CONVEXHULL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "ei/2dtypes.hpp"
+#include "app.h"
+
+// Entry points of the headless convex_hull_core library (no SFML): only the performance versions of the algorithms.
+
+// Runs the performance version of the given algorithm (may reorder the points)
+std::vector<ei::Vec2> computeHull(Algorithm algorithm, std::vector<ei::Vec2>& points);
+
+/**
+ * Plain-data variant of computeHull: the caller keeps its points (never modified) and gets the index of every hull
+ * point in the order the algorithm returns the hull. If a hull point occurs several times, its first index is used.
+ */
+std::vector<std::uint32_t> hull_indices(Algorithm algorithm, std::span<const ei::Vec2> points);
+
+/**
+ * Allocation-free hull over caller-owned coordinate arrays (index-based QuickHull, see quick_hull_indices).
+ * The coordinates are never modified. out is caller-provided scratch with room for one index per point; on return
+ * it starts with the indices of the hull points. Throws std::invalid_argument if the spans do not fit together.
+ * @return Number of hull indices at the front of out.
+ */
+std::size_t hull_indices(std::span<const float> xs, std::span<const float> ys, std::span<std::uint32_t> out);
+
+#endif //CONVEXHULL_H
@@ -5,10 +5,11 @@
 #ifndef DATAGENERATOR_H
 #define DATAGENERATOR_H
 
+#include <cstdint>
 #include <vector>
-#include <random>
 #include <cmath>
 #include "ei/2dtypes.hpp"
+#include "ei/3dtypes.hpp"
 #include "app.h"
 
 enum Generator
@@ -16,7 +17,11 @@ enum Generator
     RANDOM_POINTS = 0,
     STRAIGHT_LINE = 1,
     CIRCLE = 2,
-    SQUARE = 3
+    SQUARE = 3,
+    LARGE_DATASET = 4,      ///< Random points, meant for large -n
+    GAUSSIAN_CLUSTER = 5,
+    ANNULUS = 6,
+    CLUSTERS = 7
 };
 
 inline std::string generatorToString(Generator generator)
@@ -31,26 +36,69 @@ inline std::string generatorToString(Generator generator)
         return "Circle";
     case SQUARE:
         return "Square";
+    case LARGE_DATASET:
+        return "Large Dataset";
+    case GAUSSIAN_CLUSTER:
+        return "Gaussian Cluster";
+    case ANNULUS:
+        return "Annulus";
+    case CLUSTERS:
+        return "Clusters";
     default:
         return "Unknown";
     }
 }
 
+/**
+ * All generators draw from a counter-based random number generator: the j-th random number of point i is a hash of
+ * (seed, i, j). Every point is independent of all others, so the points are generated in parallel chunks and the
+ * same seed yields the same points for any number of threads.
+ */
 class DataGenerator {
 public:
-    static std::vector<ei::Vec2> GeneratePoints(Generator generator, size_t numPoints);
+    static constexpr std::uint64_t DEFAULT_SEED = 0;
+
+    static std::vector<ei::Vec2> GeneratePoints(Generator generator, size_t numPoints, std::uint64_t seed = DEFAULT_SEED);
+
+    // Generate points inside a regular polygon, the convex hull consists of exactly its hullPoints corners.
+    static std::vector<ei::Vec2> GeneratePolygon(size_t numPoints, size_t hullPoints, std::uint64_t seed = DEFAULT_SEED);
+
+    /**
+     * 3D counterpart of every generator (--3d): random points in a box, a straight line, a sphere (circle), a cube with
+     * its corners (square), a Gaussian cluster, a thin spherical shell (annulus) and clusters. The depth of the box is
+     * the window height.
+     */
+    static std::vector<ei::Vec3> GeneratePoints3D(Generator generator, size_t numPoints, std::uint64_t seed = DEFAULT_SEED);
 private:
     // 1. Generate a random distribution of points.
-    static std::vector<ei::Vec2> GenerateRandomPoints(size_t numPoints);
+    static std::vector<ei::Vec2> GenerateRandomPoints(size_t numPoints, std::uint64_t seed);
 
     // 2. Generate points forming a straight line.
-    static std::vector<ei::Vec2> GenerateStraightLine(size_t numPoints);
+    static std::vector<ei::Vec2> GenerateStraightLine(size_t numPoints, std::uint64_t seed);
 
     // 3. Generate points forming a circle.
     static std::vector<ei::Vec2> GenerateCircle(size_t numPoints);
 
     // 4. Generate a random distribution inside a square box.
-    static std::vector<ei::Vec2> GeneratePointsInSquare(size_t numPoints);
+    static std::vector<ei::Vec2> GeneratePointsInSquare(size_t numPoints, std::uint64_t seed);
+
+    // 5. Generate a normal distribution around the center (very few hull points).
+    static std::vector<ei::Vec2> GenerateGaussianCluster(size_t numPoints, std::uint64_t seed);
+
+    // 6. Generate a uniform distribution inside a thin ring (many hull points, but not all as on the circle).
+    static std::vector<ei::Vec2> GenerateAnnulus(size_t numPoints, std::uint64_t seed);
+
+    // 7. Generate many small normal distributions at random centers.
+    static std::vector<ei::Vec2> GenerateClusters(size_t numPoints, std::uint64_t seed);
+
+    // 3D generators, see GeneratePoints3D
+    static std::vector<ei::Vec3> GenerateRandomPoints3D(size_t numPoints, std::uint64_t seed);
+    static std::vector<ei::Vec3> GenerateStraightLine3D(size_t numPoints, std::uint64_t seed);
+    static std::vector<ei::Vec3> GenerateSphere(size_t numPoints);
+    static std::vector<ei::Vec3> GeneratePointsInCube(size_t numPoints, std::uint64_t seed);
+    static std::vector<ei::Vec3> GenerateGaussianCluster3D(size_t numPoints, std::uint64_t seed);
+    static std::vector<ei::Vec3> GenerateShell(size_t numPoints, std::uint64_t seed);
+    static std::vector<ei::Vec3> GenerateClusters3D(size_t numPoints, std::uint64_t seed);
 };
 
 
@@ -0,0 +1,23 @@
+﻿#ifndef DIVIDEANDCONQUER_H
+#define DIVIDEANDCONQUER_H
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "ei/2dtypes.hpp"
+#include "app.h"
+
+/**
+ * Merge hull: the points are sorted by x once (parallel merge sort), then the upper and lower hull chains of both
+ * halves are built recursively (concurrently as OpenMP tasks) and merged at their upper/lower tangent.
+ * Returns the hull in counterclockwise order (screen coordinates: clockwise), starting at the leftmost point.
+ */
+std::vector<ei::Vec2> divide_and_conquer_performance(const INPUT_PARAMETER& points);
+
+// Chain helpers, shared with the visualization (see DivideAndConquer.cpp)
+std::pair<size_t, size_t> findTangent(const ei::Vec2* left, size_t leftCount,
+                                      const ei::Vec2* right, size_t rightCount, int side);
+size_t joinChains(ei::Vec2* left, size_t i, const ei::Vec2* right, size_t j, size_t rightCount);
+std::vector<ei::Vec2> chainsToHull(const ei::Vec2* upper, size_t upperCount,
+                                   const ei::Vec2* lower, size_t lowerCount);
+
+#endif //DIVIDEANDCONQUER_H
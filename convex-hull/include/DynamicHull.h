@@ -0,0 +1,115 @@
+﻿#ifndef DYNAMICHULL_H
+#define DYNAMICHULL_H
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+#include "ei/2dtypes.hpp"
+
+/**
+ * Convex hull of a changing point set (e.g. a fleet of moving objects: every move is an erase and an insert).
+ * The hull is kept as lower and upper chain (Andrew's monotone chain, ordered by x, then y), each in a balanced tree
+ * (std::set), next to all points in a sorted map.
+ *
+ * - insert: O(log n) amortized. A point inside the hull only updates the point map, otherwise it is added to the
+ *   chains and the vertices it hides are removed (every vertex is removed at most once per insertion).
+ * - erase: O(log n) unless the point is a hull vertex. Then the chain between its two neighbours (which stay hull
+ *   vertices) is rebuilt from the points lying between them, i.e. O(k) for k points in that x range. For random
+ *   updates this is O(1) on average (a point is a hull vertex with probability h / n and its range holds about n / h
+ *   points), but adversarial orders degrade to O(n) per erase, e.g. erasing the points of a circle in angular order.
+ * - Queries (contains, extremePoint, tangents) are binary searches on the chains, O(log h).
+ *
+ * All orientation decisions use the exact predicate orient2d (Predicates.h). Collinear points are not hull vertices.
+ */
+class DynamicHull
+{
+public:
+    DynamicHull() = default;
+    explicit DynamicHull(const std::vector<ei::Vec2>& points);
+
+    // Adds a point (points may be added several times)
+    void insert(const ei::Vec2& point);
+    // Removes one occurrence of the point, false if it is not part of the set
+    bool erase(const ei::Vec2& point);
+    void clear();
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::size_t hullSize() const;
+
+    // Hull in counterclockwise order, starting at the lexicographically smallest point (like monotone_chain_performance)
+    std::vector<ei::Vec2> hull() const;
+
+    // True if the point lies inside the hull or on its boundary
+    bool contains(const ei::Vec2& point) const;
+
+    /**
+     * Hull vertex with the largest dot product with direction (the first one in counterclockwise order if an edge is
+     * perpendicular to direction). The dot products of the hull edges are evaluated in double precision.
+     * Throws std::invalid_argument for the zero vector, empty if there are no points.
+     */
+    std::optional<ei::Vec2> extremePoint(const ei::Vec2& direction) const;
+
+    /**
+     * Tangent points of the hull as seen from an external point: the first and the last hull vertex of the part of the
+     * boundary that is visible from the point, in counterclockwise order. The whole hull lies between the lines from
+     * the point through these vertices. Empty if the point is inside the hull, on its boundary or there are no points.
+     */
+    std::optional<std::pair<ei::Vec2, ei::Vec2>> tangents(const ei::Vec2& point) const;
+
+private:
+    // Hull vertex, together with the following vertex of its chain (the edge starting at this vertex)
+    struct ChainVertex
+    {
+        ei::Vec2 point;
+        mutable ei::Vec2 next{};
+        mutable bool hasNext = false;
+    };
+
+    // Heterogeneous key of std::set::lower_bound: the chain is partitioned by before (true for a prefix of the chain)
+    template<typename Predicate>
+    struct ChainSearch
+    {
+        Predicate before;
+    };
+
+    struct PointOrder
+    {
+        bool operator()(const ei::Vec2& a, const ei::Vec2& b) const { return a.x < b.x || (a.x == b.x && a.y < b.y); }
+    };
+
+    struct ChainOrder
+    {
+        using is_transparent = void;
+
+        bool operator()(const ChainVertex& a, const ChainVertex& b) const { return PointOrder()(a.point, b.point); }
+        template<typename Predicate>
+        bool operator()(const ChainVertex& vertex, const ChainSearch<Predicate>& search) const
+        {
+            return search.before(vertex);
+        }
+    };
+
+    using Chain = std::set<ChainVertex, ChainOrder>;
+
+    // side is 1 for the lower chain (counterclockwise from left to right) and -1 for the upper chain (clockwise)
+    static constexpr int LOWER = 1;
+    static constexpr int UPPER = -1;
+
+    void insertIntoChain(Chain& chain, int side, const ei::Vec2& point);
+    void rebuildChain(Chain& chain, int side, Chain::iterator vertex);
+    static void link(const Chain& chain, Chain::const_iterator vertex);
+    static std::pair<Chain::const_iterator, Chain::const_iterator> visibleEdges(const Chain& chain, int side,
+                                                                                const ei::Vec2& point);
+
+    std::map<ei::Vec2, std::size_t, PointOrder> points; ///< Every point with its number of occurrences
+    std::size_t count = 0;
+    Chain lower;
+    Chain upper;
+    std::vector<ei::Vec2> stack; ///< Work space of rebuildChain
+};
+
+#endif //DYNAMICHULL_H
@@ -5,14 +5,25 @@
 
 #ifndef JARVISMARCH_H
 #define JARVISMARCH_H
-#include "VisualAlgorithm.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "ei/2dtypes.hpp"
+#include "app.h"
 
 const short ORIENTATION_COLLINEAR = 0;
 const short ORIENTATION_CLOCKWISE = 1;
 const short ORIENTATION_COUNTERCLOCKWISE = -1;
 
 // Only added public functions in header
-std::vector<ei::Vec2> jarvis_march_performance(INPUT_PARAMETER& points);
-AlgorithmGenerator jarvis_march_visualization(INPUT_PARAMETER& points);
+// Thin wrapper around jarvis_march_indices (the points are split into coordinate arrays once)
+std::vector<ei::Vec2> jarvis_march_performance(const INPUT_PARAMETER& points);
+// Jarvis March over caller-owned coordinate arrays, classifies the points with the SIMD orientation kernel.
+// Same contract as quick_hull_indices (QuickHull.h): the input is not modified, nothing is allocated, out needs room
+// for one index per point and on return starts with the hull indices (starting at the lexicographically smallest point)
+std::size_t jarvis_march_indices(std::span<const float> xs, std::span<const float> ys, std::span<std::uint32_t> out);
+// Orientation of the turn a -> b -> c (exact predicate), one of the ORIENTATION_ constants
+short check_orientation(ei::Vec2 a, ei::Vec2 b, ei::Vec2 c);
 
 #endif //JARVISMARCH_H
@@ -0,0 +1,14 @@
+﻿#ifndef MONOTONECHAIN_H
+#define MONOTONECHAIN_H
+#include <vector>
+#include "ei/2dtypes.hpp"
+#include "app.h"
+
+/**
+ * Andrew's monotone chain: O(N Log(N)) worst case, independent of the number of hull points.
+ * The points are sorted with a parallel radix sort, then the lower and upper hull are built in one pass each.
+ * Returns the hull in counterclockwise order (screen coordinates: clockwise), starting at the leftmost point.
+ */
+std::vector<ei::Vec2> monotone_chain_performance(const INPUT_PARAMETER& points);
+
+#endif //MONOTONECHAIN_H
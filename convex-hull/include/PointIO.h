@@ -0,0 +1,95 @@
+﻿#ifndef POINTIO_H
+#define POINTIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "ei/2dtypes.hpp"
+#include "ei/3dtypes.hpp"
+
+/**
+ * Binary point file (all values little-endian):
+ *   char     magic[4]     "CHPB"
+ *   uint32_t scalarBytes  4 (float32) or 8 (float64 coordinates, narrowed to float when loading)
+ *   uint64_t count        number of points
+ * followed by count interleaved x, y pairs.
+ */
+constexpr char POINT_FILE_MAGIC[4] = {'C', 'H', 'P', 'B'};
+constexpr char POINT_FILE_3D_MAGIC[4] = {'C', 'H', 'P', '3'};  ///< Same header, followed by x, y, z triples
+constexpr std::size_t POINT_FILE_HEADER_SIZE = 16;
+constexpr std::size_t MIN_STREAM_CHUNK_BYTES = 4096; ///< Smallest chunk of a PointFileReader
+
+enum PointFileFormat
+{
+    TEXT_FORMAT = 0,
+    BINARY_FORMAT = 1
+};
+
+inline std::string pointFileFormatToString(PointFileFormat format)
+{
+    switch (format)
+    {
+    case TEXT_FORMAT:
+        return "text";
+    case BINARY_FORMAT:
+        return "binary";
+    default:
+        return "unknown";
+    }
+}
+
+/**
+ * Loads a point file, the format is detected from the first bytes (binary magic, otherwise text).
+ * The file is memory mapped: binary coordinates are copied without parsing, text lines
+ * ("count" line, then one "x y" line per point) are parsed in parallel chunks with std::from_chars.
+ * Throws std::runtime_error with a message naming the file or the line on any error.
+ */
+std::vector<ei::Vec2> load_points(const std::string& filename, PointFileFormat* format = nullptr);
+
+// Writes the points as binary point file with float32 coordinates. Throws std::runtime_error on failure.
+void save_points_binary(const std::string& filename, const std::vector<ei::Vec2>& points);
+
+// Loads a binary 3D point file (POINT_FILE_3D_MAGIC), float64 coordinates are narrowed to float. Throws std::runtime_error.
+std::vector<ei::Vec3> load_points_3d(const std::string& filename);
+
+// Writes the points as binary 3D point file with float32 coordinates. Throws std::runtime_error on failure.
+void save_points_3d_binary(const std::string& filename, const std::vector<ei::Vec3>& points);
+
+/**
+ * Reads a point file (text or binary, detected like load_points) sequentially in chunks of at most chunkBytes bytes,
+ * for files that do not fit into memory. Only the chunk buffer and the points of the current chunk are held.
+ * Text chunks end at a line end (the rest of the last line is kept for the next chunk) and are parsed in parallel.
+ * Throws std::runtime_error like load_points, std::invalid_argument if chunkBytes < MIN_STREAM_CHUNK_BYTES.
+ */
+class PointFileReader
+{
+public:
+    PointFileReader(const std::string& filename, std::size_t chunkBytes);
+
+    // Replaces points by the points of the next chunk, returns false (and no points) once all points were read
+    bool next(std::vector<ei::Vec2>& points);
+
+    PointFileFormat format() const { return fileFormat; }
+    std::uint64_t count() const { return pointCount; }  ///< Number of points of the file (header)
+    std::uint64_t pointsRead() const { return readPoints; }
+    std::uint64_t bytesRead() const { return fileBytes; }
+
+private:
+    void fill();
+
+    std::ifstream input;
+    std::string filename;
+    std::vector<char> buffer;
+    std::size_t filled = 0;     ///< Bytes of the file in buffer
+    std::size_t consumed = 0;   ///< Bytes at the front of buffer that were already parsed
+    bool endOfFile = false;
+    PointFileFormat fileFormat = TEXT_FORMAT;
+    std::uint32_t scalarBytes = 4;
+    std::uint64_t pointCount = 0;
+    std::uint64_t readPoints = 0;
+    std::uint64_t fileBytes = 0;
+};
+
+#endif //POINTIO_H
@@ -0,0 +1,79 @@
+﻿#ifndef POINTSSOA_H
+#define POINTSSOA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+#include "ei/2dtypes.hpp"
+
+// Allocator for over-aligned arrays, so SIMD kernels can start every array on a full vector (cache line)
+template<typename T, std::size_t Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* pointer, std::size_t)
+    {
+        ::operator delete(pointer, std::align_val_t{Alignment});
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+};
+
+/**
+ * Points as structure of arrays: all x coordinates, then all y coordinates, each array 64 byte aligned.
+ * Kernels (SimdKernels.h) load 8 or 16 coordinates of one axis with a single instruction instead of
+ * gathering them from interleaved ei::Vec2 structs.
+ */
+class PointsSoA
+{
+public:
+    static constexpr std::size_t ALIGNMENT = 64;
+
+    PointsSoA() = default;
+    explicit PointsSoA(std::size_t count) : xs(count), ys(count) {}
+    // Splits the points into the two coordinate arrays (parallel copy)
+    explicit PointsSoA(const std::vector<ei::Vec2>& points);
+
+    std::size_t size() const { return xs.size(); }
+    bool empty() const { return xs.empty(); }
+
+    float* x() { return xs.data(); }
+    float* y() { return ys.data(); }
+    const float* x() const { return xs.data(); }
+    const float* y() const { return ys.data(); }
+
+    ei::Vec2 operator[](std::size_t index) const { return {xs[index], ys[index]}; }
+    void set(std::size_t index, const ei::Vec2& point)
+    {
+        xs[index] = point.x;
+        ys[index] = point.y;
+    }
+    void swap(std::size_t first, std::size_t second);
+    void resize(std::size_t count);
+
+    std::vector<ei::Vec2> toPoints() const;
+    // Points at the given indices, in the order of the indices (e.g. the result of an index-based hull)
+    std::vector<ei::Vec2> gather(std::span<const std::uint32_t> indices) const;
+
+private:
+    std::vector<float, AlignedAllocator<float, ALIGNMENT>> xs;
+    std::vector<float, AlignedAllocator<float, ALIGNMENT>> ys;
+};
+
+#endif //POINTSSOA_H
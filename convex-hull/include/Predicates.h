@@ -0,0 +1,142 @@
+﻿#ifndef PREDICATES_H
+#define PREDICATES_H
+
+#include <cmath>
+#include "ei/2dtypes.hpp"
+#include "ei/3dtypes.hpp"
+
+/*
+ * Robust orientation predicate after Shewchuk ("Adaptive Precision Floating-Point Arithmetic and Fast Robust
+ * Geometric Predicates"): the determinant is computed in double precision together with a bound of its rounding
+ * error. Only if the error could flip the sign, the exact value is computed with expansion arithmetic.
+ */
+
+// Relative error bound of (a - c) x (b - c) evaluated in floating point with unit roundoff epsilon
+constexpr double orientErrorBound(double epsilon)
+{
+    return (3.0 + 16.0 * epsilon) * epsilon;
+}
+
+constexpr double ORIENT2D_ERROR_BOUND = orientErrorBound(0x1p-53);                        ///< Double precision
+constexpr float ORIENT2D_FLOAT_ERROR_BOUND = static_cast<float>(orientErrorBound(0x1p-24)); ///< Single precision (SIMD)
+constexpr double ORIENT3D_ERROR_BOUND = (7.0 + 56.0 * 0x1p-53) * 0x1p-53;                   ///< Shewchuk's o3derrboundA
+// Both products of orient2d are at most width * height of the points' bounding box, 2^-20 covers the rounding of the
+// products, of the box size and of the bound itself
+constexpr double ORIENT2D_STATIC_ERROR_BOUND = 2.0 * (1.0 + 0x1p-20) * ORIENT2D_FLOAT_ERROR_BOUND;
+
+// Exact sign of the orientation determinant (slow path of orient2d)
+int orient2d_exact(const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c);
+
+// Determinant of orient2d evaluated in double, its sign is exact if its magnitude exceeds errorBound
+inline double orient2dDouble(const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c, double& errorBound)
+{
+    const double left = (static_cast<double>(a.x) - c.x) * (static_cast<double>(b.y) - c.y);
+    const double right = (static_cast<double>(a.y) - c.y) * (static_cast<double>(b.x) - c.x);
+    errorBound = ORIENT2D_ERROR_BOUND * (std::fabs(left) + std::fabs(right));
+    return left - right;
+}
+
+/**
+ * Exact orientation of the points a, b, c.
+ * @return 1 if they make a counterclockwise turn (c is left of the line ab), -1 if clockwise (c is right of ab),
+ * 0 if they are collinear.
+ */
+inline int orient2d(const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c)
+{
+    double bound;
+    const double determinant = orient2dDouble(a, b, c, bound);
+
+    // Taken for all but nearly collinear points, so the branch is predictable and the sign is computed without one
+    if (std::fabs(determinant) > bound)
+        return (determinant > 0.0) - (determinant < 0.0);
+    // Both products are 0 (e.g. repeated points), the determinant is exactly 0
+    if (bound == 0.0)
+        return 0;
+    return orient2d_exact(a, b, c);
+}
+
+// orient2d of points within the error bound of the filters below. The points are passed by value, so the filters do
+// not force the caller's points (e.g. the line of a partition) out of registers
+int orient2d_uncertain(ei::Vec2 a, ei::Vec2 b, ei::Vec2 c);
+
+/**
+ * Error bound of the float determinant of orient2d for any three points within a bounding box of the given size.
+ * Infinite (every test is decided by orient2d) if the float products could underflow or overflow, where the
+ * bound does not hold.
+ */
+inline float orient2dStaticBound(double width, double height)
+{
+    const double bound = ORIENT2D_STATIC_ERROR_BOUND * width * height;
+    if (!(bound >= 0x1p-100 && width < 0x1p62 && height < 0x1p62))
+        return INFINITY;
+    return static_cast<float>(bound);
+}
+
+// Determinant of orient2d evaluated in float, its sign is exact if its magnitude exceeds the static bound
+inline float orient2dFloat(const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c)
+{
+    return (a.x - c.x) * (b.y - c.y) - (a.y - c.y) * (b.x - c.x);
+}
+
+/**
+ * orient2d with the error bound evaluated in float as well (dynamic filter in single precision). Unlike the static
+ * bound below it adapts to the scale of a, b and c, only nearly collinear points (or products below 2^-100, where
+ * float loses precision) are decided by orient2d.
+ */
+inline int orient2dFloatFiltered(const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c)
+{
+    const float left = (a.x - c.x) * (b.y - c.y);
+    const float right = (a.y - c.y) * (b.x - c.x);
+    const float determinant = left - right;
+    const float bound = ORIENT2D_FLOAT_ERROR_BOUND * (std::fabs(left) + std::fabs(right)) + 0x1p-100f;
+    // NOTE: Written as negation, so NaN (e.g. from infinite coordinates) is decided by orient2d as well
+    if (!(std::fabs(determinant) > bound)) [[unlikely]]
+        return orient2d_uncertain(a, b, c);
+    return (determinant > 0.0f) - (determinant < 0.0f);
+}
+
+/**
+ * orient2d with a precomputed error bound (orient2dStaticBound of a bounding box of a, b and c) for loops over many
+ * points (semi-static filter): a plain float cross product and a comparison against a constant. Points within the
+ * bound (nearly collinear relative to the box, e.g. neighbors along a dense hull) go to orient2dFloatFiltered.
+ */
+inline int orient2d(const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c, float staticBound)
+{
+    const float determinant = orient2dFloat(a, b, c);
+    // NOTE: Written as negation, so NaN (e.g. from infinite coordinates) is decided by orient2d as well
+    if (!(std::fabs(determinant) > staticBound)) [[unlikely]]
+        return orient2dFloatFiltered(a, b, c);
+    return (determinant > 0.0f) - (determinant < 0.0f);
+}
+
+// Exact sign of the 3D orientation determinant (slow path of orient3d)
+int orient3d_exact(const ei::Vec3& a, const ei::Vec3& b, const ei::Vec3& c, const ei::Vec3& d);
+
+/**
+ * Exact orientation of the point d relative to the plane through a, b, c.
+ * @return 1 if d lies below the plane (a, b, c appear counterclockwise seen from above), -1 if above, 0 if the four
+ * points are coplanar.
+ */
+inline int orient3d(const ei::Vec3& a, const ei::Vec3& b, const ei::Vec3& c, const ei::Vec3& d)
+{
+    const double adx = static_cast<double>(a.x) - d.x, ady = static_cast<double>(a.y) - d.y, adz = static_cast<double>(a.z) - d.z;
+    const double bdx = static_cast<double>(b.x) - d.x, bdy = static_cast<double>(b.y) - d.y, bdz = static_cast<double>(b.z) - d.z;
+    const double cdx = static_cast<double>(c.x) - d.x, cdy = static_cast<double>(c.y) - d.y, cdz = static_cast<double>(c.z) - d.z;
+
+    const double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    const double cdxady = cdx * ady, adxcdy = adx * cdy;
+    const double adxbdy = adx * bdy, bdxady = bdx * ady;
+    const double determinant = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    const double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz) +
+                             (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz) +
+                             (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz);
+    const double bound = ORIENT3D_ERROR_BOUND * permanent;
+
+    if (std::fabs(determinant) > bound)
+        return (determinant > 0.0) - (determinant < 0.0);
+    if (bound == 0.0)
+        return 0;
+    return orient3d_exact(a, b, c, d);
+}
+
+#endif //PREDICATES_H
@@ -1,15 +1,36 @@
 ﻿#ifndef QUICKHULL_H
 #define QUICKHULL_H
-#include "VisualAlgorithm.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "ei/2dtypes.hpp"
+#include "app.h"
 
 //std::vector<ei::Vec2> computeHull(const std::vector<ei::Vec2>& points);
+// Thin wrapper around quick_hull_indices (the points are split into coordinate arrays once)
 std::vector<ei::Vec2> quick_hull_performance(const INPUT_PARAMETER& points);
-AlgorithmGenerator quick_hull_visualization(const INPUT_PARAMETER& points);
+/**
+ * QuickHull over caller-owned coordinate arrays, the hull is computed on point indices only: the coordinates are
+ * never modified and nothing is allocated. out needs room for one index per point, it is used as work space and
+ * on return starts with the indices of the hull points in the same order as quick_hull_inplace (starting at the
+ * lexicographically smallest point). A repeated hull point is reported with its smallest index.
+ * Throws std::invalid_argument if xs and ys differ in size, out is too small or there are more than 2^32 - 1 points.
+ * @return Number of hull indices at the front of out.
+ */
+std::size_t quick_hull_indices(std::span<const float> xs, std::span<const float> ys, std::span<std::uint32_t> out);
+// Same hull as quick_hull_performance, but the recursion partitions a single copy of the input in place
+// and the hull is assembled at the front of that copy (no allocations after the copy)
+std::vector<ei::Vec2> quick_hull_inplace(const INPUT_PARAMETER& points);
+// Task-parallel QuickHull (OpenMP), scans and partitions of large sub-problems run in parallel as well.
+// Returns the identical hull (same points, same order) as quick_hull_inplace
+std::vector<ei::Vec2> quick_hull_parallel(const INPUT_PARAMETER& points);
+// QuickHull over structure-of-arrays points, the farthest point search and the partitioning run as SIMD kernels
+// (SimdKernels.h). Same hull as quick_hull_inplace
+std::vector<ei::Vec2> quick_hull_simd(const INPUT_PARAMETER& points);
 
 
-void findHull(std::vector<ei::Vec2>& hull, const std::vector<ei::Vec2>& set,
-              const ei::Vec2& P, const ei::Vec2& Q);
-
+// Exact side of P relative to the line AB (orient2d): 1 left, 0 on the line, -1 right
 int pointLocation(const ei::Vec2& A, const ei::Vec2& B, const ei::Vec2& P);
 float distanceFromLine(const ei::Vec2& A, const ei::Vec2& B, const ei::Vec2& P);
 float distanceSquaredFromLine(const ei::Vec2& A, const ei::Vec2& B, const ei::Vec2& P);
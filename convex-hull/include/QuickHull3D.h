@@ -0,0 +1,24 @@
+﻿#ifndef QUICKHULL3D_H
+#define QUICKHULL3D_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "ei/3dtypes.hpp"
+
+/**
+ * 3D QuickHull (Barber, Dobkin, Huhdanpaa): starts with a tetrahedron of extreme points, every face keeps the list of
+ * the points above it (conflict list). The farthest point of a face is added next: the faces it sees are found by a
+ * search over the half-edge mesh, their boundary (horizon) is connected to the new point and their conflict points
+ * are redistributed to the new faces.
+ * Like the index-based 2D engines the points are never copied: faces, half-edges and conflict lists are flat index
+ * arrays (a conflict list is linked through one next index per point), deleted faces are reused. The initial
+ * partition and large redistributions run in parallel. Visibility is decided by the exact orient3d predicate.
+ *
+ * @return Indexed triangle list: 3 indices into points per hull face, counterclockwise seen from outside. Coplanar
+ * parts of the hull are split into several triangles. Empty if all points are coplanar (or there are less than 4).
+ * Throws std::invalid_argument for more than UINT32_MAX points.
+ */
+std::vector<std::uint32_t> quick_hull_3d(std::span<const ei::Vec3> points);
+
+#endif //QUICKHULL3D_H
@@ -0,0 +1,33 @@
+﻿#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include "ei/2dtypes.hpp"
+
+/**
+ * Maps a float to an unsigned integer with the same order: positive values get the sign bit set,
+ * negative values are inverted completely (so larger magnitudes become smaller keys).
+ */
+inline uint32_t floatToSortable(float value)
+{
+    const uint32_t bits = std::bit_cast<uint32_t>(value);
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+inline float sortableToFloat(uint32_t key)
+{
+    return std::bit_cast<float>((key & 0x80000000u) ? (key & 0x7FFFFFFFu) : ~key);
+}
+
+/**
+ * Sorts points lexicographically (x, then y) with a parallel LSD radix sort (OpenMP).
+ * Every point is encoded as one 64 bit key (x in the upper, y in the lower half), so only the keys are
+ * sorted and decoded afterwards. Each of the 8 byte-passes builds per-thread histograms of a contiguous
+ * block, the prefix sums over (digit, thread) give every thread its stable output offsets.
+ * Passes where all keys share the same digit are skipped.
+ */
+void radix_sort_points(std::vector<ei::Vec2>& points);
+
+#endif //RADIXSORT_H
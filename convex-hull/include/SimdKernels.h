@@ -0,0 +1,39 @@
+﻿#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "ei/2dtypes.hpp"
+
+/*
+ * Kernels over points in structure-of-arrays layout (PointsSoA.h, or any pair of x/y arrays).
+ * All of them classify a point P by the cross product (B - A) x (P - A): positive means P lies left of the line AB
+ * (counterclockwise), and for positive values it is proportional to the distance of P from the line.
+ * The side of the line is exact (orient2d, Predicates.h): the cross product is computed in float together with
+ * its error bound, and only lanes where the sign is not certain fall back to the exact predicate.
+ * The implementation (AVX-512, AVX2 or scalar) is chosen once at runtime from the features of the CPU,
+ * all of them return identical results.
+ */
+
+// Writes the exact orientation of every point relative to AB: 1 (left), -1 (right) or 0 (collinear)
+void orientation_kernel(const float* x, const float* y, std::size_t count,
+                        const ei::Vec2& A, const ei::Vec2& B, std::int8_t* orientations);
+
+// Index of the point farthest left of AB (cross product in double), count if no point lies strictly left of AB.
+// Ties are broken by coordinates (smallest x, then y), so the result is always a corner of the hull
+std::size_t farthest_point_kernel(const float* x, const float* y, std::size_t count,
+                                  const ei::Vec2& A, const ei::Vec2& B);
+
+/**
+ * Stable partition by side of AB: the points strictly left of AB are copied to (leftX, leftY), the remaining
+ * points are compacted in place at the front of (x, y).
+ * The output arrays must have room for count points and must not overlap the input.
+ * @return Number of points left of AB (the first count - result points of x/y are the rest).
+ */
+std::size_t partition_kernel(float* x, float* y, std::size_t count, const ei::Vec2& A, const ei::Vec2& B,
+                             float* leftX, float* leftY);
+
+// Instruction set of the dispatched kernels ("AVX-512", "AVX2" or "scalar")
+const char* simd_kernel_name();
+
+#endif //SIMDKERNELS_H
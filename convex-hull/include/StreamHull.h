@@ -0,0 +1,29 @@
+﻿#ifndef STREAMHULL_H
+#define STREAMHULL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ei/2dtypes.hpp"
+#include "app.h"
+
+constexpr std::size_t DEFAULT_STREAM_CHUNK_BYTES = std::size_t{64} << 20; ///< 64 MiB chunks for --stream
+
+struct StreamHullStats
+{
+    std::uint64_t points = 0;  ///< Points read from the file
+    std::uint64_t bytes = 0;   ///< Bytes read from the file
+    std::size_t chunks = 0;    ///< Chunks hulled
+};
+
+/**
+ * Out-of-core hull of a point file (text or binary, see PointFileReader): the file is read in chunks of chunkBytes,
+ * the hull of every chunk together with the hull of all previous chunks becomes the new running hull. Memory is
+ * bounded by O(chunk + h), the next chunk is read while the current one is hulled.
+ * The hull has the point order of the given algorithm. Throws like PointFileReader and computeHull.
+ */
+std::vector<ei::Vec2> stream_hull(Algorithm algorithm, const std::string& filename,
+                                  std::size_t chunkBytes = DEFAULT_STREAM_CHUNK_BYTES, StreamHullStats* stats = nullptr);
+
+#endif //STREAMHULL_H
@@ -4,21 +4,32 @@
 
 #ifndef APP_H
 #define APP_H
+#include <cstdint>
 #include <iomanip>
 #include <ios>
+#include <sstream>
 #include <string>
+#include <vector>
+#include "ei/2dtypes.hpp"
+#include "ei/3dtypes.hpp"
 
 constexpr int WINDOW_DEFAULT_WIDTH = 1280; ///< Default width of the window.
 constexpr int WINDOW_DEFAULT_HEIGHT = 1024; ///< Default height of the window.
 
-#define VISUALIZATION_POINTS_LIMIT 50
+#define VISUALIZATION_POINTS_LIMIT 1000000
+#define INPUT_PARAMETER     std::vector<ei::Vec2>
 
 enum Algorithm
 {
     QUICK_HULL = 0,
     JARVIS_MARCH = 1,
     DIVIDE_AND_CONQUER = 2,
-    INVALID_ALGORITHM = 3
+    QUICK_HULL_INPLACE = 3,
+    QUICK_HULL_PARALLEL = 4,
+    MONOTONE_CHAIN = 5,
+    CHANS_ALGORITHM = 6,
+    QUICK_HULL_SIMD = 7,
+    INVALID_ALGORITHM = 8
 };
 
 /**
@@ -35,8 +46,19 @@ inline std::string formatFloat(float value, int precision)
 }
 
 int console_main(Algorithm algorithm, std::vector<ei::Vec2>& loadedPoints);
+// Runs every algorithm on every generator (and on polygons with the given hull sizes) with the given number of points
+// (generated with the given seed) and prints a table of the timings
+int benchmark_main(int numPoints, bool cull, const std::vector<int>& hullSizes, std::uint64_t seed);
+// 3D mode (--3d): hulls the points with QuickHull 3D and prints the number of faces
+int console_3d_main(const std::vector<ei::Vec3>& loadedPoints);
+// Runs QuickHull 3D on the 3D counterpart of every generator and prints a table of the timings
+int benchmark_3d_main(int numPoints, std::uint64_t seed);
 // Using a pointer reference to allow for default nullptr value (i.e. no points loaded)
 int gui_main(Algorithm algorithm, std::vector<ei::Vec2>* loadedPoints = nullptr);
+// Runs the visualization of the algorithm without a window and saves every step to the trace file (--record)
+int record_trace_main(Algorithm algorithm, std::vector<ei::Vec2>& points, const std::string& traceFile);
+// Opens a recorded trace in the GUI, the steps are shown in any order without running the algorithm (--replay)
+int replay_trace_main(const std::string& traceFile);
 
 inline std::string algorithmToString(Algorithm algorithm)
 {
@@ -48,9 +70,30 @@ inline std::string algorithmToString(Algorithm algorithm)
         return "Jarvis March";
     case DIVIDE_AND_CONQUER:
         return "Divide & Conquer";
+    case QUICK_HULL_INPLACE:
+        return "QuickHull (in-place)";
+    case QUICK_HULL_PARALLEL:
+        return "QuickHull (parallel)";
+    case MONOTONE_CHAIN:
+        return "Monotone Chain";
+    case CHANS_ALGORITHM:
+        return "Chan's Algorithm";
+    case QUICK_HULL_SIMD:
+        return "QuickHull (SIMD)";
     default:
             return "Unknown";
     }
 }
 
+// List of all algorithm ids for help texts (i.e. "0: QuickHull, 1: Jarvis March, ...")
+inline std::string algorithmList()
+{
+    std::string list;
+    for (int algorithm = 0; algorithm < INVALID_ALGORITHM; ++algorithm)
+    {
+        list += (algorithm ? ", " : "") + std::to_string(algorithm) + ": " + algorithmToString(static_cast<Algorithm>(algorithm));
+    }
+    return list;
+}
+
 #endif //APP_H
@@ -0,0 +1,132 @@
+﻿#ifndef BATCHRENDERER_H
+#define BATCHRENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+#include "ei/2dtypes.hpp"
+
+constexpr std::size_t MAX_VISIBLE_LABELS = 256;         ///< Labels are only drawn if at most this many are in the view
+constexpr std::size_t MAX_HIGHLIGHT_SHAPES = 16384;     ///< More highlights are drawn as single pixels
+constexpr std::size_t POINT_BUDGET = 1 << 20;           ///< Points drawn at most, denser clouds are decimated
+constexpr unsigned LABEL_CHARACTER_SIZE = 12;
+constexpr std::size_t POINT_INDEX_BLOCK_SIZE = 1024;    ///< Positions per block of a PointIndex
+
+// Area of the world inside the view of the window
+sf::FloatRect viewBounds(const sf::RenderWindow& window);
+
+/**
+ * Vertices drawn with one draw call. If the graphics driver supports vertex buffers, the vertices are uploaded once
+ * after every change instead of on every frame.
+ */
+class VertexBatch
+{
+public:
+    explicit VertexBatch(sf::PrimitiveType type = sf::Points, sf::VertexBuffer::Usage usage = sf::VertexBuffer::Stream);
+
+    std::vector<sf::Vertex>& vertices() { return vertices_; }
+    std::size_t size() const { return vertices_.size(); }
+    void setPrimitiveType(sf::PrimitiveType type);
+    // Has to be called after changing the vertices
+    void upload();
+    void draw(sf::RenderWindow& window, const sf::RenderStates& states = sf::RenderStates::Default) const;
+
+private:
+    sf::PrimitiveType type_;
+    std::vector<sf::Vertex> vertices_;
+    sf::VertexBuffer buffer_;
+    bool uploaded_ = false;
+};
+
+/**
+ * Texts drawn with one draw call: every glyph is a textured quad on the glyph atlas (texture) of the font. The labels
+ * are placed in pixels (window coordinates), so they keep their size when zooming.
+ */
+class LabelBatch
+{
+public:
+    LabelBatch() = default;
+    explicit LabelBatch(const sf::Font& font) : font_(&font) {}
+
+    void setFont(const sf::Font& font) { font_ = &font; }
+    void clear() { batch_.vertices().clear(); }
+    // The top-left corner of the text is at the pixel, lines are separated by '\n'
+    void add(const std::string& text, sf::Vector2f pixel, const sf::Color& color = sf::Color::White);
+    void upload() { batch_.upload(); }
+    // Draws with the default view of the window (pixels)
+    void draw(sf::RenderWindow& window) const;
+
+private:
+    const sf::Font* font_ = nullptr;
+    VertexBatch batch_{sf::Triangles};
+};
+
+/**
+ * Positions sorted by x and cut into blocks of POINT_INDEX_BLOCK_SIZE, every block sorted by y. A view only visits the
+ * blocks overlapping its x range and, within each, the positions in its y range, so finding the labels of a view
+ * costs about as much as the positions in the view instead of a scan over all positions.
+ */
+class PointIndex
+{
+public:
+    // Positions with non-finite coordinates are skipped (they are never in a view)
+    void build(const std::vector<sf::Vector2f>& positions);
+    void clear();
+    bool empty() const { return entries_.empty(); }
+
+    /**
+     * Replaces visible by the indices (into the positions of build, ascending) of the positions inside bounds.
+     * @return false (and visible is incomplete) if there are more than limit of them.
+     */
+    bool query(const sf::FloatRect& bounds, std::size_t limit, std::vector<std::uint32_t>& visible) const;
+
+private:
+    struct Entry
+    {
+        sf::Vector2f position;
+        std::uint32_t index;
+    };
+
+    std::vector<Entry> entries_;
+    std::vector<float> blockMinX_;  ///< Smallest x of every block
+    std::vector<float> blockMaxX_;  ///< Largest x of every block
+};
+
+/**
+ * Point cloud with levels of detail: level 0 holds all points, level k one point per grid cell of 2^(k-1) units. The
+ * coarsest level with cells of at most one pixel looks the same as all points and is drawn, unless it has more than
+ * POINT_BUDGET points, then the first coarser level within the budget is drawn. At the default view a pixel is one
+ * unit, so a million points in the window are drawn as the (at most 1.3 million, usually far fewer) pixels they cover.
+ *
+ * The coordinates are shown next to the points in the view if there are at most MAX_VISIBLE_LABELS of them. The points
+ * in the view are found with a PointIndex, so panning and zooming do not scan the whole cloud.
+ */
+class PointCloud
+{
+public:
+    explicit PointCloud(const sf::Font& font) : labels_(font) {}
+
+    void setPoints(const std::vector<ei::Vec2>& points);
+    std::size_t size() const { return points_.size(); }
+    // Not const: the labels are rebuilt when the view changed
+    void draw(sf::RenderWindow& window);
+
+private:
+    struct Level
+    {
+        float cellSize;     ///< 0 for level 0 (all points)
+        VertexBatch points;
+    };
+
+    std::vector<ei::Vec2> points_;
+    std::vector<Level> levels_;
+    LabelBatch labels_;
+    PointIndex labelIndex_;
+    sf::FloatRect labelBounds_;    ///< View the labels were built for
+    bool labelsValid_ = false;
+};
+
+#endif //BATCHRENDERER_H
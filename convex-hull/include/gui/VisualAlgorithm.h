@@ -0,0 +1,435 @@
+﻿//
+// Created by RINI on 25/09/2024.
+//
+
+#ifndef VISUALALGORITHM_H
+#define VISUALALGORITHM_H
+
+#include <algorithm>
+#include <bit>
+#include <coroutine>
+#include <cstdint>
+#include <iostream>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+
+#include "ei/2dtypes.hpp"
+#include "SFML/Graphics.hpp"
+#include "app.h"
+#include "BatchRenderer.h"
+
+// Drawables of a Visual are plain data, the Visual draws all of a kind with one draw call (see BatchRenderer.h)
+struct IndicatorLine
+{
+    sf::Vector2f start;
+    sf::Vector2f end;
+    sf::Color color;
+};
+
+struct Highlight
+{
+    sf::Vector2f position;
+    std::string text;           ///< Shown below the highlight
+    sf::Color color;
+};
+
+// Kind of change a visualization step makes to the drawn state
+enum class VisualChangeType : std::uint8_t
+{
+    ADD_HIGHLIGHT = 0,
+    REMOVE_HIGHLIGHT = 1,       ///< Removes all highlights at the position
+    CLEAR_HIGHLIGHTS = 2,
+    ADD_INDICATOR_LINE = 3,
+    REMOVE_INDICATOR_LINE = 4,  ///< Removes all indicator lines between the positions
+    CLEAR_INDICATOR_LINES = 5,
+    ADD_HULL_POINT = 6,
+    INSERT_HULL_POINT = 7,      ///< Inserts the hull point before the hull point at index
+    CLEAR_HULL_POINTS = 8
+};
+
+struct VisualChange
+{
+    VisualChangeType type{};
+    sf::Vector2f first{};       ///< Position of the highlight or hull point, start of the indicator line
+    sf::Vector2f second{};      ///< End of the indicator line
+    sf::Color color{};
+    std::uint32_t index = 0;    ///< Hull index of INSERT_HULL_POINT
+    std::string label{};        ///< Text of the highlight
+};
+
+/**
+ * Changes of one visualization step. The visualizations record their steps into one delta (living in the coroutine
+ * frame) and co_yield it, the VisualAlgorithm applies the changes to its Visual and the changes are cleared before the
+ * coroutine is resumed. A step therefore costs as much as it changes, not as much as there is to draw.
+ */
+struct VisualDelta
+{
+    std::vector<VisualChange> changes;
+    std::string explanation;    ///< Explanation of the step (kept until it is set again)
+    bool finished = false;
+
+    void setExplanation(const std::string& text)
+    {
+        explanation = text;
+    }
+    void addHighlight(const sf::Vector2f& position, const std::string& text, const sf::Color& color)
+    {
+        changes.push_back({VisualChangeType::ADD_HIGHLIGHT, position, {}, color, 0, text});
+    }
+    void removeHighlight(const sf::Vector2f& position)
+    {
+        changes.push_back({VisualChangeType::REMOVE_HIGHLIGHT, position});
+    }
+    void clearHighlights()
+    {
+        changes.push_back({VisualChangeType::CLEAR_HIGHLIGHTS});
+    }
+    void addIndicatorLine(const sf::Vector2f& start, const sf::Vector2f& end, const sf::Color& color)
+    {
+        changes.push_back({VisualChangeType::ADD_INDICATOR_LINE, start, end, color});
+    }
+    void removeIndicatorLine(const sf::Vector2f& start, const sf::Vector2f& end)
+    {
+        changes.push_back({VisualChangeType::REMOVE_INDICATOR_LINE, start, end});
+    }
+    void clearIndicatorLines()
+    {
+        changes.push_back({VisualChangeType::CLEAR_INDICATOR_LINES});
+    }
+    void addHullPoint(const sf::Vector2f& position, const sf::Color& color = sf::Color::Red)
+    {
+        changes.push_back({VisualChangeType::ADD_HULL_POINT, position, {}, color});
+    }
+    void insertHullPoint(std::size_t index, const sf::Vector2f& position, const sf::Color& color = sf::Color::Red)
+    {
+        changes.push_back({VisualChangeType::INSERT_HULL_POINT, position, {}, color, static_cast<std::uint32_t>(index)});
+    }
+    void clearHullPoints()
+    {
+        changes.push_back({VisualChangeType::CLEAR_HULL_POINTS});
+    }
+    // True if the step adds a point to the hull (skip to next hull vertex)
+    bool addsHullPoint() const
+    {
+        return std::ranges::any_of(changes, [](const VisualChange& change) {
+            return change.type == VisualChangeType::ADD_HULL_POINT || change.type == VisualChangeType::INSERT_HULL_POINT;
+        });
+    }
+    void clearChanges()
+    {
+        changes.clear();
+    }
+};
+
+/**
+ * Vector of drawables that can be removed by key in O(1): the last element is moved into the freed slot and a hash map
+ * points from the key to the slots (several drawables may share a key).
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class KeyedVector
+{
+public:
+    void add(const Key& key, T value)
+    {
+        slots_.emplace(key, items_.size());
+        items_.push_back(std::move(value));
+        keys_.push_back(key);
+    }
+    void remove(const Key& key)
+    {
+        for (auto it = slots_.find(key); it != slots_.end(); it = slots_.find(key))
+        {
+            const std::size_t slot = it->second, last = items_.size() - 1;
+            slots_.erase(it);
+            if (slot != last)
+            {
+                items_[slot] = std::move(items_[last]);
+                keys_[slot] = keys_[last];
+                auto [first, end] = slots_.equal_range(keys_[slot]);
+                for (; first != end; ++first)
+                {
+                    if (first->second == last)
+                    {
+                        first->second = slot;
+                        break;
+                    }
+                }
+            }
+            items_.pop_back();
+            keys_.pop_back();
+        }
+    }
+    void clear()
+    {
+        items_.clear();
+        keys_.clear();
+        // clear() would keep (and walk) all buckets, a fresh map keeps clearing few drawables cheap after many
+        slots_ = std::unordered_multimap<Key, std::size_t, Hash>();
+    }
+    std::size_t size() const { return items_.size(); }
+    // Items keep their slot until the next add or remove
+    const T& operator[](std::size_t slot) const { return items_[slot]; }
+    auto begin() const { return items_.begin(); }
+    auto end() const { return items_.end(); }
+
+private:
+    std::vector<T> items_;
+    std::vector<Key> keys_;
+    std::unordered_multimap<Key, std::size_t, Hash> slots_;
+};
+
+// Exact key of a position (+0.f turns -0 into 0, so keys are equal whenever the positions compare equal)
+inline std::uint64_t positionKey(const sf::Vector2f& position)
+{
+    return static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(position.x + 0.f)) << 32
+         | std::bit_cast<std::uint32_t>(position.y + 0.f);
+}
+
+using LineKey = std::pair<std::uint64_t, std::uint64_t>;
+struct LineKeyHash
+{
+    std::size_t operator()(const LineKey& key) const
+    {
+        return std::hash<std::uint64_t>{}(key.first * 0x9E3779B97F4A7C15ull ^ key.second);
+    }
+};
+
+// Drawn state of a visualization, built up by applying the deltas of the steps
+struct Visual
+{
+    sf::Text explanation;
+    std::vector<sf::Vertex> current_hull;   ///< Drawn as line strip
+    KeyedVector<LineKey, IndicatorLine, LineKeyHash> indicator_lines;
+    KeyedVector<std::uint64_t, Highlight> highlights;
+    bool finished = false;
+    Visual()
+    {
+        explanation.setCharacterSize(12);
+        explanation.setFillColor(sf::Color::White);
+        explanation.setPosition(10, 10); // top-left
+    }
+    // The font has to outlive the visual
+    void setFont(const sf::Font& font)
+    {
+        explanation.setFont(font);
+        labels_.setFont(font);
+    }
+    void apply(const VisualDelta& delta)
+    {
+        apply(delta, delta.explanation);
+    }
+    // Applies the changes of the delta with the given explanation instead of its own (steps of a VisualTrace)
+    void apply(const VisualDelta& delta, const std::string& explanation_text)
+    {
+        if (explanation_text != explanation_text_)
+        {
+            explanation_text_ = explanation_text;
+            explanation.setString(explanation_text_);
+        }
+        for (const VisualChange& change : delta.changes)
+        {
+            switch (change.type)
+            {
+            case VisualChangeType::ADD_HIGHLIGHT:
+                highlights.add(positionKey(change.first), {change.first, change.label, change.color});
+                break;
+            case VisualChangeType::REMOVE_HIGHLIGHT:
+                highlights.remove(positionKey(change.first));
+                break;
+            case VisualChangeType::CLEAR_HIGHLIGHTS:
+                highlights.clear();
+                break;
+            case VisualChangeType::ADD_INDICATOR_LINE:
+                indicator_lines.add({positionKey(change.first), positionKey(change.second)},
+                                    {change.first, change.second, change.color});
+                break;
+            case VisualChangeType::REMOVE_INDICATOR_LINE:
+                indicator_lines.remove({positionKey(change.first), positionKey(change.second)});
+                break;
+            case VisualChangeType::CLEAR_INDICATOR_LINES:
+                indicator_lines.clear();
+                break;
+            case VisualChangeType::ADD_HULL_POINT:
+                current_hull.emplace_back(change.first, change.color);
+                break;
+            case VisualChangeType::INSERT_HULL_POINT:
+                current_hull.insert(current_hull.begin() + std::min<std::size_t>(change.index, current_hull.size()),
+                                    sf::Vertex(change.first, change.color));
+                break;
+            case VisualChangeType::CLEAR_HULL_POINTS:
+                current_hull.clear();
+                break;
+            }
+        }
+        finished = finished || delta.finished;
+        dirty_ = true;
+    }
+    // Delta that rebuilds this visual from an empty one (keyframes of a VisualTrace)
+    VisualDelta snapshot() const
+    {
+        VisualDelta delta;
+        delta.explanation = explanation_text_;
+        delta.finished = finished;
+        for (const auto& highlight : highlights)
+        {
+            delta.addHighlight(highlight.position, highlight.text, highlight.color);
+        }
+        for (const auto& line : indicator_lines)
+        {
+            delta.addIndicatorLine(line.start, line.end, line.color);
+        }
+        for (const auto& vertex : current_hull)
+        {
+            delta.addHullPoint(vertex.position, vertex.color);
+        }
+        return delta;
+    }
+    /**
+     * Draws the hull, all indicator lines and all highlights with one draw call each, the vertices are only rebuilt
+     * after a step. The texts of the highlights in the view are drawn with one more draw call, if there are at most
+     * MAX_VISIBLE_LABELS of them.
+     */
+    void draw(sf::RenderWindow& window) const;
+
+private:
+    void rebuildBatches() const;
+    // Highlights with a text inside bounds, false if there are more than MAX_VISIBLE_LABELS
+    bool visibleLabels(const sf::FloatRect& bounds, std::vector<const Highlight*>& visible) const;
+
+    std::string explanation_text_;
+    // Drawing caches
+    mutable VertexBatch hull_batch_{sf::LineStrip};
+    mutable VertexBatch line_batch_{sf::Lines};
+    mutable VertexBatch highlight_batch_{sf::Triangles};
+    mutable LabelBatch labels_;
+    mutable sf::FloatRect label_bounds_;
+    // Highlights with a text, found by position (built on the first view change after a step)
+    mutable PointIndex label_index_;
+    mutable std::vector<std::uint32_t> labeled_highlights_;  ///< Slot in highlights of every position in label_index_
+    mutable bool dirty_ = true;
+    mutable bool labels_dirty_ = true;
+    mutable bool label_index_valid_ = false;
+};
+
+/**
+ * Coroutine frames of the visualizations are allocated from a pool per thread instead of the global heap. A reset
+ * creates a new coroutine after the old one was destroyed, so the pool hands out the memory of the previous frame.
+ */
+inline std::pmr::unsynchronized_pool_resource& visualFrameArena()
+{
+    static thread_local std::pmr::unsynchronized_pool_resource arena;
+    return arena;
+}
+
+// Generator coroutine that yields the changes of every step
+struct AlgorithmGenerator {
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    struct promise_type {
+        VisualDelta* current_value = nullptr;
+        std::suspend_always yield_value(VisualDelta& value) {
+            current_value = &value; // The delta lives in the (suspended) coroutine frame
+            return {};
+        }
+        AlgorithmGenerator get_return_object() {
+            return AlgorithmGenerator{handle_type::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {
+            std::exit(1);
+        }
+        static void* operator new(std::size_t size) {
+            return visualFrameArena().allocate(size);
+        }
+        static void operator delete(void* frame, std::size_t size) {
+            visualFrameArena().deallocate(frame, size);
+        }
+    };
+
+    handle_type coro = nullptr;
+
+    AlgorithmGenerator() = default;
+
+    AlgorithmGenerator(handle_type h) : coro(h) {}
+    AlgorithmGenerator(const AlgorithmGenerator&) = delete; // Disable copying
+    AlgorithmGenerator& operator=(const AlgorithmGenerator&) = delete; // Disable copy assignment
+
+    // Move constructor
+    AlgorithmGenerator(AlgorithmGenerator&& other) noexcept : coro(other.coro) {
+        other.coro = nullptr;
+    }
+    // Move assignment operator
+    AlgorithmGenerator& operator=(AlgorithmGenerator&& other) noexcept {
+        if (this != &other) {
+            if (coro) {
+                coro.destroy();
+            }
+            coro = other.coro;
+            other.coro = nullptr;
+        }
+        return *this;
+    }
+
+    ~AlgorithmGenerator() {
+        if (coro) {
+            coro.destroy();
+        }
+    }
+
+    bool done() const { return coro.done(); }
+
+    // Resumes the coroutine until its next step. The returned delta is valid until the next call, nullptr when done.
+    VisualDelta* next() {
+        if (!coro) {
+            throw std::runtime_error("Attempt to use an invalid coroutine");
+        }
+        VisualDelta*& current = coro.promise().current_value;
+        if (current) {
+            current->clearChanges();
+        }
+        coro.resume();
+        return coro.done() ? nullptr : current;
+    }
+};
+
+class VisualAlgorithm {
+public:
+    VisualAlgorithm() = default;
+    VisualAlgorithm(const std::function<AlgorithmGenerator(INPUT_PARAMETER&)>& generator_func);
+
+    void setFont(const sf::Font& font);
+    void setInput(const INPUT_PARAMETER& input_data);
+    void draw(sf::RenderWindow& window) const;
+    // Single step (Space), prints the explanation
+    void visualStep();
+    // Advances by one step and applies it, returns the step (nullptr when the algorithm is finished)
+    const VisualDelta* step();
+    // Fast-forward (N): steps until a point is added to the hull or the algorithm is finished
+    void skipToHullVertex();
+    // Runs the remaining steps without drawing them (Enter), the main loop draws the result
+    void runAlgorithm();
+    void reset();
+
+    bool IsStarted() const { return started_; }
+
+private:
+    std::function<AlgorithmGenerator(INPUT_PARAMETER&)> algorithm_ = nullptr; // Stores the algorithm generator function
+    AlgorithmGenerator generator_{nullptr}; // Stores the generator coroutine
+    INPUT_PARAMETER input_data_;
+    bool started_ = false;
+    Visual visualization_;
+
+    sf::Font font_;
+};
+
+
+
+#endif //VISUALALGORITHM_H
@@ -0,0 +1,68 @@
+﻿#ifndef VISUALTRACE_H
+#define VISUALTRACE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "app.h"
+#include "VisualAlgorithm.h"
+
+constexpr char TRACE_FILE_MAGIC[4] = {'C', 'H', 'T', 'R'};   ///< First bytes of a trace file
+constexpr std::uint32_t TRACE_FILE_VERSION = 2;
+
+/**
+ * Recorded run of a visualization: the input points and the delta of every step. A trace is recorded without a window
+ * (the algorithm runs to completion once, every step is written to the file as it is yielded) and replayed in the GUI,
+ * where any step can be shown without running the algorithm again.
+ *
+ * Trace file (little endian, counts and indices as LEB128 varints):
+ *   magic "CHTR", uint32 version, uint8 algorithm, uint64 step count (written when the recording ends),
+ *   point count, points as float x, y,
+ *   steps as explanation text index, uint8 finished, change count and the changes. A change is its uint8 type followed
+ *   by only the fields the type uses (index, positions as float x, y, color as RGBA bytes, text index),
+ *   text count, texts as length and bytes (explanations and highlight texts, each stored once in order of first use).
+ */
+class VisualTrace
+{
+public:
+    /**
+     * Runs the visualization to completion and writes every step to the trace file, only the texts seen so far are
+     * kept in memory. Throws std::runtime_error if the file can not be written.
+     * @return Number of recorded steps.
+     */
+    static std::size_t record(Algorithm algorithm, const std::function<AlgorithmGenerator(INPUT_PARAMETER&)>& visualization,
+                              const INPUT_PARAMETER& points, const std::string& filename);
+    // Loads a trace file and builds the keyframes for seeking, throws std::runtime_error if it is no valid trace file
+    static VisualTrace load(const std::string& filename);
+
+    Algorithm algorithm() const { return algorithm_; }
+    const std::vector<ei::Vec2>& points() const { return points_; }
+    std::size_t size() const { return steps_.size(); }
+    // Changes of the step, its explanation is kept as text index (see explanation and apply)
+    const VisualDelta& step(std::size_t index) const { return steps_[index]; }
+    const std::string& explanation(std::size_t index) const { return texts_[explanations_[index]]; }
+    // Applies the step (with its explanation) to the visual
+    void apply(std::size_t index, Visual& visual) const { visual.apply(steps_[index], explanation(index)); }
+
+    /**
+     * Builds the (empty) visual as it is after the step: the closest keyframe before the step is applied, followed by
+     * the steps after it. Keyframes are taken whenever the steps since the last one changed more than the visual holds,
+     * so seeking costs about as much as drawing the visual once, independent of the step.
+     */
+    void seek(std::size_t index, Visual& visual) const;
+
+private:
+    void buildKeyframes();
+
+    Algorithm algorithm_ = INVALID_ALGORITHM;
+    std::vector<ei::Vec2> points_;
+    std::vector<VisualDelta> steps_;            ///< Without explanation, see explanations_
+    std::vector<std::uint32_t> explanations_;   ///< Text index of the explanation of every step
+    std::vector<std::string> texts_;
+    std::vector<std::size_t> keyframeSteps_;    ///< Ascending, keyframes_[i] is the visual after step keyframeSteps_[i]
+    std::vector<VisualDelta> keyframes_;
+};
+
+#endif //VISUALTRACE_H
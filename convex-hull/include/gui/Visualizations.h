@@ -0,0 +1,29 @@
+﻿#ifndef VISUALIZATIONS_H
+#define VISUALIZATIONS_H
+#include "VisualAlgorithm.h"
+
+// Step by step versions of the hull algorithms for the GUI (convex_hull_gui), every co_yield shows one step
+AlgorithmGenerator quick_hull_visualization(const INPUT_PARAMETER& points);
+AlgorithmGenerator jarvis_march_visualization(INPUT_PARAMETER& points);
+AlgorithmGenerator divide_and_conquer_visualization(const INPUT_PARAMETER& points);
+
+// Visualization of the algorithm (the QuickHull variants share the same steps), nullptr if there is none
+inline std::function<AlgorithmGenerator(INPUT_PARAMETER&)> visualization_for(Algorithm algorithm)
+{
+    switch (algorithm)
+    {
+    case QUICK_HULL:
+    case QUICK_HULL_INPLACE: // Same steps, only the memory layout / parallelization differs
+    case QUICK_HULL_PARALLEL:
+    case QUICK_HULL_SIMD:
+        return quick_hull_visualization;
+    case JARVIS_MARCH:
+        return jarvis_march_visualization;
+    case DIVIDE_AND_CONQUER:
+        return divide_and_conquer_visualization;
+    default:
+        return nullptr;
+    }
+}
+
+#endif //VISUALIZATIONS_H
@@ -0,0 +1,132 @@
+﻿#include "AklToussaint.h"
+#include "Predicates.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+constexpr size_t CULL_BLOCK_SIZE = 4096;
+constexpr size_t EXTREMES = 8;
+
+// Directions of the extremes in counterclockwise order around the hull (i.e. min x is the leftmost point)
+enum Extreme { MIN_X, MIN_SUM, MIN_Y, MAX_DIFFERENCE, MAX_X, MAX_SUM, MAX_Y, MIN_DIFFERENCE };
+
+// Projection of the point onto the direction of the extreme, so every extreme is a maximum
+static inline float projection(Extreme extreme, float x, float y) {
+    switch (extreme) {
+        case MIN_X: return -x;
+        case MIN_SUM: return -(x + y);
+        case MIN_Y: return -y;
+        case MAX_DIFFERENCE: return x - y;
+        case MAX_X: return x;
+        case MAX_SUM: return x + y;
+        case MAX_Y: return y;
+        default: return y - x; // MIN_DIFFERENCE
+    }
+}
+
+// Finds the extreme points with SIMD reductions per block, only the best block is searched for the point itself
+static std::array<ei::Vec2, EXTREMES> findExtremes(const std::vector<ei::Vec2>& points) {
+    std::array<float, EXTREMES> best;
+    std::array<size_t, EXTREMES> bestBlock{};
+    best.fill(-std::numeric_limits<float>::infinity());
+
+    for (size_t block = 0; block < points.size(); block += CULL_BLOCK_SIZE) {
+        const ei::Vec2* data = points.data() + block;
+        const size_t count = std::min(CULL_BLOCK_SIZE, points.size() - block);
+        float minX = data[0].x, maxX = data[0].x, minY = data[0].y, maxY = data[0].y;
+        float minSum = data[0].x + data[0].y, maxSum = minSum;
+        float minDifference = data[0].x - data[0].y, maxDifference = minDifference;
+        #pragma omp simd reduction(min:minX, minY, minSum, minDifference) reduction(max:maxX, maxY, maxSum, maxDifference)
+        for (size_t i = 0; i < count; ++i) {
+            const float x = data[i].x, y = data[i].y;
+            minX = std::min(minX, x); maxX = std::max(maxX, x);
+            minY = std::min(minY, y); maxY = std::max(maxY, y);
+            minSum = std::min(minSum, x + y); maxSum = std::max(maxSum, x + y);
+            minDifference = std::min(minDifference, x - y); maxDifference = std::max(maxDifference, x - y);
+        }
+
+        const std::array<float, EXTREMES> blockBest = {-minX, -minSum, -minY, maxDifference,
+                                                       maxX, maxSum, maxY, -minDifference};
+        for (size_t extreme = 0; extreme < EXTREMES; ++extreme) {
+            if (blockBest[extreme] > best[extreme]) {
+                best[extreme] = blockBest[extreme];
+                bestBlock[extreme] = block;
+            }
+        }
+    }
+
+    std::array<ei::Vec2, EXTREMES> extremes;
+    for (size_t extreme = 0; extreme < EXTREMES; ++extreme) {
+        const size_t end = std::min(bestBlock[extreme] + CULL_BLOCK_SIZE, points.size());
+        for (size_t i = bestBlock[extreme]; i < end; ++i) {
+            if (projection(static_cast<Extreme>(extreme), points[i].x, points[i].y) == best[extreme]) {
+                extremes[extreme] = points[i];
+                break;
+            }
+        }
+    }
+    return extremes;
+}
+
+std::vector<ei::Vec2> akl_toussaint_cull(const std::vector<ei::Vec2>& points)
+{
+    if (points.size() < 4)
+    {
+        return points;
+    }
+
+    // Octagon without repeated vertices (one point may be extreme in several directions)
+    const std::array<ei::Vec2, EXTREMES> extremes = findExtremes(points);
+    std::array<ei::Vec2, EXTREMES> polygon;
+    size_t vertices = 0;
+    for (const auto& point : extremes) {
+        if (vertices == 0 || (point != polygon[vertices - 1] && point != polygon[0]))
+            polygon[vertices++] = point;
+    }
+    if (vertices < 3)
+    {
+        return points;
+    }
+
+    // Edge i: points strictly left of polygon[i] -> polygon[i + 1] are on the inner side
+    std::array<float, EXTREMES> edgeX{}, edgeY{}, startX{}, startY{};
+    for (size_t i = 0; i < EXTREMES; ++i) {
+        // Unused edges are repeated from the first one, so the SIMD loop always tests 8 edges
+        const size_t edge = i < vertices ? i : 0;
+        const ei::Vec2& start = polygon[edge];
+        const ei::Vec2& end = polygon[(edge + 1) % vertices];
+        edgeX[i] = end.x - start.x;
+        edgeY[i] = end.y - start.y;
+        startX[i] = start.x;
+        startY[i] = start.y;
+    }
+
+    std::vector<ei::Vec2> remaining;
+    remaining.reserve(points.size() / 8);
+    std::array<unsigned char, CULL_BLOCK_SIZE> inside;
+    for (size_t block = 0; block < points.size(); block += CULL_BLOCK_SIZE) {
+        const ei::Vec2* data = points.data() + block;
+        const size_t count = std::min(CULL_BLOCK_SIZE, points.size() - block);
+
+        #pragma omp simd
+        for (size_t i = 0; i < count; ++i) {
+            unsigned char strictlyInside = 1;
+            for (size_t edge = 0; edge < EXTREMES; ++edge) {
+                // Same cross product as pointLocation (QuickHull). Only points that are inside with certainty
+                // (beyond the rounding error bound of orient2d) are dropped, the rest is left to the hull algorithm
+                const float left = edgeX[edge]*(data[i].y - startY[edge]);
+                const float right = edgeY[edge]*(data[i].x - startX[edge]);
+                strictlyInside &= left - right > ORIENT2D_FLOAT_ERROR_BOUND * (std::fabs(left) + std::fabs(right));
+            }
+            inside[i] = strictlyInside;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            if (!inside[i])
+                remaining.push_back(data[i]);
+        }
+    }
+    return remaining;
+}
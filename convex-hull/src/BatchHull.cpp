@@ -0,0 +1,237 @@
+﻿#include "BatchHull.h"
+#include "Predicates.h"
+#include "QuickHull.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+constexpr std::size_t SMALL_SET_LIMIT = 256;  ///< Larger sets are computed by quick_hull_indices
+constexpr int SIZE_CLASSES = 33;              ///< Sets are grouped by std::bit_width of their size
+constexpr std::size_t EXTREMES = 8;           ///< Directions of the Akl-Toussaint octagon of small sets
+
+namespace {
+
+// Point of a small set together with its index in the flat arrays
+struct IndexedPoint
+{
+    float x;
+    float y;
+    std::uint32_t index;
+
+    ei::Vec2 point() const { return {x, y}; }
+};
+
+inline bool indexedLess(const IndexedPoint& a, const IndexedPoint& b)
+{
+    return a.x < b.x || (a.x == b.x && (a.y < b.y || (a.y == b.y && a.index < b.index)));
+}
+
+// Per-thread scratch: inside flags and sorted points of a small set, the hull stack (lower and upper chain)
+struct ScratchArena
+{
+    unsigned char inside[SMALL_SET_LIMIT];
+    IndexedPoint sorted[SMALL_SET_LIMIT];
+    IndexedPoint hull[2 * SMALL_SET_LIMIT];
+};
+
+}
+
+// Projection onto the direction of extreme point i (counterclockwise from min x), every extreme is a maximum
+static inline float projection(std::size_t extreme, float x, float y)
+{
+    const float projections[EXTREMES] = {-x, -(x + y), -y, x - y, x, x + y, y, y - x};
+    return projections[extreme];
+}
+
+/**
+ * Monotone chain for at most SMALL_SET_LIMIT points, only on the arena (no allocation, no recursion).
+ * Before the sort, all points strictly inside the octagon of the extreme points are dropped (Akl-Toussaint, see
+ * AklToussaint.h). The inside test is the error-bounded float filter of orient2d without its exact fallback (uncertain
+ * points are kept), so it runs as a branch-free SIMD loop. The compaction of the remaining points and the removal of
+ * repeated points after the sort (the smallest index is kept) are branch-free as well.
+ * @return Number of hull indices written to out.
+ */
+static std::size_t smallSetHull(const float* xs, const float* ys, std::uint32_t first, std::uint32_t size,
+                                ScratchArena& arena, std::uint32_t* out)
+{
+    if (size == 0)
+        return 0;
+
+    const float* x = xs + first;
+    const float* y = ys + first;
+
+    // Extreme points in counterclockwise order: min x, min x + y, min y, max x - y, max x, max x + y, max y, max y - x
+    // (one pass, the best index per direction is tracked without branches)
+    float best[EXTREMES];
+    std::uint32_t corners[EXTREMES] = {};
+    for (std::size_t extreme = 0; extreme < EXTREMES; ++extreme)
+        best[extreme] = projection(extreme, x[0], y[0]);
+    for (std::uint32_t i = 1; i < size; ++i)
+    {
+        for (std::size_t extreme = 0; extreme < EXTREMES; ++extreme)
+        {
+            const float value = projection(extreme, x[i], y[i]);
+            const bool better = value > best[extreme];
+            best[extreme] = better ? value : best[extreme];
+            corners[extreme] = better ? i : corners[extreme];
+        }
+    }
+
+    // Octagon without repeated vertices (one point may be extreme in several directions), unused edges repeat the
+    // first one. NOTE: Rounded projections may make the octagon non-convex, but a point strictly left of every edge
+    // of a closed polygon over input points is still strictly inside their hull, so the test stays safe
+    std::uint32_t polygon[EXTREMES];
+    std::size_t vertices = 0;
+    for (std::uint32_t corner : corners)
+    {
+        const auto same = [&](std::uint32_t other) { return x[corner] == x[other] && y[corner] == y[other]; };
+        if (vertices == 0 || (!same(polygon[vertices - 1]) && !same(polygon[0])))
+            polygon[vertices++] = corner;
+    }
+    float startX[EXTREMES], startY[EXTREMES], endX[EXTREMES], endY[EXTREMES];
+    for (std::size_t i = 0; i < EXTREMES; ++i)
+    {
+        const std::size_t edge = i < vertices ? i : 0;
+        startX[i] = x[polygon[edge]];
+        startY[i] = y[polygon[edge]];
+        endX[i] = x[polygon[(edge + 1) % vertices]];
+        endY[i] = y[polygon[(edge + 1) % vertices]];
+    }
+
+    #pragma omp simd
+    for (std::uint32_t i = 0; i < size; ++i)
+    {
+        unsigned char inside = 1;
+        for (std::size_t edge = 0; edge < EXTREMES; ++edge)
+        {
+            // orient2d(start, end, p) in float, only beyond its error bound p is certainly left of the edge
+            const float left = (startX[edge] - x[i]) * (endY[edge] - y[i]);
+            const float right = (startY[edge] - y[i]) * (endX[edge] - x[i]);
+            inside &= left - right > ORIENT2D_FLOAT_ERROR_BOUND * (std::fabs(left) + std::fabs(right));
+        }
+        arena.inside[i] = inside;
+    }
+
+    IndexedPoint* sorted = arena.sorted;
+    std::uint32_t remaining = 0;
+    for (std::uint32_t i = 0; i < size; ++i)
+    {
+        sorted[remaining] = {x[i], y[i], first + i};
+        remaining += !arena.inside[i];
+    }
+    std::sort(sorted, sorted + remaining, indexedLess);
+
+    std::uint32_t unique = 1;
+    for (std::uint32_t i = 1; i < remaining; ++i)
+    {
+        sorted[unique] = sorted[i];
+        unique += sorted[i].x != sorted[unique - 1].x || sorted[i].y != sorted[unique - 1].y;
+    }
+    if (unique < 3)
+    {
+        for (std::uint32_t i = 0; i < unique; ++i)
+            out[i] = sorted[i].index;
+        return unique;
+    }
+
+    // Lower hull from left to right, then upper hull from right to left (see monotone_chain_performance)
+    IndexedPoint* hull = arena.hull;
+    std::size_t count = 0;
+    for (std::uint32_t i = 0; i < unique; ++i)
+    {
+        while (count >= 2 && orient2d(hull[count - 2].point(), hull[count - 1].point(), sorted[i].point()) <= 0)
+            --count;
+        hull[count++] = sorted[i];
+    }
+    const std::size_t lowerSize = count + 1;
+    for (std::uint32_t i = unique - 1; i-- > 0;)
+    {
+        while (count >= lowerSize && orient2d(hull[count - 2].point(), hull[count - 1].point(), sorted[i].point()) <= 0)
+            --count;
+        hull[count++] = sorted[i];
+    }
+
+    --count; // Leftmost point was added twice
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = hull[i].index;
+    return count;
+}
+
+// Larger sets: index-based QuickHull with the output range as its scratch, turned into counterclockwise order
+static std::size_t largeSetHull(const float* xs, const float* ys, std::uint32_t first, std::uint32_t size,
+                                std::uint32_t* out)
+{
+    const std::size_t count = quick_hull_indices({xs + first, size}, {ys + first, size}, {out, size});
+    std::reverse(out + std::min<std::size_t>(count, 1), out + count);
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] += first;
+    return count;
+}
+
+std::size_t batch_hull_indices(std::span<const std::uint32_t> offsets, std::span<const float> xs,
+                               std::span<const float> ys, std::span<std::uint32_t> hullOffsets,
+                               std::span<std::uint32_t> hullIndices)
+{
+    if (offsets.empty())
+        throw std::invalid_argument("The offsets need at least one entry.");
+    if (xs.size() != ys.size())
+        throw std::invalid_argument("The x and y coordinate arrays differ in size.");
+    if (offsets.back() > xs.size())
+        throw std::invalid_argument("The offsets exceed the coordinate arrays.");
+    if (!std::is_sorted(offsets.begin(), offsets.end()))
+        throw std::invalid_argument("The offsets must be ascending.");
+    if (hullOffsets.size() < offsets.size())
+        throw std::invalid_argument("The hull offsets need one entry per offset.");
+    if (hullIndices.size() < offsets.back() - offsets.front())
+        throw std::invalid_argument("The hull index array must have room for one index per point.");
+
+    const std::size_t sets = offsets.size() - 1;
+
+    // Sets ordered by size class (largest first, counting sort), so the small sets of one class are processed
+    // together by the same kernel and the expensive sets do not end up last in the dynamic schedule
+    std::vector<std::size_t> classStart(SIZE_CLASSES + 1, 0);
+    for (std::size_t set = 0; set < sets; ++set)
+        ++classStart[SIZE_CLASSES - std::bit_width(offsets[set + 1] - offsets[set])];
+    std::exclusive_scan(classStart.begin(), classStart.end(), classStart.begin(), std::size_t{0});
+    std::vector<std::uint32_t> order(sets);
+    for (std::size_t set = 0; set < sets; ++set)
+        order[classStart[SIZE_CLASSES - std::bit_width(offsets[set + 1] - offsets[set])]++] =
+            static_cast<std::uint32_t>(set);
+
+    // Every hull is first written to the start of its own input range (it cannot be larger), then compacted
+    const std::uint32_t base = offsets.front();
+    std::vector<std::uint32_t> counts(sets);
+    const std::ptrdiff_t orderCount = static_cast<std::ptrdiff_t>(sets);
+    #pragma omp parallel default(none) shared(offsets, xs, ys, hullIndices, order, counts, orderCount, base)
+    {
+        ScratchArena arena;
+        #pragma omp for schedule(dynamic, 64)
+        for (std::ptrdiff_t i = 0; i < orderCount; ++i)
+        {
+            const std::uint32_t set = order[i];
+            const std::uint32_t first = offsets[set];
+            const std::uint32_t size = offsets[set + 1] - first;
+            std::uint32_t* out = hullIndices.data() + (first - base);
+            counts[set] = static_cast<std::uint32_t>(size <= SMALL_SET_LIMIT
+                                                         ? smallSetHull(xs.data(), ys.data(), first, size, arena, out)
+                                                         : largeSetHull(xs.data(), ys.data(), first, size, out));
+        }
+    }
+
+    // The hulls only move to the front, so the compaction in set order never overwrites a hull it still has to move
+    std::size_t total = 0;
+    for (std::size_t set = 0; set < sets; ++set)
+    {
+        hullOffsets[set] = static_cast<std::uint32_t>(total);
+        const std::uint32_t* hull = hullIndices.data() + (offsets[set] - base);
+        if (hull != hullIndices.data() + total)
+            std::copy(hull, hull + counts[set], hullIndices.data() + total);
+        total += counts[set];
+    }
+    hullOffsets[sets] = static_cast<std::uint32_t>(total);
+    return total;
+}
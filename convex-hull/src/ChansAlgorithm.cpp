@@ -0,0 +1,226 @@
+﻿#include "ChansAlgorithm.h"
+#include "Predicates.h"
+
+#include <algorithm>
+
+constexpr size_t LINEAR_TANGENT_LIMIT = 8;     ///< Group hulls with up to this many points are searched linearly
+constexpr size_t PARALLEL_MIN_GROUPS = 1024;   ///< Fewer group hulls are wrapped by one thread (a step costs a barrier)
+
+static inline bool lexicographicLess(const ei::Vec2& a, const ei::Vec2& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+static inline float distanceSquared(const ei::Vec2& A, const ei::Vec2& B) {
+    return (B.x - A.x)*(B.x - A.x) + (B.y - A.y)*(B.y - A.y);
+}
+
+// True if Q is the better next hull point from P than the current candidate: more clockwise, or collinear and farther.
+// bound is the orientation bound of the points
+static inline bool isBetterCandidate(const ei::Vec2& P, const ei::Vec2& candidate, const ei::Vec2& Q, float bound) {
+    const int orientation = orient2d(P, candidate, Q, bound);
+    return orientation < 0 || (orientation == 0 && distanceSquared(P, Q) > distanceSquared(P, candidate));
+}
+
+/**
+ * Monotone chain hull of the points in [first, last) (sorted in place), written to hull in counterclockwise order.
+ * hull needs space for one point more than the group, bound is the orientation bound of all points.
+ * @return Number of hull points.
+ */
+static size_t groupHull(ei::Vec2* first, ei::Vec2* last, ei::Vec2* hull, float bound) {
+    std::sort(first, last, lexicographicLess);
+    last = std::unique(first, last);
+    const size_t size = last - first;
+    if (size < 3) {
+        std::copy(first, last, hull);
+        return size;
+    }
+
+    size_t count = 0;
+    for (ei::Vec2* point = first; point != last; ++point) {
+        while (count >= 2 && orient2d(hull[count - 2], hull[count - 1], *point, bound) <= 0)
+            --count;
+        hull[count++] = *point;
+    }
+    const size_t lowerCount = count + 1;
+    for (ei::Vec2* point = last - 2; point >= first; --point) {
+        while (count >= lowerCount && orient2d(hull[count - 2], hull[count - 1], *point, bound) <= 0)
+            --count;
+        hull[count++] = *point;
+    }
+    return count - 1; // Leftmost point was added twice
+}
+
+// Index of the best candidate (all points left of or on P -> hull[index]) by checking every point
+static size_t linearTangent(const ei::Vec2& P, const ei::Vec2* hull, size_t count, float bound) {
+    size_t best = count;
+    for (size_t i = 0; i < count; ++i) {
+        if (hull[i] == P)
+            continue;
+        if (best == count || isBetterCandidate(P, hull[best], hull[i], bound))
+            best = i;
+    }
+    return best; // == count if P is the only point
+}
+
+/**
+ * Index of the tangent point of the counterclockwise convex polygon hull from P, such that the whole polygon is
+ * left of (or on) the line from P to it. Binary search over the polygon (Dan Sunday's tangent search for exterior
+ * points). The search compares plain float determinants, only the result is verified against its neighbors with
+ * orient2d (bound is the orientation bound of all points): P lying on the polygon or a search misled by rounding
+ * (nearly collinear vertices) fall back to the linear search.
+ */
+static size_t binaryTangent(const ei::Vec2& P, const ei::Vec2* hull, size_t count, float bound) {
+    if (count <= LINEAR_TANGENT_LIMIT)
+        return linearTangent(P, hull, count, bound);
+
+    // NOTE: above(A, B): A is above B seen from P (B is left of P -> A), the tangent point is the maximum
+    auto vertex = [&](size_t i) -> const ei::Vec2& { return hull[i % count]; };
+    auto above = [&](const ei::Vec2& A, const ei::Vec2& B) { return orient2dFloat(P, A, B) > 0.0f; };
+    auto below = [&](const ei::Vec2& A, const ei::Vec2& B) { return orient2dFloat(P, A, B) < 0.0f; };
+
+    size_t tangent;
+    if (below(vertex(1), vertex(0)) && !above(vertex(count - 1), vertex(0))) {
+        tangent = 0;
+    } else {
+        size_t a = 0, b = count;
+        while (true) {
+            if (b - a == 1) {
+                tangent = above(vertex(a), vertex(b)) ? a : b % count;
+                break;
+            }
+            const size_t c = (a + b) / 2;
+            const bool downC = below(vertex(c + 1), vertex(c));
+            if (downC && !above(vertex(c - 1), vertex(c))) {
+                tangent = c;
+                break;
+            }
+            // Continue with the sub-chain [a, c] or [c, b] that contains the maximum
+            const bool upA = above(vertex(a + 1), vertex(a));
+            if (upA) {
+                if (downC || above(vertex(a), vertex(c)))
+                    b = c;
+                else
+                    a = c;
+            } else {
+                if (downC && below(vertex(a), vertex(c)))
+                    b = c;
+                else
+                    a = c;
+            }
+        }
+    }
+
+    // Tangent point: neither neighbor is right of P -> hull[tangent]
+    const ei::Vec2& point = vertex(tangent);
+    if (point == P || orient2d(P, point, vertex(tangent + 1), bound) < 0
+        || orient2d(P, point, vertex(tangent + count - 1), bound) < 0)
+        return linearTangent(P, hull, count, bound);
+    // Collinear next point is farther away
+    if (orient2d(P, point, vertex(tangent + 1), bound) == 0 && distanceSquared(P, vertex(tangent + 1)) > distanceSquared(P, point))
+        return (tangent + 1) % count;
+    return tangent;
+}
+
+std::vector<ei::Vec2> chans_algorithm_performance(const INPUT_PARAMETER& points)
+{
+    if (points.size() < 3)
+    {
+        return points;
+    }
+
+    const size_t size = points.size();
+    // Leftmost point and the orientation bound (orient2dStaticBound) of the bounding box in one pass
+    ei::Vec2 start = points[0], min = points[0], max = points[0];
+    for (const ei::Vec2& point : points) {
+        if (lexicographicLess(point, start))
+            start = point;
+        min = ei::Vec2(std::min(min.x, point.x), std::min(min.y, point.y));
+        max = ei::Vec2(std::max(max.x, point.x), std::max(max.y, point.y));
+    }
+    const float bound = orient2dStaticBound(static_cast<double>(max.x) - min.x, static_cast<double>(max.y) - min.y);
+    std::vector<ei::Vec2> groups(size);
+    std::vector<ei::Vec2> hulls;
+
+    // m = 4, 16, 256, 65536, ... (squared after every failed attempt)
+    for (size_t groupSize = 4;; groupSize = std::min(groupSize * groupSize, size)) {
+        groupSize = std::min(groupSize, size);
+        const size_t groupCount = (size + groupSize - 1) / groupSize;
+        const size_t stride = groupSize + 1;
+        std::copy(points.begin(), points.end(), groups.begin());
+        hulls.resize(groupCount * stride);
+        std::vector<size_t> hullCounts(groupCount);
+
+        #pragma omp parallel for schedule(dynamic, 64) default(none) shared(groups, hulls, hullCounts, groupCount, groupSize, stride, size, bound)
+        for (size_t group = 0; group < groupCount; ++group) {
+            ei::Vec2* first = groups.data() + group * groupSize;
+            ei::Vec2* last = groups.data() + std::min(size, (group + 1) * groupSize);
+            hullCounts[group] = groupHull(first, last, hulls.data() + group * stride, bound);
+        }
+
+        if (groupCount == 1) {
+            // Group hull is the convex hull (it starts at the leftmost point as well)
+            return std::vector<ei::Vec2>(hulls.begin(), hulls.begin() + hullCounts[0]);
+        }
+
+        // Gift wrapping over the group hulls for at most m steps. The start point is the first point of its group hull.
+        size_t currentGroup = 0;
+        while (hulls[currentGroup * stride] != start)
+            ++currentGroup;
+        size_t currentIndex = 0;
+        std::vector<ei::Vec2> hull = {start};
+        ei::Vec2 current = start;
+        bool found = false, complete = false;
+        ei::Vec2 next = current;
+        size_t nextGroup = 0, nextIndex = 0;
+
+        // One parallel region for all steps: every step searches the tangents of its share of the groups, merges its
+        // candidate and one thread appends the winner, so a step costs two barriers instead of starting a region
+        #pragma omp parallel if(groupCount >= PARALLEL_MIN_GROUPS) default(none) shared(hulls, hullCounts, groupCount, groupSize, stride, bound, start, hull, current, currentGroup, currentIndex, found, complete, next, nextGroup, nextIndex)
+        for (size_t step = 0; step < groupSize; ++step) {
+            bool localFound = false;
+            ei::Vec2 localNext = current;
+            size_t localGroup = 0, localIndex = 0;
+            #pragma omp for schedule(static) nowait
+            for (size_t group = 0; group < groupCount; ++group) {
+                const ei::Vec2* groupHull = hulls.data() + group * stride;
+                const size_t count = hullCounts[group];
+                // The current point is a vertex of its own group hull, the tangent is simply the next vertex
+                const size_t index = group == currentGroup ? (count > 1 ? (currentIndex + 1) % count : count)
+                                                           : binaryTangent(current, groupHull, count, bound);
+                if (index == count)
+                    continue;
+                if (!localFound || isBetterCandidate(current, localNext, groupHull[index], bound)) {
+                    localNext = groupHull[index];
+                    localGroup = group;
+                    localIndex = index;
+                    localFound = true;
+                }
+            }
+            #pragma omp critical
+            if (localFound && (!found || isBetterCandidate(current, next, localNext, bound))) {
+                next = localNext;
+                nextGroup = localGroup;
+                nextIndex = localIndex;
+                found = true;
+            }
+            #pragma omp barrier
+            #pragma omp single
+            {
+                if (!found || next == start) {
+                    complete = true;
+                } else {
+                    hull.push_back(next);
+                    current = next;
+                    currentGroup = nextGroup;
+                    currentIndex = nextIndex;
+                    found = false;
+                }
+            }
+            if (complete)
+                break;
+        }
+
+        if (complete)
+            return hull;
+    }
+}
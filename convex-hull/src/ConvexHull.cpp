@@ -0,0 +1,78 @@
+﻿#include "ConvexHull.h"
+
+#include <bit>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "ChansAlgorithm.h"
+#include "DivideAndConquer.h"
+#include "JarvisMarch.h"
+#include "MonotoneChain.h"
+#include "QuickHull.h"
+
+std::vector<ei::Vec2> computeHull(Algorithm algorithm, std::vector<ei::Vec2>& points)
+{
+    switch (algorithm)
+    {
+        case QUICK_HULL:
+            return quick_hull_performance(points);
+        case JARVIS_MARCH:
+            return jarvis_march_performance(points);
+        case DIVIDE_AND_CONQUER:
+            return divide_and_conquer_performance(points);
+        case QUICK_HULL_INPLACE:
+            return quick_hull_inplace(points);
+        case QUICK_HULL_PARALLEL:
+            return quick_hull_parallel(points);
+        case MONOTONE_CHAIN:
+            return monotone_chain_performance(points);
+        case CHANS_ALGORITHM:
+            return chans_algorithm_performance(points);
+        case QUICK_HULL_SIMD:
+            return quick_hull_simd(points);
+        default:
+            throw std::invalid_argument("Invalid algorithm mode specified.");
+    }
+}
+
+// Bit pattern of a point as hash key (+0 and -0 compare equal, so both map to +0)
+static inline std::uint64_t pointKey(const ei::Vec2& point)
+{
+    const float x = point.x == 0.0f ? 0.0f : point.x;
+    const float y = point.y == 0.0f ? 0.0f : point.y;
+    return (static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(x)) << 32) | std::bit_cast<std::uint32_t>(y);
+}
+
+std::vector<std::uint32_t> hull_indices(Algorithm algorithm, std::span<const ei::Vec2> points)
+{
+    std::vector<ei::Vec2> input(points.begin(), points.end());
+    const std::vector<ei::Vec2> hull = computeHull(algorithm, input);
+
+    // The hull points are copies of input points: one pass over the input finds the first index of each
+    constexpr std::uint32_t UNASSIGNED = UINT32_MAX;
+    std::unordered_map<std::uint64_t, std::uint32_t> indices;
+    indices.reserve(hull.size());
+    for (const ei::Vec2& point : hull)
+        indices.emplace(pointKey(point), UNASSIGNED);
+    size_t remaining = indices.size();
+    for (size_t i = 0; i < points.size() && remaining > 0; ++i)
+    {
+        auto it = indices.find(pointKey(points[i]));
+        if (it != indices.end() && it->second == UNASSIGNED)
+        {
+            it->second = static_cast<std::uint32_t>(i);
+            --remaining;
+        }
+    }
+
+    std::vector<std::uint32_t> result;
+    result.reserve(hull.size());
+    for (const ei::Vec2& point : hull)
+        result.push_back(indices.at(pointKey(point)));
+    return result;
+}
+
+std::size_t hull_indices(std::span<const float> xs, std::span<const float> ys, std::span<std::uint32_t> out)
+{
+    return quick_hull_indices(xs, ys, out);
+}
@@ -4,56 +4,120 @@
 
 #include "DataGenerator.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <stdexcept>
 
-std::vector<ei::Vec2> DataGenerator::GeneratePoints(Generator generator, size_t numPoints)
+constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;  ///< SplitMix64 increment (2^64 / golden ratio)
+constexpr size_t CLUSTER_COUNT = 64;                           ///< Number of clusters of the CLUSTERS distribution
+constexpr float WINDOW_DEFAULT_DEPTH = WINDOW_DEFAULT_HEIGHT;  ///< Depth of the box of the 3D generators
+
+// SplitMix64 finalizer: a bijective hash whose output passes BigCrush for consecutive inputs
+static inline std::uint64_t splitMix64(std::uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * Counter-based random numbers: number `counter` of a stream is the hash of the stream key plus counter * gamma
+ * (SplitMix64 evaluated at an arbitrary position). There is no state to advance, so every point can draw its
+ * numbers (counter = point index * draws per point + draw) on any thread.
+ */
+class CounterRng
+{
+public:
+    CounterRng(std::uint64_t seed, std::uint64_t stream) : key(splitMix64(seed + splitMix64(stream * GOLDEN_GAMMA))) {}
+
+    std::uint64_t bits(std::uint64_t counter) const { return splitMix64(key + (counter + 1) * GOLDEN_GAMMA); }
+
+    // Uniform in [min, max) with the 24 bits of float precision
+    float uniform(std::uint64_t counter, float min, float max) const
+    {
+        return min + static_cast<float>(bits(counter) >> 40) * 0x1.0p-24f * (max - min);
+    }
+
+    // Uniform in (0, 1] with double precision (safe for std::log)
+    double unitOpenZero(std::uint64_t counter) const
+    {
+        return static_cast<double>((bits(counter) >> 11) + 1) * 0x1.0p-53;
+    }
+
+    // Standard normal distributed pair of two draws (Box-Muller)
+    std::pair<double, double> normal(std::uint64_t counter) const
+    {
+        const double radius = std::sqrt(-2.0 * std::log(unitOpenZero(counter)));
+        const double angle = 2.0 * M_PI * unitOpenZero(counter + 1);
+        return {radius * std::cos(angle), radius * std::sin(angle)};
+    }
+
+private:
+    std::uint64_t key;
+};
+
+// Streams, so the generators with the same seed do not produce correlated points
+enum RngStream : std::uint64_t
+{
+    POINT_STREAM = 1,
+    LINE_STREAM = 2,
+    CLUSTER_CENTER_STREAM = 3
+};
+
+// Fills points[first, count) in parallel chunks with generate(i)
+template<typename Point, typename Function>
+static void generateParallel(std::vector<Point>& points, size_t first, const Function& generate)
+{
+    const std::ptrdiff_t count = static_cast<std::ptrdiff_t>(points.size());
+    #pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t i = static_cast<std::ptrdiff_t>(first); i < count; ++i) {
+        points[i] = generate(static_cast<size_t>(i));
+    }
+}
+
+std::vector<ei::Vec2> DataGenerator::GeneratePoints(Generator generator, size_t numPoints, std::uint64_t seed)
 {
     switch (generator)
     {
         case RANDOM_POINTS:
-            return GenerateRandomPoints(numPoints);
+        case LARGE_DATASET:
+            return GenerateRandomPoints(numPoints, seed);
         case STRAIGHT_LINE:
-            return GenerateStraightLine(numPoints);
+            return GenerateStraightLine(numPoints, seed);
         case CIRCLE:
             return GenerateCircle(numPoints);
         case SQUARE:
-            return GeneratePointsInSquare(numPoints);
+            return GeneratePointsInSquare(numPoints, seed);
+        case GAUSSIAN_CLUSTER:
+            return GenerateGaussianCluster(numPoints, seed);
+        case ANNULUS:
+            return GenerateAnnulus(numPoints, seed);
+        case CLUSTERS:
+            return GenerateClusters(numPoints, seed);
         default:
             throw std::invalid_argument("Invalid generator type.");
     }
 }
 
 // 1. Generate a random distribution of points.
-std::vector<ei::Vec2> DataGenerator::GenerateRandomPoints(size_t numPoints) {
-    std::vector<ei::Vec2> points;
-    points.reserve(numPoints);
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> x_dist(0.0f, static_cast<float>(WINDOW_DEFAULT_WIDTH));
-    std::uniform_real_distribution<float> y_dist(0.0f, static_cast<float>(WINDOW_DEFAULT_HEIGHT));
-
-    for (size_t i = 0; i < numPoints; ++i) {
-        float x = x_dist(gen);
-        float y = y_dist(gen);
-        points.emplace_back(x, y);
-    }
+std::vector<ei::Vec2> DataGenerator::GenerateRandomPoints(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec2> points(numPoints);
+    const CounterRng rng(seed, POINT_STREAM);
+    const float width = static_cast<float>(WINDOW_DEFAULT_WIDTH);
+    const float height = static_cast<float>(WINDOW_DEFAULT_HEIGHT);
+
+    generateParallel(points, 0, [&](size_t i) {
+        return ei::Vec2(rng.uniform(2 * i, 0.0f, width), rng.uniform(2 * i + 1, 0.0f, height));
+    });
 
     return points;
 }
 
 // 2. Generate points forming a straight line.
-#include <cstdlib>
-#include <ctime>
-#include <cmath>
-#include <ei/2dtypes.hpp>
-
-std::vector<ei::Vec2> DataGenerator::GenerateStraightLine(size_t numPoints) {
-    std::vector<ei::Vec2> points;
-    points.reserve(numPoints);
-
-    // Seed for random number generator
-    std::srand(static_cast<unsigned>(std::time(0)));
+std::vector<ei::Vec2> DataGenerator::GenerateStraightLine(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec2> points(numPoints);
+    const CounterRng rng(seed, LINE_STREAM);
 
     // Define the range within the window boundaries
     float minX = 100.0f;
@@ -62,30 +126,30 @@ std::vector<ei::Vec2> DataGenerator::GenerateStraightLine(size_t numPoints) {
     float maxY = WINDOW_DEFAULT_HEIGHT - 100.0f;
 
     // Randomly choose the line type: 0 = horizontal, 1 = vertical, 2 = diagonal
-    int lineType = std::rand() % 3;
+    int lineType = static_cast<int>(rng.bits(0) % 3);
 
     float x0, y0, x1, y1;
 
     switch (lineType) {
     case 0: // Horizontal Line
         std::cout << "Generating horizontal line..." << std::endl;
-        y0 = y1 = minY + static_cast<float>(std::rand()) / RAND_MAX * (maxY - minY);
+        y0 = y1 = rng.uniform(1, minY, maxY);
         x0 = minX;
         x1 = maxX;
         break;
     case 1: // Vertical Line
         std::cout << "Generating vertical line..." << std::endl;
-        x0 = x1 = minX + static_cast<float>(std::rand()) / RAND_MAX * (maxX - minX);
+        x0 = x1 = rng.uniform(1, minX, maxX);
         y0 = minY;
         y1 = maxY;
         break;
-    case 2: // Diagonal Line (random angle)
+    default: // Diagonal Line (random angle)
         std::cout << "Generating diagonal line (random angle)..." << std::endl;
-        x0 = minX + static_cast<float>(std::rand()) / RAND_MAX * (maxX - minX);
-        y0 = minY + static_cast<float>(std::rand()) / RAND_MAX * (maxY - minY);
+        x0 = rng.uniform(1, minX, maxX);
+        y0 = rng.uniform(2, minY, maxY);
 
         // Randomly pick an angle between -45 to 45 degrees (converted to radians)
-        float angle = -0.785398f + static_cast<float>(std::rand()) / RAND_MAX * 1.5708f;
+        float angle = rng.uniform(3, -0.785398f, 0.785398f);
 
         // Calculate endpoint using the chosen angle and the line's length
         float length = std::min(maxX - x0, maxY - y0) * 0.8f; // Adjust length to fit within bounds
@@ -95,12 +159,11 @@ std::vector<ei::Vec2> DataGenerator::GenerateStraightLine(size_t numPoints) {
     }
 
     // Generate points along the line
-    for (size_t i = 0; i < numPoints; ++i) {
-        float t = static_cast<float>(i) / (numPoints - 1);
-        float x = x0 + t * (x1 - x0);
-        float y = y0 + t * (y1 - y0);
-        points.emplace_back(x, y);
-    }
+    const float steps = numPoints > 1 ? static_cast<float>(numPoints - 1) : 1.0f;
+    generateParallel(points, 0, [&](size_t i) {
+        float t = static_cast<float>(i) / steps;
+        return ei::Vec2(x0 + t * (x1 - x0), y0 + t * (y1 - y0));
+    });
 
     return points;
 }
@@ -108,27 +171,24 @@ std::vector<ei::Vec2> DataGenerator::GenerateStraightLine(size_t numPoints) {
 
 // 3. Generate points forming a circle.
 std::vector<ei::Vec2> DataGenerator::GenerateCircle(size_t numPoints) {
-    std::vector<ei::Vec2> points;
-    points.reserve(numPoints);
+    std::vector<ei::Vec2> points(numPoints);
 
     float cx = WINDOW_DEFAULT_WIDTH / 2.0f;
     float cy = WINDOW_DEFAULT_HEIGHT / 2.0f;
     float radius = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) / 2.0f - 50.0f;
 
-    for (size_t i = 0; i < numPoints; ++i) {
+    generateParallel(points, 0, [&](size_t i) {
         float angle = 2.0f * static_cast<float>(M_PI) * i / numPoints;
-        float x = cx + radius * std::cos(angle);
-        float y = cy + radius * std::sin(angle);
-        points.emplace_back(x, y);
-    }
+        return ei::Vec2(cx + radius * std::cos(angle), cy + radius * std::sin(angle));
+    });
 
     return points;
 }
 
 // 4. Generate a random distribution inside a square box.
-std::vector<ei::Vec2> DataGenerator::GeneratePointsInSquare(size_t numPoints) {
-    std::vector<ei::Vec2> points;
-    points.reserve(numPoints);
+std::vector<ei::Vec2> DataGenerator::GeneratePointsInSquare(size_t numPoints, std::uint64_t seed) {
+    // If fewer points are requested, only the corners are returned.
+    std::vector<ei::Vec2> points(std::max<size_t>(numPoints, 4));
 
     // Determine the size and position of the square
     float square_size = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) - 200.0f; // Leave margin
@@ -136,27 +196,280 @@ std::vector<ei::Vec2> DataGenerator::GeneratePointsInSquare(size_t numPoints) {
     float y0 = (WINDOW_DEFAULT_HEIGHT - square_size) / 2.0f;
 
     // Add the four corner points of the square
-    points.emplace_back(x0, y0);                           // Top-left corner
-    points.emplace_back(x0 + square_size, y0);              // Top-right corner
-    points.emplace_back(x0, y0 + square_size);              // Bottom-left corner
-    points.emplace_back(x0 + square_size, y0 + square_size);// Bottom-right corner
+    points[0] = ei::Vec2(x0, y0);                               // Top-left corner
+    points[1] = ei::Vec2(x0 + square_size, y0);                 // Top-right corner
+    points[2] = ei::Vec2(x0, y0 + square_size);                 // Bottom-left corner
+    points[3] = ei::Vec2(x0 + square_size, y0 + square_size);   // Bottom-right corner
 
-    // Adjust the number of random points to generate
-    if (numPoints < 4) return points; // If fewer points are requested, only return the corners.
-    size_t randomPointsToGenerate = numPoints - 4;
+    // Generate random points inside the square
+    const CounterRng rng(seed, POINT_STREAM);
+    generateParallel(points, 4, [&](size_t i) {
+        return ei::Vec2(rng.uniform(2 * i, x0, x0 + square_size), rng.uniform(2 * i + 1, y0, y0 + square_size));
+    });
 
-    // Set up random number generation within the square bounds
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> distX(x0, x0 + square_size);
-    std::uniform_real_distribution<float> distY(y0, y0 + square_size);
+    return points;
+}
 
-    // Generate random points inside the square
-    for (size_t i = 0; i < randomPointsToGenerate; ++i) {
-        float x = distX(gen);
-        float y = distY(gen);
-        points.emplace_back(x, y);
+// 5. Generate a normal distribution around the center (standard deviation 1/8 of the window).
+std::vector<ei::Vec2> DataGenerator::GenerateGaussianCluster(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec2> points(numPoints);
+    const CounterRng rng(seed, POINT_STREAM);
+
+    const double cx = WINDOW_DEFAULT_WIDTH / 2.0;
+    const double cy = WINDOW_DEFAULT_HEIGHT / 2.0;
+    const double sigma = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) / 8.0;
+
+    generateParallel(points, 0, [&](size_t i) {
+        const auto [x, y] = rng.normal(2 * i);
+        return ei::Vec2(static_cast<float>(cx + sigma * x), static_cast<float>(cy + sigma * y));
+    });
+
+    return points;
+}
+
+// 6. Generate a uniform distribution inside a ring (inner radius 90% of the outer radius).
+std::vector<ei::Vec2> DataGenerator::GenerateAnnulus(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec2> points(numPoints);
+    const CounterRng rng(seed, POINT_STREAM);
+
+    const double cx = WINDOW_DEFAULT_WIDTH / 2.0;
+    const double cy = WINDOW_DEFAULT_HEIGHT / 2.0;
+    const double outer = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) / 2.0 - 50.0;
+    const double inner = 0.9 * outer;
+
+    // Uniform by area: the squared radius is uniform between inner^2 and outer^2
+    generateParallel(points, 0, [&](size_t i) {
+        const double radius = std::sqrt(inner * inner + rng.unitOpenZero(2 * i) * (outer * outer - inner * inner));
+        const double angle = 2.0 * M_PI * rng.unitOpenZero(2 * i + 1);
+        return ei::Vec2(static_cast<float>(cx + radius * std::cos(angle)), static_cast<float>(cy + radius * std::sin(angle)));
+    });
+
+    return points;
+}
+
+// 7. Generate CLUSTER_COUNT small normal distributions, every point belongs to a random cluster.
+std::vector<ei::Vec2> DataGenerator::GenerateClusters(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec2> points(numPoints);
+    const CounterRng centerRng(seed, CLUSTER_CENTER_STREAM);
+    const CounterRng rng(seed, POINT_STREAM);
+
+    // Cluster centers keep a margin of 4 sigma to the window border
+    const double sigma = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) / 64.0;
+    std::vector<ei::Vec2> centers(CLUSTER_COUNT);
+    for (size_t c = 0; c < CLUSTER_COUNT; ++c) {
+        centers[c] = ei::Vec2(centerRng.uniform(2 * c, 4 * sigma, WINDOW_DEFAULT_WIDTH - 4 * sigma),
+                              centerRng.uniform(2 * c + 1, 4 * sigma, WINDOW_DEFAULT_HEIGHT - 4 * sigma));
+    }
+
+    generateParallel(points, 0, [&](size_t i) {
+        const ei::Vec2& center = centers[rng.bits(3 * i) % CLUSTER_COUNT];
+        const auto [x, y] = rng.normal(3 * i + 1);
+        return ei::Vec2(static_cast<float>(center.x + sigma * x), static_cast<float>(center.y + sigma * y));
+    });
+
+    return points;
+}
+
+// Generate points inside a regular polygon (convex hull with a given number of points).
+std::vector<ei::Vec2> DataGenerator::GeneratePolygon(size_t numPoints, size_t hullPoints, std::uint64_t seed) {
+    float cx = WINDOW_DEFAULT_WIDTH / 2.0f;
+    float cy = WINDOW_DEFAULT_HEIGHT / 2.0f;
+    float radius = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) / 2.0f - 50.0f;
+    hullPoints = std::max<size_t>(3, std::min(hullPoints, numPoints));
+    std::vector<ei::Vec2> points(std::max(numPoints, hullPoints));
+
+    // Corners of the polygon
+    std::vector<ei::Vec2> corners;
+    for (size_t i = 0; i < hullPoints; ++i) {
+        float angle = 2.0f * static_cast<float>(M_PI) * i / hullPoints;
+        corners.emplace_back(cx + radius * std::cos(angle), cy + radius * std::sin(angle));
     }
+    std::copy(corners.begin(), corners.end(), points.begin());
+
+    // Uniform points in a random triangle (center, corner i, corner i + 1) of the polygon
+    // NOTE: Scaled slightly towards the center, so no point lands on (or due to rounding outside of) an edge
+    const CounterRng rng(seed, POINT_STREAM);
+    generateParallel(points, hullPoints, [&](size_t p) {
+        size_t i = rng.bits(3 * p) % hullPoints;
+        float u = rng.uniform(3 * p + 1, 0.0f, 0.99f);
+        float v = rng.uniform(3 * p + 2, 0.0f, 0.99f);
+        if (u + v > 0.99f) {
+            u = 0.99f - u;
+            v = 0.99f - v;
+        }
+        const ei::Vec2& a = corners[i];
+        const ei::Vec2& b = corners[(i + 1) % hullPoints];
+        return ei::Vec2(cx + u * (a.x - cx) + v * (b.x - cx), cy + u * (a.y - cy) + v * (b.y - cy));
+    });
+
+    return points;
+}
+
+std::vector<ei::Vec3> DataGenerator::GeneratePoints3D(Generator generator, size_t numPoints, std::uint64_t seed)
+{
+    switch (generator)
+    {
+        case RANDOM_POINTS:
+        case LARGE_DATASET:
+            return GenerateRandomPoints3D(numPoints, seed);
+        case STRAIGHT_LINE:
+            return GenerateStraightLine3D(numPoints, seed);
+        case CIRCLE:
+            return GenerateSphere(numPoints);
+        case SQUARE:
+            return GeneratePointsInCube(numPoints, seed);
+        case GAUSSIAN_CLUSTER:
+            return GenerateGaussianCluster3D(numPoints, seed);
+        case ANNULUS:
+            return GenerateShell(numPoints, seed);
+        case CLUSTERS:
+            return GenerateClusters3D(numPoints, seed);
+        default:
+            throw std::invalid_argument("Invalid generator type.");
+    }
+}
+
+// Uniform direction on the unit sphere (z uniform in [-1, 1), uniform angle) from two draws
+static inline void unitDirection(const CounterRng& rng, std::uint64_t counter, double& x, double& y, double& z)
+{
+    z = 2.0 * rng.unitOpenZero(counter) - 1.0;
+    const double angle = 2.0 * M_PI * rng.unitOpenZero(counter + 1);
+    const double radius = std::sqrt(std::max(0.0, 1.0 - z * z));
+    x = radius * std::cos(angle);
+    y = radius * std::sin(angle);
+}
+
+// 1. Random distribution in the box of the window size.
+std::vector<ei::Vec3> DataGenerator::GenerateRandomPoints3D(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec3> points(numPoints);
+    const CounterRng rng(seed, POINT_STREAM);
+
+    generateParallel(points, 0, [&](size_t i) {
+        return ei::Vec3(rng.uniform(3 * i, 0.0f, WINDOW_DEFAULT_WIDTH), rng.uniform(3 * i + 1, 0.0f, WINDOW_DEFAULT_HEIGHT),
+                        rng.uniform(3 * i + 2, 0.0f, WINDOW_DEFAULT_DEPTH));
+    });
+
+    return points;
+}
+
+// 2. Points on a line between two random points of the box (no 3D hull).
+std::vector<ei::Vec3> DataGenerator::GenerateStraightLine3D(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec3> points(numPoints);
+    const CounterRng rng(seed, LINE_STREAM);
+    const ei::Vec3 start(rng.uniform(0, 100.0f, WINDOW_DEFAULT_WIDTH - 100.0f), rng.uniform(1, 100.0f, WINDOW_DEFAULT_HEIGHT - 100.0f),
+                         rng.uniform(2, 100.0f, WINDOW_DEFAULT_DEPTH - 100.0f));
+    const ei::Vec3 end(rng.uniform(3, 100.0f, WINDOW_DEFAULT_WIDTH - 100.0f), rng.uniform(4, 100.0f, WINDOW_DEFAULT_HEIGHT - 100.0f),
+                       rng.uniform(5, 100.0f, WINDOW_DEFAULT_DEPTH - 100.0f));
+
+    const float steps = numPoints > 1 ? static_cast<float>(numPoints - 1) : 1.0f;
+    generateParallel(points, 0, [&](size_t i) {
+        float t = static_cast<float>(i) / steps;
+        return ei::Vec3(start.x + t * (end.x - start.x), start.y + t * (end.y - start.y), start.z + t * (end.z - start.z));
+    });
+
+    return points;
+}
+
+// 3. Points on a sphere (Fibonacci lattice, evenly spread like the points of the circle).
+std::vector<ei::Vec3> DataGenerator::GenerateSphere(size_t numPoints) {
+    std::vector<ei::Vec3> points(numPoints);
+
+    const double cx = WINDOW_DEFAULT_WIDTH / 2.0;
+    const double cy = WINDOW_DEFAULT_HEIGHT / 2.0;
+    const double cz = WINDOW_DEFAULT_DEPTH / 2.0;
+    const double radius = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) / 2.0 - 50.0;
+    const double goldenAngle = M_PI * (3.0 - std::sqrt(5.0));
+
+    generateParallel(points, 0, [&](size_t i) {
+        const double z = 1.0 - (2.0 * static_cast<double>(i) + 1.0) / static_cast<double>(numPoints);
+        const double ring = std::sqrt(std::max(0.0, 1.0 - z * z));
+        const double angle = goldenAngle * static_cast<double>(i);
+        return ei::Vec3(static_cast<float>(cx + radius * ring * std::cos(angle)),
+                        static_cast<float>(cy + radius * ring * std::sin(angle)), static_cast<float>(cz + radius * z));
+    });
+
+    return points;
+}
+
+// 4. Random distribution inside a cube, the first 8 points are its corners.
+std::vector<ei::Vec3> DataGenerator::GeneratePointsInCube(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec3> points(std::max<size_t>(numPoints, 8));
+
+    const float size = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) - 200.0f;
+    const float x0 = (WINDOW_DEFAULT_WIDTH - size) / 2.0f;
+    const float y0 = (WINDOW_DEFAULT_HEIGHT - size) / 2.0f;
+    const float z0 = (WINDOW_DEFAULT_DEPTH - size) / 2.0f;
+    for (size_t corner = 0; corner < 8; ++corner) {
+        points[corner] = ei::Vec3(x0 + (corner & 1 ? size : 0.0f), y0 + (corner & 2 ? size : 0.0f), z0 + (corner & 4 ? size : 0.0f));
+    }
+
+    const CounterRng rng(seed, POINT_STREAM);
+    generateParallel(points, 8, [&](size_t i) {
+        return ei::Vec3(rng.uniform(3 * i, x0, x0 + size), rng.uniform(3 * i + 1, y0, y0 + size),
+                        rng.uniform(3 * i + 2, z0, z0 + size));
+    });
+
+    return points;
+}
+
+// 5. Normal distribution around the center of the box (standard deviation 1/8 of the window).
+std::vector<ei::Vec3> DataGenerator::GenerateGaussianCluster3D(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec3> points(numPoints);
+    const CounterRng rng(seed, POINT_STREAM);
+
+    const double sigma = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) / 8.0;
+    generateParallel(points, 0, [&](size_t i) {
+        const auto [x, y] = rng.normal(4 * i);
+        const double z = rng.normal(4 * i + 2).first;
+        return ei::Vec3(static_cast<float>(WINDOW_DEFAULT_WIDTH / 2.0 + sigma * x), static_cast<float>(WINDOW_DEFAULT_HEIGHT / 2.0 + sigma * y),
+                        static_cast<float>(WINDOW_DEFAULT_DEPTH / 2.0 + sigma * z));
+    });
+
+    return points;
+}
+
+// 6. Uniform distribution inside a spherical shell (inner radius 90% of the outer radius).
+std::vector<ei::Vec3> DataGenerator::GenerateShell(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec3> points(numPoints);
+    const CounterRng rng(seed, POINT_STREAM);
+
+    const double outer = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) / 2.0 - 50.0;
+    const double inner = 0.9 * outer;
+
+    // Uniform by volume: the cubed radius is uniform between inner^3 and outer^3
+    generateParallel(points, 0, [&](size_t i) {
+        const double cubed = inner * inner * inner + rng.unitOpenZero(3 * i) * (outer * outer * outer - inner * inner * inner);
+        const double radius = std::cbrt(cubed);
+        double x, y, z;
+        unitDirection(rng, 3 * i + 1, x, y, z);
+        return ei::Vec3(static_cast<float>(WINDOW_DEFAULT_WIDTH / 2.0 + radius * x), static_cast<float>(WINDOW_DEFAULT_HEIGHT / 2.0 + radius * y),
+                        static_cast<float>(WINDOW_DEFAULT_DEPTH / 2.0 + radius * z));
+    });
+
+    return points;
+}
+
+// 7. CLUSTER_COUNT small normal distributions in the box, every point belongs to a random cluster.
+std::vector<ei::Vec3> DataGenerator::GenerateClusters3D(size_t numPoints, std::uint64_t seed) {
+    std::vector<ei::Vec3> points(numPoints);
+    const CounterRng centerRng(seed, CLUSTER_CENTER_STREAM);
+    const CounterRng rng(seed, POINT_STREAM);
+
+    const double sigma = std::min(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT) / 64.0;
+    std::vector<ei::Vec3> centers(CLUSTER_COUNT);
+    for (size_t c = 0; c < CLUSTER_COUNT; ++c) {
+        centers[c] = ei::Vec3(centerRng.uniform(3 * c, 4 * sigma, WINDOW_DEFAULT_WIDTH - 4 * sigma),
+                              centerRng.uniform(3 * c + 1, 4 * sigma, WINDOW_DEFAULT_HEIGHT - 4 * sigma),
+                              centerRng.uniform(3 * c + 2, 4 * sigma, WINDOW_DEFAULT_DEPTH - 4 * sigma));
+    }
+
+    generateParallel(points, 0, [&](size_t i) {
+        const ei::Vec3& center = centers[rng.bits(5 * i) % CLUSTER_COUNT];
+        const auto [x, y] = rng.normal(5 * i + 1);
+        const double z = rng.normal(5 * i + 3).first;
+        return ei::Vec3(static_cast<float>(center.x + sigma * x), static_cast<float>(center.y + sigma * y),
+                        static_cast<float>(center.z + sigma * z));
+    });
 
     return points;
 }
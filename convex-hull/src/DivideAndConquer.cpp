@@ -0,0 +1,117 @@
+﻿#include "DivideAndConquer.h"
+#include "Predicates.h"
+
+#include <algorithm>
+#include <iterator>
+
+constexpr size_t SORT_CUTOFF = 1 << 14;  ///< Smaller ranges are sorted sequentially by one task
+constexpr size_t TASK_CUTOFF = 1 << 12;  ///< Smaller sub-hulls are built sequentially by one task
+
+static inline bool lexicographicLess(const ei::Vec2& a, const ei::Vec2& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Task-parallel merge sort (must be called from within a parallel region)
+static void parallelSort(ei::Vec2* first, ei::Vec2* last) {
+    const size_t size = last - first;
+    if (size < SORT_CUTOFF) {
+        std::sort(first, last, lexicographicLess);
+        return;
+    }
+    ei::Vec2* middle = first + size / 2;
+    #pragma omp task default(none) firstprivate(first, middle)
+    parallelSort(first, middle);
+    parallelSort(middle, last);
+    #pragma omp taskwait
+    std::inplace_merge(first, middle, last, lexicographicLess);
+}
+
+/**
+ * Finds the tangent (bridge) between two x-separated hull chains, both ordered by x.
+ * side = 1 for upper chains (all points end up below the tangent), side = -1 for lower chains.
+ * Alternately walks the left chain to the left and the right chain to the right as long as the next point
+ * is not strictly on the inner side of the current line (collinear points are skipped).
+ * @return Index of the tangent point in the left and in the right chain.
+ */
+std::pair<size_t, size_t> findTangent(const ei::Vec2* left, size_t leftCount,
+                                      const ei::Vec2* right, size_t rightCount, int side) {
+    size_t i = leftCount - 1;
+    size_t j = 0;
+    bool moved = true;
+    while (moved) {
+        moved = false;
+        while (i > 0 && side * orient2d(left[i], right[j], left[i - 1]) >= 0) {
+            --i;
+            moved = true;
+        }
+        while (j + 1 < rightCount && side * orient2d(left[i], right[j], right[j + 1]) >= 0) {
+            ++j;
+            moved = true;
+        }
+    }
+    return {i, j};
+}
+
+// Joins left[0, i] and right[j, rightCount) behind each other at left. right has to be located behind left.
+size_t joinChains(ei::Vec2* left, size_t i, const ei::Vec2* right, size_t j, size_t rightCount) {
+    std::copy(right + j, right + rightCount, left + i + 1);
+    return i + 1 + rightCount - j;
+}
+
+/**
+ * Builds the upper and lower hull chain of size sorted points. Both buffers initially hold the same points,
+ * the chains are stored at the front of their buffer.
+ * @return Number of points in the upper and in the lower chain.
+ */
+static std::pair<size_t, size_t> buildHull(ei::Vec2* upper, ei::Vec2* lower, size_t size) {
+    if (size == 1)
+        return {1, 1};
+
+    const size_t half = size / 2;
+    std::pair<size_t, size_t> left, right;
+    if (size >= TASK_CUTOFF) {
+        #pragma omp task default(none) shared(left, upper, lower, half)
+        left = buildHull(upper, lower, half);
+        right = buildHull(upper + half, lower + half, size - half);
+        #pragma omp taskwait
+    } else {
+        left = buildHull(upper, lower, half);
+        right = buildHull(upper + half, lower + half, size - half);
+    }
+
+    auto [upperLeft, upperRight] = findTangent(upper, left.first, upper + half, right.first, 1);
+    auto [lowerLeft, lowerRight] = findTangent(lower, left.second, lower + half, right.second, -1);
+    return {joinChains(upper, upperLeft, upper + half, upperRight, right.first),
+            joinChains(lower, lowerLeft, lower + half, lowerRight, right.second)};
+}
+
+// Lower chain followed by the upper chain in reverse order (without the shared end points)
+std::vector<ei::Vec2> chainsToHull(const ei::Vec2* upper, size_t upperCount,
+                                   const ei::Vec2* lower, size_t lowerCount) {
+    std::vector<ei::Vec2> hull(lower, lower + lowerCount);
+    if (upperCount > 2)
+        std::reverse_copy(upper + 1, upper + upperCount - 1, std::back_inserter(hull));
+    return hull;
+}
+
+std::vector<ei::Vec2> divide_and_conquer_performance(const INPUT_PARAMETER& points)
+{
+    std::vector<ei::Vec2> upper(points);
+    if (upper.size() < 3)
+    {
+        return upper;
+    }
+
+    #pragma omp parallel default(none) shared(upper)
+    #pragma omp single
+    parallelSort(upper.data(), upper.data() + upper.size());
+    upper.erase(std::unique(upper.begin(), upper.end()), upper.end());
+    std::vector<ei::Vec2> lower(upper);
+
+    std::pair<size_t, size_t> counts;
+    #pragma omp parallel default(none) shared(upper, lower, counts)
+    #pragma omp single
+    counts = buildHull(upper.data(), lower.data(), upper.size());
+
+    return chainsToHull(upper.data(), counts.first, lower.data(), counts.second);
+}
@@ -0,0 +1,243 @@
+﻿#include "DynamicHull.h"
+#include "Predicates.h"
+
+#include <iterator>
+#include <stdexcept>
+
+static inline bool lexicographicLess(const ei::Vec2& a, const ei::Vec2& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Dot product of direction with the edge from -> to (in double, so the edge vector is not rounded to float first)
+static inline double edgeDot(const ei::Vec2& direction, const ei::Vec2& from, const ei::Vec2& to) {
+    return double(direction.x) * (double(to.x) - from.x) + double(direction.y) * (double(to.y) - from.y);
+}
+
+DynamicHull::DynamicHull(const std::vector<ei::Vec2>& points)
+{
+    for (const auto& point : points)
+        insert(point);
+}
+
+void DynamicHull::insert(const ei::Vec2& point)
+{
+    ++count;
+    if (points[point]++ > 0)
+        return;
+    insertIntoChain(lower, LOWER, point);
+    insertIntoChain(upper, UPPER, point);
+}
+
+bool DynamicHull::erase(const ei::Vec2& point)
+{
+    auto it = points.find(point);
+    if (it == points.end())
+        return false;
+    --count;
+    if (--it->second > 0)
+        return true;
+    points.erase(it);
+
+    // The remaining hull vertices stay hull vertices, only the chain around the removed one changes
+    auto vertex = lower.find(ChainVertex{point});
+    if (vertex != lower.end())
+        rebuildChain(lower, LOWER, vertex);
+    vertex = upper.find(ChainVertex{point});
+    if (vertex != upper.end())
+        rebuildChain(upper, UPPER, vertex);
+    return true;
+}
+
+void DynamicHull::clear()
+{
+    points.clear();
+    lower.clear();
+    upper.clear();
+    count = 0;
+}
+
+std::size_t DynamicHull::hullSize() const
+{
+    // Both chains contain the leftmost and the rightmost point
+    if (lower.size() < 2)
+        return lower.size();
+    return lower.size() + upper.size() - 2;
+}
+
+std::vector<ei::Vec2> DynamicHull::hull() const
+{
+    std::vector<ei::Vec2> hull;
+    hull.reserve(hullSize());
+    for (const auto& vertex : lower)
+        hull.push_back(vertex.point);
+    if (upper.size() > 2)
+    {
+        for (auto it = std::next(upper.rbegin()); it != std::prev(upper.rend()); ++it)
+            hull.push_back(it->point);
+    }
+    return hull;
+}
+
+bool DynamicHull::contains(const ei::Vec2& point) const
+{
+    if (lower.empty() || lexicographicLess(point, lower.begin()->point) || lexicographicLess(lower.rbegin()->point, point))
+        return false;
+
+    // Edge of each chain below/above the point (by lexicographic order), the point has to be on its inner side
+    auto inside = [&](const Chain& chain, int side) {
+        auto next = chain.lower_bound(ChainVertex{point});
+        return next->point == point || side * orient2d(std::prev(next)->point, next->point, point) >= 0;
+    };
+    return inside(lower, LOWER) && inside(upper, UPPER);
+}
+
+std::optional<ei::Vec2> DynamicHull::extremePoint(const ei::Vec2& direction) const
+{
+    if (direction.x == 0.0f && direction.y == 0.0f)
+        throw std::invalid_argument("The direction must not be the zero vector.");
+    if (lower.empty())
+        return std::nullopt;
+
+    // The leftmost and the rightmost point are extreme for horizontal directions
+    if (direction.y == 0.0f)
+        return direction.x > 0.0f ? lower.rbegin()->point : lower.begin()->point;
+
+    // Along the chain facing the direction the dot product first increases, then decreases
+    const Chain& chain = direction.y > 0.0f ? upper : lower;
+    auto before = [&](const ChainVertex& vertex) {
+        return vertex.hasNext && edgeDot(direction, vertex.point, vertex.next) > 0.0;
+    };
+    return chain.lower_bound(ChainSearch<decltype(before)>{before})->point;
+}
+
+std::optional<std::pair<ei::Vec2, ei::Vec2>> DynamicHull::tangents(const ei::Vec2& point) const
+{
+    if (lower.empty())
+        return std::nullopt;
+
+    const auto [lowerFirst, lowerLast] = visibleEdges(lower, LOWER, point);
+    const auto [upperFirst, upperLast] = visibleEdges(upper, UPPER, point);
+    const bool lowerVisible = lowerFirst != lowerLast;
+    const bool upperVisible = upperFirst != upperLast;
+
+    // Counterclockwise, the boundary is the lower chain from left to right and the upper chain from right to left.
+    // The visible part is contiguous, if it contains edges of both chains it passes the rightmost or the leftmost point
+    if (lowerVisible && upperVisible)
+    {
+        if (!lowerLast->hasNext && !upperLast->hasNext)
+            return std::make_pair(lowerFirst->point, upperFirst->point);
+        return std::make_pair(upperLast->point, lowerLast->point);
+    }
+    if (lowerVisible)
+        return std::make_pair(lowerFirst->point, lowerLast->point);
+    if (upperVisible)
+        return std::make_pair(upperLast->point, upperFirst->point);
+
+    // No edge is strictly visible: inside, on the boundary, or in line with a hull that is a single point or segment
+    if (contains(point))
+        return std::nullopt;
+    const ei::Vec2 nearest = lexicographicLess(point, lower.begin()->point) ? lower.begin()->point : lower.rbegin()->point;
+    return std::make_pair(nearest, nearest);
+}
+
+void DynamicHull::insertIntoChain(Chain& chain, int side, const ei::Vec2& point)
+{
+    auto next = chain.lower_bound(ChainVertex{point});
+    // Inside (or on) the edge spanning the point, nothing changes
+    if (next != chain.begin() && next != chain.end() && side * orient2d(std::prev(next)->point, next->point, point) >= 0)
+        return;
+
+    auto vertex = chain.insert(next, ChainVertex{point});
+
+    // Remove the vertices that no longer make a strict turn to the inner side, behind and in front of the point
+    for (auto following = std::next(vertex); following != chain.end() && std::next(following) != chain.end();)
+    {
+        if (side * orient2d(point, following->point, std::next(following)->point) > 0)
+            break;
+        following = chain.erase(following);
+    }
+    while (vertex != chain.begin() && std::prev(vertex) != chain.begin())
+    {
+        auto previous = std::prev(vertex);
+        if (side * orient2d(std::prev(previous)->point, previous->point, point) > 0)
+            break;
+        chain.erase(previous);
+    }
+
+    link(chain, vertex);
+    if (vertex != chain.begin())
+        link(chain, std::prev(vertex));
+}
+
+void DynamicHull::rebuildChain(Chain& chain, int side, Chain::iterator vertex)
+{
+    const bool hasPrevious = vertex != chain.begin();
+    const auto previous = hasPrevious ? std::prev(vertex) : chain.end();
+    const auto next = chain.erase(vertex);
+
+    // Monotone chain over [previous, points in between..., next], the neighbours are never popped
+    stack.clear();
+    if (hasPrevious)
+        stack.push_back(previous->point);
+    auto first = hasPrevious ? points.upper_bound(previous->point) : points.begin();
+    auto last = next != chain.end() ? points.lower_bound(next->point) : points.end();
+    for (auto it = first; it != last; ++it)
+    {
+        while (stack.size() >= 2 && side * orient2d(stack[stack.size() - 2], stack.back(), it->first) <= 0)
+            stack.pop_back();
+        stack.push_back(it->first);
+    }
+    if (next != chain.end())
+    {
+        while (stack.size() >= 2 && side * orient2d(stack[stack.size() - 2], stack.back(), next->point) <= 0)
+            stack.pop_back();
+    }
+
+    for (std::size_t i = hasPrevious ? 1 : 0; i < stack.size(); ++i)
+        chain.insert(next, ChainVertex{stack[i]});
+
+    for (auto it = hasPrevious ? previous : chain.begin(); it != next; ++it)
+        link(chain, it);
+}
+
+void DynamicHull::link(const Chain& chain, Chain::const_iterator vertex)
+{
+    const auto next = std::next(vertex);
+    vertex->hasNext = next != chain.end();
+    if (vertex->hasNext)
+        vertex->next = next->point;
+}
+
+/**
+ * Edges of the chain that are visible from the point (strictly on the outer side), as range of their start vertices
+ * [first, last): last is the end vertex of the last visible edge. The visible edges of the hull are contiguous, and
+ * on each side of the point's position along the chain (by lexicographic order, which behaves like an infinitesimally
+ * sheared x axis, so there are no vertical edges) visibility is monotone. So one visible edge next to the point's
+ * position is enough to find both ends by binary search. first == last if no edge is visible.
+ */
+std::pair<DynamicHull::Chain::const_iterator, DynamicHull::Chain::const_iterator>
+DynamicHull::visibleEdges(const Chain& chain, int side, const ei::Vec2& point)
+{
+    auto visible = [&](const ChainVertex& vertex) {
+        return vertex.hasNext && side * orient2d(vertex.point, vertex.next, point) < 0;
+    };
+    auto leftOfPoint = [&](const ChainVertex& vertex) {
+        return vertex.hasNext && lexicographicLess(vertex.next, point);
+    };
+
+    // Edge ending at or behind the point's position, or the last edge
+    auto middle = chain.lower_bound(ChainSearch<decltype(leftOfPoint)>{leftOfPoint});
+    if (!middle->hasNext)
+    {
+        if (middle == chain.begin())
+            return {chain.end(), chain.end()};
+        --middle;
+    }
+    if (!visible(*middle))
+        return {chain.end(), chain.end()};
+
+    auto beforeFirst = [&](const ChainVertex& vertex) { return leftOfPoint(vertex) && !visible(vertex); };
+    auto beforeLast = [&](const ChainVertex& vertex) { return leftOfPoint(vertex) || visible(vertex); };
+    return {chain.lower_bound(ChainSearch<decltype(beforeFirst)>{beforeFirst}),
+            chain.lower_bound(ChainSearch<decltype(beforeLast)>{beforeLast})};
+}
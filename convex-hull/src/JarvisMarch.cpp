@@ -1,14 +1,23 @@
 #include "JarvisMarch.h"
 
-const float eps = 0.000001;
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include "PointsSoA.h"
+#include "Predicates.h"
+#include "SimdKernels.h"
 
+// Number of points classified per call of the orientation kernel
+constexpr unsigned int ORIENTATION_BLOCK = 1024;
+
+// Exact predicate instead of an epsilon test, collinear means exactly collinear
 short check_orientation(ei::Vec2 a, ei::Vec2 b, ei::Vec2 c)
 {
-    float orientation = (b.y - a.y) * (c.x - b.x) - (b.x - a.x) * (c.y - b.y);
+    const int orientation = orient2d(a, b, c);
 
-    if (orientation <= 0.0f + eps && orientation >= 0.0f - eps)
+    if (orientation == 0)
         return ORIENTATION_COLLINEAR;
-    return (orientation > 0.0f) ? ORIENTATION_CLOCKWISE : ORIENTATION_COUNTERCLOCKWISE;
+    return (orientation < 0) ? ORIENTATION_CLOCKWISE : ORIENTATION_COUNTERCLOCKWISE;
 }
 
 bool on_segment(ei::Vec2 a, ei::Vec2 b, ei::Vec2 c) 
@@ -18,189 +27,79 @@ bool on_segment(ei::Vec2 a, ei::Vec2 b, ei::Vec2 c)
        
 } 
 
-std::vector<ei::Vec2> jarvis_march_performance(INPUT_PARAMETER& points)
+std::size_t jarvis_march_indices(std::span<const float> xs, std::span<const float> ys, std::span<std::uint32_t> out)
 {
-    unsigned int point_count = points.size();
-    
-    if (point_count <= 3)
-        return points;
+    if (xs.size() != ys.size())
+        throw std::invalid_argument("The x and y coordinate arrays differ in size.");
+    if (out.size() < xs.size())
+        throw std::invalid_argument("The index array must have room for one index per point.");
+    if (xs.size() > UINT32_MAX)
+        throw std::invalid_argument("Too many points for 32 bit indices.");
+
+    const unsigned int point_count = static_cast<unsigned int>(xs.size());
+    if (point_count == 0)
+        return 0;
 
-    std::vector<ei::Vec2> hull;
+    auto point = [&](unsigned int index) { return ei::Vec2(xs[index], ys[index]); };
 
     unsigned int left = 0;
     for (unsigned int i = 1; i < point_count; i++)
-        if (points[i].x < points[left].x)
-            left = i;
-        else if (points[i].x == points[left].x && points[i].y < points[left].y)
+        if (xs[i] < xs[left] || (xs[i] == xs[left] && ys[i] < ys[left]))
             left = i;
 
+    // The input is not reordered, so every step scans all points. Points equal to the current one are never
+    // chosen as next and the march ends when it gets back to the coordinates of left (repeated points are
+    // reported with their smallest index)
     unsigned int current = left;
     unsigned int next;
-
-    unsigned int hull_count = 0;
-    unsigned int first_hull = 0;
-    ei::Vec2 help;
+    std::size_t hull_count = 0;
 
     short orientation;
+    std::array<std::int8_t, ORIENTATION_BLOCK> orientations;
 
     do {
-        hull.push_back(points[current]);
-        ++hull_count;
-
-        first_hull = point_count-hull_count+1;
-        next = (current + 1) % (first_hull);
-
-        if (hull_count > 1) {
-            help = points[first_hull];
-            points[first_hull] = points[current];
-            points[current] = help;
-            if (first_hull == left)
-                left = current;
-            current = first_hull;
-        }
+        out[hull_count++] = current;
 
-        for (unsigned int i = 0; i < first_hull; i++)
-        {
-            orientation = check_orientation(points[current], points[i], points[next]);
-            if (orientation == ORIENTATION_CLOCKWISE)
-                next = i;
-            else if (orientation == ORIENTATION_COLLINEAR && on_segment(points[current], points[next], points[i]) && current != i)
+        next = current;
+        for (unsigned int i = 0; i < point_count && next == current; i++)
+            if (!(point(i) == point(current)))
                 next = i;
+        if (next == current)
+            break;
+
+        // The orientations relative to current -> next are computed for a block of points at once (SIMD kernel).
+        // A point right of it stays right when next turns counterclockwise, so only the other points are checked
+        // against the current next (i.e. only a few per block on random data)
+        for (unsigned int block = 0; block < point_count; block += ORIENTATION_BLOCK)
+        {
+            const unsigned int end = std::min(point_count, block + ORIENTATION_BLOCK);
+            orientation_kernel(xs.data() + block, ys.data() + block, end - block, point(current), point(next),
+                               orientations.data());
+            for (unsigned int i = block; i < end; i++)
+            {
+                if (orientations[i - block] < 0 || point(i) == point(current))
+                    continue;
+                orientation = check_orientation(point(current), point(i), point(next));
+                if (orientation == ORIENTATION_CLOCKWISE)
+                    next = i;
+                else if (orientation == ORIENTATION_COLLINEAR && point(i) == point(next))
+                    next = std::min(next, i);
+                else if (orientation == ORIENTATION_COLLINEAR && on_segment(point(current), point(next), point(i)))
+                    next = i;
+            }
         }
 
         current = next;
 
-    } while (current != left);
+    } while (!(point(current) == point(left)) && hull_count < point_count);
 
-    return hull;
+    return hull_count;
 }
 
-AlgorithmGenerator jarvis_march_visualization(INPUT_PARAMETER& points)
+std::vector<ei::Vec2> jarvis_march_performance(const INPUT_PARAMETER& points)
 {
-    auto visual = std::make_shared<Visual>();
-    unsigned int point_count = points.size();
-
-    if (point_count < 3)
-    {
-        visual->setExplanation("Point cloud has less than 3 points. Convex hull is the point cloud itself.");
-        for (const auto& point : points)
-        {
-            visual->addHullPoint(sf::Vector2f(point.x, point.y), sf::Color::Green);
-            visual->addHighlight(sf::Vector2f(point.x, point.y), "P", sf::Color::Blue);
-            co_yield visual;
-        }
-        co_return;
-    }
-
-    // Find the leftmost point
-    visual->setExplanation("Finding the leftmost point.");
-    unsigned int leftmost = 0;
-    visual->addHighlight(sf::Vector2f(points[leftmost].x, points[leftmost].y), "Initial Point", sf::Color::Red);
-    co_yield visual;
-
-    for (unsigned int i = 1; i < point_count; i++)
-    {
-        if (points[i].x < points[leftmost].x)
-        {
-            // Remove previous highlight
-            visual->removeHighlight(sf::Vector2f(points[leftmost].x, points[leftmost].y));
-
-            leftmost = i;
-            visual->addHighlight(sf::Vector2f(points[leftmost].x, points[leftmost].y), "New Leftmost Point", sf::Color::Red);
-            co_yield visual;
-        }
-    }
-    visual->clearHighlights();
-    visual->setExplanation("Found leftmost as starting point for algorithm.");
-    visual->addHighlight(sf::Vector2f(points[leftmost].x, points[leftmost].y), "The Leftmost Point", sf::Color::Magenta);
-    co_yield visual;
-    visual->clearHighlights();
-
-    std::vector<ei::Vec2> convexHull;
-    unsigned int p = leftmost, q;
-
-    do
-    {
-        // Highlight current point p
-        visual->addHighlight(sf::Vector2f(points[p].x, points[p].y), "Hull Point P", sf::Color::Red);
-        visual->setExplanation("Hull point P selected.");
-        convexHull.push_back(points[p]);
-        // Visualize current convex hull
-        visual->clearHullPoints();
-        for (const auto& point : convexHull)
-        {
-            visual->addHullPoint(sf::Vector2f(point.x, point.y));
-        }
-        co_yield visual;
-
-        q = (p + 1) % point_count;
-
-        // Highlight candidate point q
-        visual->addHighlight(sf::Vector2f(points[q].x, points[q].y), "Candidate Q", sf::Color::Yellow);
-        visual->setExplanation("Selected candidate point Q.");
-        co_yield visual;
-
-        for (unsigned int i = 0; i < point_count; i++)
-        {
-            if (i == p || i == q)
-                continue;
-
-            // Clear indicator lines
-            visual->clearIndicatorLines();
-
-            // Draw indicator lines between p-q and p-i
-            visual->addIndicatorLine(sf::Vector2f(points[p].x, points[p].y), sf::Vector2f(points[q].x, points[q].y), sf::Color::Blue);
-            visual->addIndicatorLine(sf::Vector2f(points[p].x, points[p].y), sf::Vector2f(points[i].x, points[i].y), sf::Color::Green);
-
-            // Highlight point i being considered
-            visual->addHighlight(sf::Vector2f(points[i].x, points[i].y), "Probe I", sf::Color::Cyan);
-            visual->setExplanation("Checking orientation between P, I, and Q.");
-            co_yield visual;
-            visual->removeHighlight(sf::Vector2f(points[i].x, points[i].y));
-
-            int orientation = check_orientation(points[p], points[i], points[q]);
-
-            if (orientation == ORIENTATION_COUNTERCLOCKWISE)
-            {
-                // Remove previous highlight for q
-                visual->removeHighlight(sf::Vector2f(points[q].x, points[q].y));
-
-                // Update q
-                q = i;
-
-                // Highlight new candidate q
-                visual->addHighlight(sf::Vector2f(points[q].x, points[q].y), "New Candidate Q", sf::Color::Yellow);
-                visual->setExplanation("Found more counterclockwise point. Updating Q.");
-                co_yield visual;
-            }
-        }
-
-        // Clear after comparisons
-        visual->clearIndicatorLines();
-        visual->clearHighlights();
-
-        // Move to next point
-        p = q;
-        visual->addHighlight(sf::Vector2f(points[p].x, points[p].y), "Next Point P", sf::Color::Magenta);
-        // Optional: Yield to show movement to next point
-        visual->setExplanation("P is on Hull. Selected as next point P.");
-        co_yield visual;
-        visual->removeHighlight(sf::Vector2f(points[p].x, points[p].y));
-    } while (p != leftmost); // While we don't come back to the first point
-
-    // Final convex hull visualization
-    visual->clearHighlights();
-    visual->clearIndicatorLines();
-    visual->clearHullPoints();
-    for (const auto& point : convexHull)
-    {
-        visual->addHullPoint(sf::Vector2f(point.x, point.y));
-    }
-    // Close the loop by adding the first point at the end
-    visual->addHullPoint(sf::Vector2f(convexHull.front().x, convexHull.front().y));
-    visual->setExplanation("Convex hull construction complete.");
-    visual->finished = true;
-    co_yield visual;
-
-    co_return;
+    const PointsSoA soa(points);
+    std::vector<std::uint32_t> indices(points.size());
+    const std::size_t count = jarvis_march_indices({soa.x(), soa.size()}, {soa.y(), soa.size()}, indices);
+    return soa.gather({indices.data(), count});
 }
@@ -0,0 +1,42 @@
+﻿#include "MonotoneChain.h"
+#include "Predicates.h"
+#include "RadixSort.h"
+
+#include <algorithm>
+
+std::vector<ei::Vec2> monotone_chain_performance(const INPUT_PARAMETER& points)
+{
+    std::vector<ei::Vec2> sorted(points);
+    if (sorted.size() < 3)
+    {
+        return sorted;
+    }
+
+    radix_sort_points(sorted);
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    if (sorted.size() < 3)
+    {
+        return sorted;
+    }
+
+    std::vector<ei::Vec2> hull;
+    hull.reserve(sorted.size() + 1);
+
+    // Lower hull from left to right, only counterclockwise turns remain
+    for (const auto& point : sorted) {
+        while (hull.size() >= 2 && orient2d(hull[hull.size() - 2], hull.back(), point) <= 0)
+            hull.pop_back();
+        hull.push_back(point);
+    }
+
+    // Upper hull from right to left, the lower hull is never popped
+    const size_t lowerSize = hull.size() + 1;
+    for (auto it = sorted.rbegin() + 1; it != sorted.rend(); ++it) {
+        while (hull.size() >= lowerSize && orient2d(hull[hull.size() - 2], hull.back(), *it) <= 0)
+            hull.pop_back();
+        hull.push_back(*it);
+    }
+
+    hull.pop_back(); // Leftmost point was added twice
+    return hull;
+}
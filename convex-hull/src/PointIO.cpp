@@ -0,0 +1,511 @@
+﻿#include "PointIO.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <omp.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr std::size_t MIN_CHUNK_BYTES = 1 << 16;     ///< Smaller text files are parsed by one thread
+constexpr std::size_t COPY_BLOCK_POINTS = 1 << 16;   ///< Points copied per block when loading binary files
+constexpr std::size_t MIN_LINE_BYTES = 4;            ///< Shortest possible point line: "0 0\n"
+
+// Read-only memory mapping of a whole file, an empty file is not mapped (data() == nullptr)
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+private:
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    HANDLE mapping = nullptr;
+#endif
+};
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& filename)
+{
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Error opening file: " + filename);
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Error reading from file: " + filename);
+    }
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    if (length > 0)
+    {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+            bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+    CloseHandle(file);
+    if (length > 0 && bytes == nullptr)
+    {
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+        throw std::runtime_error("Error mapping file: " + filename);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (bytes != nullptr)
+        UnmapViewOfFile(bytes);
+    if (mapping != nullptr)
+        CloseHandle(mapping);
+}
+#else
+MappedFile::MappedFile(const std::string& filename)
+{
+    const int file = open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+        throw std::runtime_error("Error opening file: " + filename);
+    struct stat status{};
+    if (fstat(file, &status) != 0)
+    {
+        close(file);
+        throw std::runtime_error("Error reading from file: " + filename);
+    }
+    length = static_cast<std::size_t>(status.st_size);
+    if (length > 0)
+    {
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapped != MAP_FAILED)
+        {
+            // All threads start reading at once, so fault the pages in ahead of them
+            madvise(mapped, length, MADV_WILLNEED);
+            bytes = static_cast<const char*>(mapped);
+        }
+    }
+    close(file);
+    if (length > 0 && bytes == nullptr)
+        throw std::runtime_error("Error mapping file: " + filename);
+}
+
+MappedFile::~MappedFile()
+{
+    if (bytes != nullptr)
+        munmap(const_cast<char*>(bytes), length);
+}
+#endif
+
+// Reads a little-endian unsigned integer, float or double from unaligned memory
+template<typename T>
+static inline T loadLittle(const char* source)
+{
+    using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    Bits bits;
+    std::memcpy(&bits, source, sizeof(bits));
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        Bits swapped = 0;
+        for (std::size_t i = 0; i < sizeof(bits); ++i, bits >>= 8)
+            swapped = (swapped << 8) | (bits & 0xFF);
+        bits = swapped;
+    }
+    return std::bit_cast<T>(bits);
+}
+
+// Writes an unsigned integer, float or double as little-endian bytes
+template<typename T>
+static inline void storeLittle(char* target, T value)
+{
+    using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    Bits bits = std::bit_cast<Bits>(value);
+    for (std::size_t i = 0; i < sizeof(bits); ++i, bits >>= 8)
+        target[i] = static_cast<char>(bits & 0xFF);
+}
+
+// Validates the header of a binary point file, returns the coordinate size and stores the number of points in count
+static std::uint32_t parseBinaryHeader(const char* header, std::uint64_t& count, const std::string& filename)
+{
+    const std::uint32_t scalarBytes = loadLittle<std::uint32_t>(header + 4);
+    count = loadLittle<std::uint64_t>(header + 8);
+    if (scalarBytes != 4 && scalarBytes != 8)
+        throw std::runtime_error("Unsupported coordinate size " + std::to_string(scalarBytes) +
+                                 " bytes in binary point file: " + filename);
+    return scalarBytes;
+}
+
+// Converts count binary coordinate pairs at source into points (in parallel blocks)
+static void convertBinary(const char* source, std::size_t count, std::uint32_t scalarBytes, ei::Vec2* points)
+{
+    const std::int64_t blocks = static_cast<std::int64_t>((count + COPY_BLOCK_POINTS - 1) / COPY_BLOCK_POINTS);
+
+    #pragma omp parallel for default(none) shared(points, source, scalarBytes, count, blocks)
+    for (std::int64_t block = 0; block < blocks; ++block)
+    {
+        const std::size_t first = block * COPY_BLOCK_POINTS;
+        const std::size_t last = std::min<std::size_t>(count, first + COPY_BLOCK_POINTS);
+        if (scalarBytes == 4)
+        {
+            // float32 pairs on a little-endian host already have the memory layout of the points
+            if constexpr (std::endian::native == std::endian::little && std::is_trivially_copyable_v<ei::Vec2> &&
+                          sizeof(ei::Vec2) == 2 * sizeof(float))
+            {
+                std::memcpy(points + first, source + first * sizeof(ei::Vec2), (last - first) * sizeof(ei::Vec2));
+                continue;
+            }
+            for (std::size_t i = first; i < last; ++i)
+                points[i] = ei::Vec2(loadLittle<float>(source + 8 * i), loadLittle<float>(source + 8 * i + 4));
+        }
+        else
+        {
+            for (std::size_t i = first; i < last; ++i)
+                points[i] = ei::Vec2(static_cast<float>(loadLittle<double>(source + 16 * i)),
+                                     static_cast<float>(loadLittle<double>(source + 16 * i + 8)));
+        }
+    }
+}
+
+static std::vector<ei::Vec2> loadBinary(const MappedFile& file, const std::string& filename)
+{
+    if (file.size() < POINT_FILE_HEADER_SIZE)
+        throw std::runtime_error("Error reading header of binary point file: " + filename);
+
+    std::uint64_t count = 0;
+    const std::uint32_t scalarBytes = parseBinaryHeader(file.data(), count, filename);
+    if (count > (file.size() - POINT_FILE_HEADER_SIZE) / (2 * scalarBytes))
+        throw std::runtime_error("Error reading point data from file (truncated): " + filename);
+
+    std::vector<ei::Vec2> points(count);
+    convertBinary(file.data() + POINT_FILE_HEADER_SIZE, count, scalarBytes, points.data());
+    return points;
+}
+
+// Skips the white space within a line (like operator>> does, but without crossing the line end)
+static inline const char* skipBlanks(const char* position, const char* end)
+{
+    while (position < end && (*position == ' ' || *position == '\t' || *position == '\r' ||
+                              *position == '\v' || *position == '\f'))
+        ++position;
+    return position;
+}
+
+// Parses one coordinate, returns the position behind it or nullptr if there is none
+static inline const char* parseCoordinate(const char* position, const char* end, float& value)
+{
+    position = skipBlanks(position, end);
+    // from_chars does not accept an explicit plus sign, operator>> does
+    if (position < end && *position == '+')
+        ++position;
+    const auto [next, error] = std::from_chars(position, end, value);
+    return error == std::errc() ? next : nullptr;
+}
+
+// Position behind the next line end (or end)
+static inline const char* nextLine(const char* position, const char* end)
+{
+    const void* lineEnd = std::memchr(position, '\n', end - position);
+    return lineEnd == nullptr ? end : static_cast<const char*>(lineEnd) + 1;
+}
+
+// Parses the "count" line of the text format, returns the position behind it
+static const char* parseTextHeader(const char* begin, const char* end, std::uint64_t& count, const std::string& filename)
+{
+    const char* position = skipBlanks(begin, end);
+    if (position < end && *position == '+')
+        ++position;
+    long long value = 0;
+    const auto [afterCount, countError] = std::from_chars(position, end, value);
+    if (countError != std::errc() || value < 0)
+        throw std::runtime_error("Error parsing number of points in file: " + filename);
+    count = static_cast<std::uint64_t>(value);
+    return nextLine(afterCount, end);
+}
+
+/**
+ * Parses the "x y" lines of [body, end) in parallel: the range is split into one chunk per thread at line ends.
+ * A first pass counts the lines of every chunk, the prefix sum of these counts is the index of the first point of
+ * each chunk, so the second pass parses every chunk independently into the final vector.
+ * At most maxPoints lines are parsed, points is resized to the number of parsed points. firstIndex is the index of
+ * the first point in the file (for the line number of an error).
+ */
+static void parseTextLines(const char* body, const char* end, std::uint64_t maxPoints, std::uint64_t firstIndex,
+                           std::vector<ei::Vec2>& points)
+{
+    const std::size_t bodySize = end - body;
+
+    // Chunk boundaries at line starts
+    const std::size_t threads = static_cast<std::size_t>(omp_get_max_threads());
+    const std::size_t chunkCount = std::max<std::size_t>(1, std::min(threads, bodySize / MIN_CHUNK_BYTES));
+    std::vector<const char*> bounds(chunkCount + 1, end);
+    bounds[0] = body;
+    for (std::size_t chunk = 1; chunk < chunkCount; ++chunk)
+    {
+        const char* split = std::max(bounds[chunk - 1], body + chunk * (bodySize / chunkCount));
+        bounds[chunk] = split == body ? body : nextLine(split - 1, end);
+    }
+
+    std::vector<long long> firstLine(chunkCount + 1, 0);
+    const std::int64_t chunks = static_cast<std::int64_t>(chunkCount);
+    #pragma omp parallel for default(none) shared(bounds, firstLine, chunks, end)
+    for (std::int64_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        const char* first = bounds[chunk];
+        const char* last = bounds[chunk + 1];
+        long long lines = std::count(first, last, '\n');
+        if (last == end && first < last && last[-1] != '\n')
+            ++lines; // Last line without line end
+        firstLine[chunk + 1] = lines;
+    }
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+        firstLine[chunk + 1] += firstLine[chunk];
+
+    const long long count = static_cast<long long>(std::min<std::uint64_t>(maxPoints, firstLine[chunkCount]));
+    points.resize(count);
+    std::vector<long long> errorLine(chunkCount, count);
+    #pragma omp parallel for default(none) shared(bounds, firstLine, errorLine, points, chunks, count)
+    for (std::int64_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        const char* line = bounds[chunk];
+        const char* last = bounds[chunk + 1];
+        for (long long index = firstLine[chunk]; index < count && line < last; ++index)
+        {
+            float x, y;
+            const char* next = parseCoordinate(line, last, x);
+            if (next != nullptr)
+                next = parseCoordinate(next, last, y);
+            if (next == nullptr)
+            {
+                errorLine[chunk] = index;
+                break;
+            }
+            points[index] = ei::Vec2(x, y);
+            line = nextLine(next, last);
+        }
+    }
+
+    const long long firstError = *std::min_element(errorLine.begin(), errorLine.end());
+    if (firstError < count)
+        throw std::runtime_error("Error parsing point data on line " + std::to_string(firstIndex + firstError + 2));
+}
+
+static std::vector<ei::Vec2> loadText(const MappedFile& file, const std::string& filename)
+{
+    const char* end = file.data() + file.size();
+    std::uint64_t count = 0;
+    const char* body = parseTextHeader(file.data(), end, count, filename);
+    if (count > static_cast<std::uint64_t>(end - body) / MIN_LINE_BYTES + 1)
+        throw std::runtime_error("Error reading point data from file: " + filename);
+
+    std::vector<ei::Vec2> points;
+    parseTextLines(body, end, count, 0, points);
+    if (points.size() < count)
+        throw std::runtime_error("Error reading point data from file: " + filename);
+    return points;
+}
+
+std::vector<ei::Vec2> load_points(const std::string& filename, PointFileFormat* format)
+{
+    const MappedFile file(filename);
+    if (file.size() == 0)
+        throw std::runtime_error("Error reading from file: " + filename);
+
+    const bool binary = file.size() >= sizeof(POINT_FILE_MAGIC) &&
+                        std::memcmp(file.data(), POINT_FILE_MAGIC, sizeof(POINT_FILE_MAGIC)) == 0;
+    if (file.size() >= sizeof(POINT_FILE_3D_MAGIC) &&
+        std::memcmp(file.data(), POINT_FILE_3D_MAGIC, sizeof(POINT_FILE_3D_MAGIC)) == 0)
+        throw std::runtime_error("File contains 3D points (use --3d): " + filename);
+    if (format != nullptr)
+        *format = binary ? BINARY_FORMAT : TEXT_FORMAT;
+    return binary ? loadBinary(file, filename) : loadText(file, filename);
+}
+
+void save_points_binary(const std::string& filename, const std::vector<ei::Vec2>& points)
+{
+    std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+        throw std::runtime_error("Error opening file for writing: " + filename);
+
+    char header[POINT_FILE_HEADER_SIZE];
+    std::memcpy(header, POINT_FILE_MAGIC, sizeof(POINT_FILE_MAGIC));
+    storeLittle(header + 4, std::uint32_t{4});
+    storeLittle(header + 8, std::uint64_t{points.size()});
+    output.write(header, sizeof(header));
+
+    std::vector<char> buffer(COPY_BLOCK_POINTS * 8);
+    for (std::size_t first = 0; first < points.size(); first += COPY_BLOCK_POINTS)
+    {
+        const std::size_t last = std::min(points.size(), first + COPY_BLOCK_POINTS);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            storeLittle(buffer.data() + 8 * (i - first), points[i].x);
+            storeLittle(buffer.data() + 8 * (i - first) + 4, points[i].y);
+        }
+        output.write(buffer.data(), static_cast<std::streamsize>(8 * (last - first)));
+    }
+    if (!output)
+        throw std::runtime_error("Error writing to file: " + filename);
+}
+
+std::vector<ei::Vec3> load_points_3d(const std::string& filename)
+{
+    const MappedFile file(filename);
+    if (file.size() < POINT_FILE_HEADER_SIZE ||
+        std::memcmp(file.data(), POINT_FILE_3D_MAGIC, sizeof(POINT_FILE_3D_MAGIC)) != 0)
+        throw std::runtime_error("Error reading header of binary 3D point file: " + filename);
+
+    std::uint64_t count = 0;
+    const std::uint32_t scalarBytes = parseBinaryHeader(file.data(), count, filename);
+    if (count > (file.size() - POINT_FILE_HEADER_SIZE) / (3 * scalarBytes))
+        throw std::runtime_error("Error reading point data from file (truncated): " + filename);
+
+    const char* source = file.data() + POINT_FILE_HEADER_SIZE;
+    std::vector<ei::Vec3> points(count);
+    const std::int64_t size = static_cast<std::int64_t>(count);
+    #pragma omp parallel for default(none) shared(points, source, scalarBytes, size) schedule(static)
+    for (std::int64_t i = 0; i < size; ++i)
+    {
+        if (scalarBytes == 4)
+            points[i] = ei::Vec3(loadLittle<float>(source + 12 * i), loadLittle<float>(source + 12 * i + 4),
+                                 loadLittle<float>(source + 12 * i + 8));
+        else
+            points[i] = ei::Vec3(static_cast<float>(loadLittle<double>(source + 24 * i)),
+                                 static_cast<float>(loadLittle<double>(source + 24 * i + 8)),
+                                 static_cast<float>(loadLittle<double>(source + 24 * i + 16)));
+    }
+    return points;
+}
+
+void save_points_3d_binary(const std::string& filename, const std::vector<ei::Vec3>& points)
+{
+    std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+        throw std::runtime_error("Error opening file for writing: " + filename);
+
+    char header[POINT_FILE_HEADER_SIZE];
+    std::memcpy(header, POINT_FILE_3D_MAGIC, sizeof(POINT_FILE_3D_MAGIC));
+    storeLittle(header + 4, std::uint32_t{4});
+    storeLittle(header + 8, std::uint64_t{points.size()});
+    output.write(header, sizeof(header));
+
+    std::vector<char> buffer(COPY_BLOCK_POINTS * 12);
+    for (std::size_t first = 0; first < points.size(); first += COPY_BLOCK_POINTS)
+    {
+        const std::size_t last = std::min(points.size(), first + COPY_BLOCK_POINTS);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            storeLittle(buffer.data() + 12 * (i - first), points[i].x);
+            storeLittle(buffer.data() + 12 * (i - first) + 4, points[i].y);
+            storeLittle(buffer.data() + 12 * (i - first) + 8, points[i].z);
+        }
+        output.write(buffer.data(), static_cast<std::streamsize>(12 * (last - first)));
+    }
+    if (!output)
+        throw std::runtime_error("Error writing to file: " + filename);
+}
+
+PointFileReader::PointFileReader(const std::string& filename, std::size_t chunkBytes)
+    : input(filename, std::ios::binary), filename(filename), buffer(chunkBytes)
+{
+    if (chunkBytes < MIN_STREAM_CHUNK_BYTES)
+        throw std::invalid_argument("The chunk size must be at least " + std::to_string(MIN_STREAM_CHUNK_BYTES) +
+                                    " bytes.");
+    if (!input.is_open())
+        throw std::runtime_error("Error opening file: " + filename);
+
+    fill();
+    if (filled == 0)
+        throw std::runtime_error("Error reading from file: " + filename);
+    if (filled >= sizeof(POINT_FILE_MAGIC) && std::memcmp(buffer.data(), POINT_FILE_MAGIC, sizeof(POINT_FILE_MAGIC)) == 0)
+    {
+        if (filled < POINT_FILE_HEADER_SIZE)
+            throw std::runtime_error("Error reading header of binary point file: " + filename);
+        fileFormat = BINARY_FORMAT;
+        scalarBytes = parseBinaryHeader(buffer.data(), pointCount, filename);
+        consumed = POINT_FILE_HEADER_SIZE;
+    }
+    else
+    {
+        const char* end = buffer.data() + filled;
+        const char* body = parseTextHeader(buffer.data(), end, pointCount, filename);
+        if (body == end && !endOfFile)
+            throw std::runtime_error("Error parsing number of points in file (line too long): " + filename);
+        consumed = body - buffer.data();
+    }
+}
+
+void PointFileReader::fill()
+{
+    // Keep the unconsumed bytes (a partial line or point) at the front of the buffer
+    std::memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+    filled -= consumed;
+    consumed = 0;
+    input.read(buffer.data() + filled, static_cast<std::streamsize>(buffer.size() - filled));
+    const std::size_t bytes = static_cast<std::size_t>(input.gcount());
+    filled += bytes;
+    fileBytes += bytes;
+    endOfFile = filled < buffer.size();
+    if (input.bad())
+        throw std::runtime_error("Error reading from file: " + filename);
+}
+
+bool PointFileReader::next(std::vector<ei::Vec2>& points)
+{
+    points.clear();
+    if (readPoints == pointCount)
+        return false;
+    if (consumed > 0 || filled == 0)
+        fill();
+
+    const std::uint64_t remaining = pointCount - readPoints;
+    if (fileFormat == BINARY_FORMAT)
+    {
+        const std::size_t pointBytes = 2 * scalarBytes;
+        const std::size_t count = std::min<std::uint64_t>(remaining, filled / pointBytes);
+        if (count == 0)
+            throw std::runtime_error("Error reading point data from file (truncated): " + filename);
+        points.resize(count);
+        convertBinary(buffer.data(), count, scalarBytes, points.data());
+        consumed = count * pointBytes;
+    }
+    else
+    {
+        // Only complete lines are parsed, the rest is kept for the next chunk
+        const char* begin = buffer.data();
+        const char* end = begin + filled;
+        if (!endOfFile)
+        {
+            const char* lastLine = begin + filled;
+            while (lastLine > begin && lastLine[-1] != '\n')
+                --lastLine;
+            if (lastLine == begin)
+                throw std::runtime_error("Error parsing point data on line " + std::to_string(readPoints + 2) +
+                                         " (line too long)");
+            end = lastLine;
+        }
+        parseTextLines(begin, end, remaining, readPoints, points);
+        if (points.empty())
+            throw std::runtime_error("Error reading point data from file: " + filename);
+        consumed = end - begin;
+    }
+    readPoints += points.size();
+    return true;
+}
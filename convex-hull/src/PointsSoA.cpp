@@ -0,0 +1,45 @@
+﻿#include "PointsSoA.h"
+
+#include <utility>
+
+PointsSoA::PointsSoA(const std::vector<ei::Vec2>& points) : xs(points.size()), ys(points.size())
+{
+    const std::ptrdiff_t count = static_cast<std::ptrdiff_t>(points.size());
+    #pragma omp parallel for simd schedule(static)
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+    }
+}
+
+void PointsSoA::swap(std::size_t first, std::size_t second)
+{
+    std::swap(xs[first], xs[second]);
+    std::swap(ys[first], ys[second]);
+}
+
+void PointsSoA::resize(std::size_t count)
+{
+    xs.resize(count);
+    ys.resize(count);
+}
+
+std::vector<ei::Vec2> PointsSoA::toPoints() const
+{
+    std::vector<ei::Vec2> points(size());
+    const std::ptrdiff_t count = static_cast<std::ptrdiff_t>(size());
+    #pragma omp parallel for simd schedule(static)
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+        points[i] = ei::Vec2(xs[i], ys[i]);
+    }
+    return points;
+}
+
+std::vector<ei::Vec2> PointsSoA::gather(std::span<const std::uint32_t> indices) const
+{
+    std::vector<ei::Vec2> points;
+    points.reserve(indices.size());
+    for (std::uint32_t index : indices)
+        points.push_back((*this)[index]);
+    return points;
+}
@@ -0,0 +1,124 @@
+﻿#include "Predicates.h"
+
+#include <array>
+#include <cmath>
+
+// a + b = sum + error exactly (Knuth's TwoSum, sum is the rounded result)
+static inline void twoSum(double a, double b, double& sum, double& error)
+{
+    sum = a + b;
+    const double bVirtual = sum - a;
+    const double aVirtual = sum - bVirtual;
+    error = (a - aVirtual) + (b - bVirtual);
+}
+
+/**
+ * Adds value to the expansion (non-overlapping components, increasing magnitude) in place, components that
+ * become 0 are dropped (Shewchuk's GROW-EXPANSION with zero elimination).
+ * @return New number of components (at most length + 1).
+ */
+static size_t growExpansion(double* expansion, size_t length, double value)
+{
+    size_t count = 0;
+    double carry = value;
+    for (size_t i = 0; i < length; ++i) {
+        double sum, error;
+        twoSum(carry, expansion[i], sum, error);
+        carry = sum;
+        if (error != 0.0)
+            expansion[count++] = error;
+    }
+    if (carry != 0.0 || count == 0)
+        expansion[count++] = carry;
+    return count;
+}
+
+// a - b = difference + error exactly (TwoDiff)
+static inline void twoDiff(double a, double b, double& difference, double& error)
+{
+    difference = a - b;
+    const double bVirtual = a - difference;
+    const double aVirtual = difference + bVirtual;
+    error = (a - aVirtual) + (bVirtual - b);
+}
+
+// a * b = product + error exactly (error from the fused multiply-add)
+static inline void twoProduct(double a, double b, double& product, double& error)
+{
+    product = a * b;
+    error = std::fma(a, b, -product);
+}
+
+static inline int sign(double value)
+{
+    return (value > 0.0) - (value < 0.0);
+}
+
+int orient2d_exact(const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c)
+{
+    const double ax = a.x, ay = a.y, bx = b.x, by = b.y, cx = c.x, cy = c.y;
+
+    // The differences of nearby points are exact (Sterbenz), then the determinant is the difference of two products
+    // (Shewchuk's second stage). If both products are exact as well (e.g. points on a grid), it is a comparison.
+    double acx, acy, bcx, bcy, acxError, acyError, bcxError, bcyError;
+    twoDiff(ax, cx, acx, acxError);
+    twoDiff(ay, cy, acy, acyError);
+    twoDiff(bx, cx, bcx, bcxError);
+    twoDiff(by, cy, bcy, bcyError);
+    if (acxError == 0.0 && acyError == 0.0 && bcxError == 0.0 && bcyError == 0.0) {
+        double left, leftError, right, rightError;
+        twoProduct(acx, bcy, left, leftError);
+        twoProduct(acy, bcx, right, rightError);
+        if (leftError == 0.0 && rightError == 0.0)
+            return (left > right) - (left < right);
+
+        std::array<double, 4> expansion{};
+        size_t length = 0;
+        for (double term : {leftError, -rightError, left, -right})
+            length = growExpansion(expansion.data(), length, term);
+        return sign(expansion[length - 1]);
+    }
+
+    // (a - c) x (b - c) expanded into 6 products. The product of two floats has at most 48 significant bits,
+    // so every term is exact in double precision and only the sum needs expansion arithmetic
+    const std::array<double, 6> terms = {ax * by, -(ax * cy), -(cx * by), -(ay * bx), ay * cx, cy * bx};
+
+    std::array<double, terms.size()> expansion{};
+    size_t length = 0;
+    for (double term : terms)
+        length = growExpansion(expansion.data(), length, term);
+
+    // The largest component determines the sign of the expansion
+    return sign(expansion[length - 1]);
+}
+
+int orient2d_uncertain(ei::Vec2 a, ei::Vec2 b, ei::Vec2 c)
+{
+    return orient2d(a, b, c);
+}
+
+int orient3d_exact(const ei::Vec3& a, const ei::Vec3& b, const ei::Vec3& c, const ei::Vec3& d)
+{
+    // det(a - d, b - d, c - d) = det(a, b, c) - det(d, b, c) - det(a, d, c) - det(a, b, d): 24 products of three
+    // coordinates. The product of the first two is exact in double precision, the third factor adds an error term
+    const std::array<const ei::Vec3*, 3> rows[4] = {{&a, &b, &c}, {&d, &b, &c}, {&a, &d, &c}, {&a, &b, &d}};
+    constexpr double SIGNS[4] = {1.0, -1.0, -1.0, -1.0};
+
+    std::array<double, 48> expansion{};
+    size_t length = 0;
+    for (int matrix = 0; matrix < 4; ++matrix) {
+        const ei::Vec3& p = *rows[matrix][0];
+        const ei::Vec3& q = *rows[matrix][1];
+        const ei::Vec3& r = *rows[matrix][2];
+        const double terms[6][3] = {{p.x, q.y, r.z}, {q.x, r.y, p.z}, {r.x, p.y, q.z},
+                                    {-p.x, r.y, q.z}, {-q.x, p.y, r.z}, {-r.x, q.y, p.z}};
+        for (const auto& term : terms) {
+            double product, error;
+            twoProduct(SIGNS[matrix] * term[0] * term[1], term[2], product, error);
+            length = growExpansion(expansion.data(), length, product);
+            length = growExpansion(expansion.data(), length, error);
+        }
+    }
+
+    return sign(expansion[length - 1]);
+}
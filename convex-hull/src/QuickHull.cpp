@@ -1,18 +1,18 @@
 ﻿#include <memory>
 
 #include "QuickHull.h"
+#include "PointsSoA.h"
+#include "Predicates.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <numeric>
 #include <stack>
+#include <stdexcept>
 
 
 
-inline int pointLocation(const ei::Vec2& A, const ei::Vec2& B, const ei::Vec2& P) {
-    float cp1 = (B.x - A.x)*(P.y - A.y) - (B.y - A.y)*(P.x - A.x);
-    if (cp1 > 0.0f)
-        return 1;
-    else if (cp1 == 0.0f)
-        return 0;
-    else
-        return -1;
+int pointLocation(const ei::Vec2& A, const ei::Vec2& B, const ei::Vec2& P) {
+    return orient2d(A, B, P);
 }
 
 float distanceSquaredFromLine(const ei::Vec2& A, const ei::Vec2& B, const ei::Vec2& P) {
@@ -27,295 +27,603 @@ float distanceFromLine(const ei::Vec2& A, const ei::Vec2& B, const ei::Vec2& P)
     return num / den;
 }
 
-void findHull(std::vector<ei::Vec2>& hull, const std::vector<ei::Vec2>& set,
-                  const ei::Vec2& P, const ei::Vec2& Q) {
-    if (set.empty())
-        return;
+constexpr size_t TASK_CUTOFF = 1 << 12;        ///< Smaller sub-problems are solved sequentially by one task
+constexpr size_t PARTITION_CUTOFF = 1 << 17;   ///< Larger sub-problems are scanned and partitioned in parallel
+constexpr size_t CHUNK_SIZE = 1 << 15;         ///< Points per chunk in parallel scans
+constexpr size_t PARTITION_BLOCK = 64;         ///< Points classified at once by partitionLeftOf
 
-    // Find point C with maximum distance from line PQ
-    float maxDistance = -1.0f;
-    ei::Vec2 C;
-    for (const auto& point : set) {
-        float distance = distanceSquaredFromLine(P, Q, point);
-        if (distance > maxDistance) {
-            maxDistance = distance;
-            C = point;
-        }
-    }
+// Twice the signed area of triangle ABP (proportional to the distance of P from line AB).
+// In double only the final subtraction rounds, so the farthest point stays a hull corner for nearly collinear points
+static inline double crossProduct(const ei::Vec2& A, const ei::Vec2& B, const ei::Vec2& P) {
+    return (double(B.x) - A.x)*(double(P.y) - A.y) - (double(B.y) - A.y)*(double(P.x) - A.x);
+}
 
-    auto it = std::find(hull.begin(), hull.end(), Q);
-    hull.insert(it, C);
+static inline bool lexicographicLess(const ei::Vec2& a, const ei::Vec2& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
 
-    std::vector<ei::Vec2> leftSetPC;
-    std::vector<ei::Vec2> leftSetCQ;
+// Bounding box of the points of a (sub-)problem, gives the error bound of the orientation tests among them
+struct BoundingBox {
+    ei::Vec2 min, max;
 
-    for (const auto& point : set) {
-        if (point == C)
-            continue;
+    explicit BoundingBox(const ei::Vec2& point) : min(point), max(point) {}
 
-        if (pointLocation(P, C, point) == 1)
-            leftSetPC.push_back(point);
-        else if (pointLocation(C, Q, point) == 1)
-            leftSetCQ.push_back(point);
+    void extend(const ei::Vec2& point) {
+        min = ei::Vec2(std::min(min.x, point.x), std::min(min.y, point.y));
+        max = ei::Vec2(std::max(max.x, point.x), std::max(max.y, point.y));
     }
 
-    findHull(hull, leftSetPC, P, C);
-    findHull(hull, leftSetCQ, C, Q);
+    void extend(const BoundingBox& box) {
+        extend(box.min);
+        extend(box.max);
+    }
+
+    // Error bound of orient2d for any three points inside the box (semi-static filter, see orient2dStaticBound)
+    [[nodiscard]] float orientationBound() const {
+        return orient2dStaticBound(static_cast<double>(max.x) - min.x, static_cast<double>(max.y) - min.y);
+    }
+};
+
+// Point of an element of a partitioned range of points (for ranges of indices, see quick_hull_indices)
+constexpr auto samePoint = [](const ei::Vec2& point) { return point; };
+
+// Lexicographic min/max and bounding box of a (non-empty) range of points, found in a single pass
+struct Extremes {
+    ei::Vec2 min, max;
+    BoundingBox box;
+
+    Extremes(const ei::Vec2* first, const ei::Vec2* last) : min(*first), max(*first), box(*first) {
+        for (const ei::Vec2* it = first + 1; it != last; ++it) {
+            if (lexicographicLess(*it, min))
+                min = *it;
+            if (lexicographicLess(max, *it))
+                max = *it;
+            box.extend(*it);
+        }
+    }
+};
+
+/**
+ * Sides of count points relative to AB: left[i] = orient2d(A, B, pointOf(points[i])) > 0, bound is the orientation
+ * bound of the points (BoundingBox). The float filter is evaluated for all points without a branch on its result.
+ * Only if one of them is within the bound (rare, nearly collinear points), they are classified again the same way
+ * in double and only if that fails as well (e.g. points on a line) by orient2d.
+ */
+template<typename T, typename PointOf>
+static void classifyLeftOf(const T* points, size_t count, const ei::Vec2& A, const ei::Vec2& B, float bound,
+                           PointOf pointOf, std::uint8_t* left) {
+    bool uncertain = false;
+    for (size_t i = 0; i < count; ++i) {
+        const float determinant = orient2dFloat(A, B, pointOf(points[i]));
+        left[i] = determinant > bound;
+        uncertain |= !(std::fabs(determinant) > bound);
+    }
+    if (uncertain) [[unlikely]] {
+        uncertain = false;
+        for (size_t i = 0; i < count; ++i) {
+            double errorBound;
+            const double determinant = orient2dDouble(A, B, pointOf(points[i]), errorBound);
+            left[i] = determinant > errorBound;
+            uncertain |= !(std::fabs(determinant) > errorBound);
+        }
+    }
+    if (uncertain) [[unlikely]] {
+        for (size_t i = 0; i < count; ++i)
+            left[i] = orient2d(A, B, pointOf(points[i])) > 0;
+    }
 }
 
-std::vector<ei::Vec2> quick_hull_performance(const INPUT_PARAMETER& points)
-{
-    std::vector<ei::Vec2> convexHull;
-    if (points.size() < 3)
-    {
-        return points;
+/**
+ * Unstable in-place partition: the points strictly left of AB first (see classifyLeftOf).
+ * Which side of a line a point lies on is unpredictable, std::partition would mispredict its branch for about every
+ * second point, each time after the whole orientation test. Instead, blocks from the front and from the back are
+ * classified into lists of misplaced points, which are then swapped pairwise (Edelkamp and Weiss, "BlockQuicksort").
+ * @return End of the points left of AB.
+ */
+template<typename T, typename PointOf>
+static T* partitionLeftOf(T* first, T* last, const ei::Vec2& A, const ei::Vec2& B, float bound, PointOf pointOf) {
+    std::uint8_t left[PARTITION_BLOCK];
+    std::uint8_t frontMisplaced[PARTITION_BLOCK], backMisplaced[PARTITION_BLOCK];
+    size_t frontStart = 0, frontCount = 0, backStart = 0, backCount = 0;
+    while (static_cast<size_t>(last - first) >= 2 * PARTITION_BLOCK) {
+        if (frontCount == 0) {
+            frontStart = 0;
+            classifyLeftOf(first, PARTITION_BLOCK, A, B, bound, pointOf, left);
+            for (size_t i = 0; i < PARTITION_BLOCK; ++i) {
+                frontMisplaced[frontCount] = static_cast<std::uint8_t>(i);
+                frontCount += !left[i];
+            }
+        }
+        if (backCount == 0) {
+            backStart = 0;
+            classifyLeftOf(last - PARTITION_BLOCK, PARTITION_BLOCK, A, B, bound, pointOf, left);
+            for (size_t i = 0; i < PARTITION_BLOCK; ++i) {
+                backMisplaced[backCount] = static_cast<std::uint8_t>(i);
+                backCount += left[i];
+            }
+        }
+        const size_t swaps = std::min(frontCount, backCount);
+        for (size_t i = 0; i < swaps; ++i)
+            std::iter_swap(first + frontMisplaced[frontStart + i], last - PARTITION_BLOCK + backMisplaced[backStart + i]);
+        frontStart += swaps;
+        frontCount -= swaps;
+        backStart += swaps;
+        backCount -= swaps;
+        if (frontCount == 0)
+            first += PARTITION_BLOCK;
+        if (backCount == 0)
+            last -= PARTITION_BLOCK;
     }
 
-    auto minmaxX = std::minmax_element(points.begin(), points.end(),
-        [](const ei::Vec2& a, const ei::Vec2& b) { return a.x < b.x; });
+    // Less than two blocks remain (possibly one with misplaced points left), they are swapped one by one
+    T* split = first;
+    for (T* it = first; it != last; ++it) {
+        const bool isLeft = orient2d(A, B, pointOf(*it), bound) > 0;
+        std::iter_swap(it, split);
+        split += isLeft;
+    }
+    return split;
+}
 
-    ei::Vec2 A = *minmaxX.first;
-    ei::Vec2 B = *minmaxX.second;
+// NOTE: Ties are broken by coordinates instead of position, so the pivot only depends on the point set and
+// the in-place and parallel variants (which order their buffers differently) build the identical hull
+static inline bool isFarther(double distance, const ei::Vec2& point, double maxDistance, const ei::Vec2& farthest) {
+    return distance > maxDistance || (distance == maxDistance && lexicographicLess(point, farthest));
+}
+
+/**
+ * Moves the point C with maximum distance from line PQ to *first and partitions the rest in place (partitionLeftOf):
+ * [first + 1, splitPC) left of PC | [splitPC, splitCQ) left of CQ | [splitCQ, last) inside triangle PCQ (discarded).
+ */
+static ei::Vec2 partitionAtFarthest(ei::Vec2* first, ei::Vec2* last, const ei::Vec2& P, const ei::Vec2& Q,
+                                    ei::Vec2*& splitPC, ei::Vec2*& splitCQ) {
+    ei::Vec2* farthest = first;
+    double maxDistance = crossProduct(P, Q, *first);
+    BoundingBox box(P);
+    box.extend(Q);
+    for (ei::Vec2* it = first; it != last; ++it) {
+        double distance = crossProduct(P, Q, *it);
+        if (isFarther(distance, *it, maxDistance, *farthest)) {
+            maxDistance = distance;
+            farthest = it;
+        }
+        box.extend(*it);
+    }
+    std::iter_swap(first, farthest);
+    const ei::Vec2 C = *first;
+    const float bound = box.orientationBound();
 
-    convexHull.push_back(A);
-    convexHull.push_back(B);
+    splitPC = partitionLeftOf(first + 1, last, P, C, bound, samePoint);
+    splitCQ = partitionLeftOf(splitPC, last, C, Q, bound, samePoint);
+    return C;
+}
 
-    std::vector<ei::Vec2> leftSet;
-    std::vector<ei::Vec2> rightSet;
+/**
+ * In-place counterpart of findHull. All points in [first, last) lie strictly left of PQ.
+ * On return, the hull points between P and Q (exclusive) are stored in order at [first, first + count).
+ */
+static size_t findHullInPlace(ei::Vec2* first, ei::Vec2* last, const ei::Vec2& P, const ei::Vec2& Q) {
+    if (first == last)
+        return 0;
 
-    for (const auto& point : points) {
-        if (point == A || point == B)
-            continue;
+    ei::Vec2 *splitPC, *splitCQ;
+    const ei::Vec2 C = partitionAtFarthest(first, last, P, Q, splitPC, splitCQ);
 
-        int location = pointLocation(A, B, point);
-        if (location == 1)
-            leftSet.push_back(point);
-        else if (location == -1)
-            rightSet.push_back(point);
-    }
+    // Hull of PC is written behind C, then C is rotated behind it: [hullPC..., C]
+    size_t countPC = findHullInPlace(first + 1, splitPC, P, C);
+    std::rotate(first, first + 1, first + 1 + countPC);
 
-    findHull(convexHull, leftSet, A, B);
-    findHull(convexHull, rightSet, B, A);
+    // Hull of CQ is moved down to close the gap: [hullPC..., C, hullCQ...]
+    size_t countCQ = findHullInPlace(splitPC, splitCQ, C, Q);
+    std::move(splitPC, splitPC + countCQ, first + countPC + 1);
 
-    return convexHull;
+    return countPC + 1 + countCQ;
 }
 
-
-AlgorithmGenerator quick_hull_visualization(const INPUT_PARAMETER& points)
+std::vector<ei::Vec2> quick_hull_inplace(const INPUT_PARAMETER& points)
 {
-    auto visual = std::make_shared<Visual>();
+    // NOTE: The copy is the only allocation, the hull is assembled at its front
+    std::vector<ei::Vec2> buffer(points);
+    if (buffer.size() < 3)
+    {
+        return buffer;
+    }
 
-    if (points.size() < 3)
+    const Extremes extremes(buffer.data(), buffer.data() + buffer.size());
+    const ei::Vec2 A = extremes.min;
+    const ei::Vec2 B = extremes.max;
+    if (A == B)
     {
-        visual->setExplanation("Point cloud has less than 3 points. Convex hull is the point cloud itself.");
-        for (const auto& point : points)
-        {
-            visual->addHullPoint(sf::Vector2f(point.x, point.y));
-            visual->addHighlight(sf::Vector2f(point.x, point.y), "P", sf::Color::Blue);
-            co_yield visual;
-        }
-        co_return;
+        buffer.resize(1);
+        return buffer;
     }
 
-    auto minmaxX = std::minmax_element(points.begin(), points.end(),
-        [](const ei::Vec2& a, const ei::Vec2& b) { return a.x < b.x; });
+    // [begin, splitAB) left of AB | [splitAB, splitBA) left of BA | rest on line AB (including A and B)
+    ei::Vec2* begin = buffer.data();
+    const float bound = extremes.box.orientationBound();
+    ei::Vec2* splitAB = partitionLeftOf(begin, begin + buffer.size(), A, B, bound, samePoint);
+    ei::Vec2* splitBA = partitionLeftOf(splitAB, begin + buffer.size(), B, A, bound, samePoint);
 
-    ei::Vec2 A = *minmaxX.first;
-    ei::Vec2 B = *minmaxX.second;
+    size_t countAB = findHullInPlace(begin, splitAB, A, B);
+    size_t countBA = findHullInPlace(splitAB, splitBA, B, A);
 
-    visual->setExplanation("Finding minimum x-coordinate in point cloud.");
-    visual->addHighlight(sf::Vector2f(A.x, A.y), "A (min point)", sf::Color::Red);
-    co_yield visual;
+    // Assemble [A, hullAB..., B, hullBA...], the hull of BA is moved first as shifting hullAB may overwrite it
+    ei::Vec2* hullBA = begin + countAB + 2;
+    if (hullBA > splitAB)
+        std::move_backward(splitAB, splitAB + countBA, hullBA + countBA);
+    else
+        std::move(splitAB, splitAB + countBA, hullBA);
+    std::move_backward(begin, begin + countAB, begin + countAB + 1);
+    buffer[0] = A;
+    buffer[countAB + 1] = B;
 
-    visual->setExplanation("Finding maximum x-coordinate in point cloud.");
-    visual->addHighlight(sf::Vector2f(B.x, B.y), "B (max point)", sf::Color::Red);
-    co_yield visual;
+    buffer.resize(countAB + countBA + 2);
+    return buffer;
+}
+
+// Point with the given index in the coordinate arrays
+static inline ei::Vec2 pointAt(const float* xs, const float* ys, std::uint32_t index) {
+    return {xs[index], ys[index]};
+}
 
-    visual->addIndicatorLine(sf::Vector2f(A.x, A.y), sf::Vector2f(B.x, B.y), sf::Color::Red);
-    visual->setExplanation("Line AB is formed between the minimum and maximum x-coordinates.");
-    co_yield visual;
+// Same as isFarther, equal points are ordered by index, so the smallest index of a repeated hull point is reported
+static inline bool isFartherIndex(double distance, const ei::Vec2& point, std::uint32_t index,
+                                  double maxDistance, const ei::Vec2& farthest, std::uint32_t farthestIndex) {
+    return isFarther(distance, point, maxDistance, farthest) ||
+           (distance == maxDistance && point == farthest && index < farthestIndex);
+}
 
-    visual->setExplanation("Dividing the point cloud into two sets: left and right of line AB.");
-    std::vector<ei::Vec2> leftSet;
-    std::vector<ei::Vec2> rightSet;
+/**
+ * findHullInPlace over point indices: all points referenced by [first, last) lie strictly left of PQ.
+ * On return, the indices of the hull points between P and Q (exclusive) are stored in order at [first, first + count).
+ */
+static size_t findHullIndices(const float* xs, const float* ys, std::uint32_t* first, std::uint32_t* last,
+                              const ei::Vec2& P, const ei::Vec2& Q) {
+    if (first == last)
+        return 0;
 
-    for (const auto& point : points)
-    {
-        if (point == A || point == B)
-            continue;
-
-        int location = pointLocation(A, B, point);
-        if (location == 1)
-        {
-            leftSet.push_back(point);
-            // Visualize the point being added to the left set
-            visual->addHighlight(sf::Vector2f(point.x, point.y), "P in Left Set", sf::Color::Green);
-            visual->setExplanation("Point is on the left side of line A-B.");
-            co_yield visual;
+    std::uint32_t* farthest = first;
+    ei::Vec2 C = pointAt(xs, ys, *first);
+    double maxDistance = crossProduct(P, Q, C);
+    BoundingBox box(P);
+    box.extend(Q);
+    for (std::uint32_t* it = first; it != last; ++it) {
+        const ei::Vec2 point = pointAt(xs, ys, *it);
+        double distance = crossProduct(P, Q, point);
+        if (isFartherIndex(distance, point, *it, maxDistance, C, *farthest)) {
+            maxDistance = distance;
+            farthest = it;
+            C = point;
         }
-        else if (location == -1)
-        {
-            rightSet.push_back(point);
-            // Visualize the point being added to the right set
-            visual->addHighlight(sf::Vector2f(point.x, point.y), "P in Right Set", sf::Color::Blue);
-            visual->setExplanation("Point is on the right side of line A-B.");
-            co_yield visual;
+        box.extend(point);
+    }
+    std::iter_swap(first, farthest);
+    const float bound = box.orientationBound();
+
+    auto indexedPoint = [xs, ys](std::uint32_t index) { return pointAt(xs, ys, index); };
+    std::uint32_t* splitPC = partitionLeftOf(first + 1, last, P, C, bound, indexedPoint);
+    std::uint32_t* splitCQ = partitionLeftOf(splitPC, last, C, Q, bound, indexedPoint);
+
+    size_t countPC = findHullIndices(xs, ys, first + 1, splitPC, P, C);
+    std::rotate(first, first + 1, first + 1 + countPC);
+    size_t countCQ = findHullIndices(xs, ys, splitPC, splitCQ, C, Q);
+    std::move(splitPC, splitPC + countCQ, first + countPC + 1);
+    return countPC + 1 + countCQ;
+}
+
+std::size_t quick_hull_indices(std::span<const float> xs, std::span<const float> ys, std::span<std::uint32_t> out)
+{
+    if (xs.size() != ys.size())
+        throw std::invalid_argument("The x and y coordinate arrays differ in size.");
+    if (out.size() < xs.size())
+        throw std::invalid_argument("The index array must have room for one index per point.");
+    if (xs.size() > UINT32_MAX)
+        throw std::invalid_argument("Too many points for 32 bit indices.");
+
+    const std::uint32_t size = static_cast<std::uint32_t>(xs.size());
+    if (size == 0)
+        return 0;
+
+    // Lexicographic min/max, the smallest index among equal points
+    std::uint32_t min = 0, max = 0;
+    BoundingBox box(pointAt(xs.data(), ys.data(), 0));
+    for (std::uint32_t i = 1; i < size; ++i) {
+        const ei::Vec2 point = pointAt(xs.data(), ys.data(), i);
+        if (lexicographicLess(point, pointAt(xs.data(), ys.data(), min)))
+            min = i;
+        if (lexicographicLess(pointAt(xs.data(), ys.data(), max), point))
+            max = i;
+        box.extend(point);
+    }
+    const float bound = box.orientationBound();
+    const ei::Vec2 A = pointAt(xs.data(), ys.data(), min);
+    const ei::Vec2 B = pointAt(xs.data(), ys.data(), max);
+    out[0] = min;
+    if (A == B)
+        return 1;
+
+    // Same layout as quick_hull_inplace: [0, splitAB) left of AB | [splitAB, splitBA) left of BA
+    std::uint32_t* begin = out.data();
+    std::uint32_t* end = begin + size;
+    std::iota(begin, end, 0u);
+    auto indexedPoint = [x = xs.data(), y = ys.data()](std::uint32_t index) { return pointAt(x, y, index); };
+    std::uint32_t* splitAB = partitionLeftOf(begin, end, A, B, bound, indexedPoint);
+    std::uint32_t* splitBA = partitionLeftOf(splitAB, end, B, A, bound, indexedPoint);
+
+    size_t countAB = findHullIndices(xs.data(), ys.data(), begin, splitAB, A, B);
+    size_t countBA = findHullIndices(xs.data(), ys.data(), splitAB, splitBA, B, A);
+
+    // Assemble [A, hullAB..., B, hullBA...] (see quick_hull_inplace)
+    std::uint32_t* hullBA = begin + countAB + 2;
+    if (hullBA > splitAB)
+        std::move_backward(splitAB, splitAB + countBA, hullBA + countBA);
+    else
+        std::move(splitAB, splitAB + countBA, hullBA);
+    std::move_backward(begin, begin + countAB, begin + countAB + 1);
+    begin[0] = min;
+    begin[countAB + 1] = max;
+    return countAB + countBA + 2;
+}
+
+/**
+ * Stable parallel split of source into destination: [points left of PC... | points left of CQ...], the other
+ * points are dropped. Every chunk classifies its points (classifyLeftOf, bound is the orientation bound
+ * of the points) and counts them, the prefix sums of the counts give each chunk its output offsets and the chunks
+ * are scattered in parallel (OpenMP taskloops, must be called from within a parallel region). The scatter selects
+ * the target of a point without a branch on its side, dropped points are written to a local sink.
+ * @return Number of points left of PC and left of CQ.
+ */
+static std::pair<size_t, size_t> parallelPartition(const ei::Vec2* source, size_t size, ei::Vec2* destination,
+                                                   const ei::Vec2& P, const ei::Vec2& C, const ei::Vec2& Q, float bound) {
+    const size_t chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<size_t> firstOffsets(chunks + 1, 0);
+    std::vector<size_t> secondOffsets(chunks + 1, 0);
+    // Side of every point: bit 0 left of PC, bit 1 left of CQ (but not of PC). Default-initialized, see below
+    std::unique_ptr<std::uint8_t[]> sides(new std::uint8_t[size]);
+
+    #pragma omp taskloop grainsize(1) default(none) shared(source, size, chunks, P, C, Q, bound, sides, firstOffsets, secondOffsets, PARTITION_BLOCK)
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t end = std::min(size, (chunk + 1) * CHUNK_SIZE);
+        size_t firstCount = 0, secondCount = 0;
+        for (size_t block = chunk * CHUNK_SIZE; block < end; block += PARTITION_BLOCK) {
+            const size_t count = std::min(PARTITION_BLOCK, end - block);
+            std::uint8_t leftOfPC[PARTITION_BLOCK], leftOfCQ[PARTITION_BLOCK];
+            classifyLeftOf(source + block, count, P, C, bound, samePoint, leftOfPC);
+            classifyLeftOf(source + block, count, C, Q, bound, samePoint, leftOfCQ);
+            for (size_t i = 0; i < count; ++i) {
+                const std::uint8_t isSecond = leftOfCQ[i] & !leftOfPC[i];
+                sides[block + i] = leftOfPC[i] | (isSecond << 1);
+                firstCount += leftOfPC[i];
+                secondCount += isSecond;
+            }
         }
-        // No need to visualize points on the line (location == 0) in this step
+        firstOffsets[chunk + 1] = firstCount;
+        secondOffsets[chunk + 1] = secondCount;
     }
-    visual->clearHighlights();
-
-    // Initialize convex hull with points A and B
-    std::vector<ei::Vec2> convexHull = { A, B };
-    visual->clearHullPoints();
-    visual->addHullPoint(sf::Vector2f(A.x, A.y));
-    visual->addHullPoint(sf::Vector2f(B.x, B.y));
-    visual->setExplanation("Initializing convex hull with points A and B.");
-    co_yield visual;
-
-    // Initialize the stack for non-recursive processing
-    std::stack<std::tuple<ei::Vec2, ei::Vec2, std::vector<ei::Vec2>>> stack;
-    stack.push(std::make_tuple(A, B, leftSet));
-    stack.push(std::make_tuple(B, A, rightSet));
-
-    // Variables to keep track of previously highlighted points
-    ei::Vec2 prevP1{}, prevP2{}, prevC{};
-
-    // Begin the non-recursive process using a stack
-    while (!stack.empty())
-    {
-        // Remove highlights from previous iteration
-        if (prevP1 != ei::Vec2{})
-            visual->removeHighlight(sf::Vector2f(prevP1.x, prevP1.y));
-        if (prevP2 != ei::Vec2{})
-            visual->removeHighlight(sf::Vector2f(prevP2.x, prevP2.y));
-        if (prevC != ei::Vec2{})
-            visual->removeHighlight(sf::Vector2f(prevC.x, prevC.y));
-
-        visual->clearIndicatorLines(); // Clear previous indicator lines
-
-        auto [P1, P2, set] = stack.top();
-        stack.pop();
-
-        // Visualize the current edge being processed
-        visual->setExplanation("Processing edge between P1 and P2.");
-        visual->addHighlight(sf::Vector2f(P1.x, P1.y), "P1", sf::Color::Magenta);
-        visual->addHighlight(sf::Vector2f(P2.x, P2.y), "P2", sf::Color::Magenta);
-        visual->addIndicatorLine(sf::Vector2f(P1.x, P1.y), sf::Vector2f(P2.x, P2.y), sf::Color::Magenta);
-        co_yield visual;
-
-        // Update previous P1 and P2
-        prevP1 = P1;
-        prevP2 = P2;
-
-        if (set.empty())
-        {
-            visual->setExplanation("No points left on this side of the edge.");
-            co_yield visual;
-            continue;
+    std::partial_sum(firstOffsets.begin(), firstOffsets.end(), firstOffsets.begin());
+    std::partial_sum(secondOffsets.begin(), secondOffsets.end(), secondOffsets.begin());
+    const size_t firstCount = firstOffsets[chunks];
+    const size_t secondCount = secondOffsets[chunks];
+
+    #pragma omp taskloop grainsize(1) default(none) shared(source, size, chunks, destination, sides, firstOffsets, secondOffsets, firstCount)
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t begin = chunk * CHUNK_SIZE;
+        const size_t end = std::min(size, begin + CHUNK_SIZE);
+        ei::Vec2* firstOut = destination + firstOffsets[chunk];
+        ei::Vec2* secondOut = destination + firstCount + secondOffsets[chunk];
+        ei::Vec2 sink;
+        for (size_t i = begin; i < end; ++i) {
+            const bool isFirst = sides[i] & 1;
+            const bool isSecond = sides[i] >> 1;
+            *(isFirst ? firstOut : (isSecond ? secondOut : &sink)) = source[i];
+            firstOut += isFirst;
+            secondOut += isSecond;
         }
+    }
+    return {firstCount, secondCount};
+}
 
-        // Find the point C with the maximum distance from the line P1P2
-        float maxDistance = -1.0f;
-        ei::Vec2 C;
-        for (const auto& point : set)
-        {
-            float distance = distanceFromLine(P1, P2, point);
-            if (distance > maxDistance)
-            {
+// Parallel reduction for the point with maximum distance from line PQ (same tie-breaking as partitionAtFarthest),
+// box is extended by the points
+static ei::Vec2 parallelFarthest(const ei::Vec2* points, size_t size, const ei::Vec2& P, const ei::Vec2& Q,
+                                 BoundingBox& box) {
+    const size_t chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<size_t> farthest(chunks);
+    std::vector<BoundingBox> boxes(chunks, box);
+
+    #pragma omp taskloop grainsize(1) default(none) shared(points, size, chunks, P, Q, farthest, boxes)
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t end = std::min(size, (chunk + 1) * CHUNK_SIZE);
+        size_t best = chunk * CHUNK_SIZE;
+        double maxDistance = crossProduct(P, Q, points[best]);
+        BoundingBox chunkBox(points[best]);
+        for (size_t i = best; i < end; ++i) {
+            double distance = crossProduct(P, Q, points[i]);
+            if (isFarther(distance, points[i], maxDistance, points[best])) {
                 maxDistance = distance;
-                C = point;
+                best = i;
             }
+            chunkBox.extend(points[i]);
         }
+        farthest[chunk] = best;
+        boxes[chunk] = chunkBox;
+    }
 
-        // Visualize point C
-        visual->addHighlight(sf::Vector2f(C.x, C.y), "C (Furthest from edge)", sf::Color::Yellow);
-        visual->setExplanation("Found point C with maximum distance from edge P1-P2.");
-        co_yield visual;
-        // Remove highlights for P1 and P2
-        visual->removeHighlight(sf::Vector2f(P1.x, P1.y));
-        visual->removeHighlight(sf::Vector2f(P2.x, P2.y));
-
-        // Update previous C
-        prevC = C;
-
-        // Insert C into convex hull after P1
-        auto it = std::find(convexHull.begin(), convexHull.end(), P1);
-        if (it != convexHull.end()) {
-            ++it; // Move iterator to position after P1
-            convexHull.insert(it, C);
-        } else {
-            // This should not happen, but handle it just in case
-            convexHull.push_back(C);
-        }
+    size_t best = farthest[0];
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        const ei::Vec2& point = points[farthest[chunk]];
+        if (isFarther(crossProduct(P, Q, point), point, crossProduct(P, Q, points[best]), points[best]))
+            best = farthest[chunk];
+        box.extend(boxes[chunk]);
+    }
+    return points[best];
+}
+
+/**
+ * Task-parallel findHull. All points in data[0, size) lie strictly left of PQ, scratch is a buffer of the same size.
+ * Large sub-problems are partitioned in parallel from data into scratch (and recurse with swapped buffers),
+ * medium ones are partitioned in place. Both halves run as OpenMP tasks and are joined in order, so the hull
+ * points between P and Q (exclusive) end up at data[0, count) exactly as in findHullInPlace.
+ */
+static size_t findHullParallel(ei::Vec2* data, ei::Vec2* scratch, size_t size, const ei::Vec2& P, const ei::Vec2& Q) {
+    if (size < TASK_CUTOFF)
+        return findHullInPlace(data, data + size, P, Q);
+
+    size_t countPC = 0, countCQ = 0;
+    if (size < PARTITION_CUTOFF) {
+        ei::Vec2 *splitPC, *splitCQ;
+        const ei::Vec2 C = partitionAtFarthest(data, data + size, P, Q, splitPC, splitCQ);
+        const size_t sizePC = splitPC - (data + 1);
+
+        #pragma omp task default(none) shared(countPC, data, scratch, sizePC, P, C)
+        countPC = findHullParallel(data + 1, scratch + 1, sizePC, P, C);
+        #pragma omp task default(none) shared(countCQ, splitPC, splitCQ, data, scratch, C, Q)
+        countCQ = findHullParallel(splitPC, scratch + (splitPC - data), splitCQ - splitPC, C, Q);
+        #pragma omp taskwait
+
+        std::rotate(data, data + 1, data + 1 + countPC);
+        std::move(splitPC, splitPC + countCQ, data + countPC + 1);
+        return countPC + 1 + countCQ;
+    }
+
+    BoundingBox box(P);
+    box.extend(Q);
+    const ei::Vec2 C = parallelFarthest(data, size, P, Q, box);
+    auto [sizePC, sizeCQ] = parallelPartition(data, size, scratch, P, C, Q, box.orientationBound());
+
+    #pragma omp task default(none) shared(countPC, data, scratch, sizePC, P, C)
+    countPC = findHullParallel(scratch, data, sizePC, P, C);
+    #pragma omp task default(none) shared(countCQ, data, scratch, sizePC, sizeCQ, C, Q)
+    countCQ = findHullParallel(scratch + sizePC, data + sizePC, sizeCQ, C, Q);
+    #pragma omp taskwait
+
+    // [hullPC..., C, hullCQ...] back into data
+    std::copy(scratch, scratch + countPC, data);
+    data[countPC] = C;
+    std::copy(scratch + sizePC, scratch + sizePC + countCQ, data + countPC + 1);
+    return countPC + 1 + countCQ;
+}
+
+std::vector<ei::Vec2> quick_hull_parallel(const INPUT_PARAMETER& points)
+{
+    if (points.size() < 3)
+    {
+        return points;
+    }
+
+    const size_t size = points.size();
+    // NOTE: Default-initialized (no zeroing), the pages are first touched by the parallel partition
+    std::unique_ptr<ei::Vec2[]> data(new ei::Vec2[size]);
+    std::unique_ptr<ei::Vec2[]> scratch(new ei::Vec2[size]);
+    std::vector<ei::Vec2> convexHull;
 
-        // Visualize updated convex hull
-        visual->clearHullPoints();
-        for (const auto& point : convexHull)
-        {
-            visual->addHullPoint(sf::Vector2f(point.x, point.y));
+    #pragma omp parallel default(none) shared(points, size, data, scratch, convexHull)
+    #pragma omp single
+    {
+        // Lexicographic min/max and the bounding box as parallel reduction over chunks
+        const size_t chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        std::vector<Extremes> extremes(chunks, Extremes(points.data(), points.data() + 1));
+        #pragma omp taskloop grainsize(1) default(none) shared(points, size, chunks, extremes)
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            const ei::Vec2* first = points.data() + chunk * CHUNK_SIZE;
+            const ei::Vec2* last = points.data() + std::min(size, (chunk + 1) * CHUNK_SIZE);
+            extremes[chunk] = Extremes(first, last);
         }
-        visual->setExplanation("Inserted point C into convex hull.");
-        co_yield visual;
-        // Remove highlight for C after updating the convex hull
-        visual->removeHighlight(sf::Vector2f(C.x, C.y));
-
-        // Determine points to the left of lines P1C and CP2
-        std::vector<ei::Vec2> leftSet1;
-        std::vector<ei::Vec2> leftSet2;
-
-        for (const auto& point : set)
-        {
-            if (point == C)
-                continue;
-
-            int location1 = pointLocation(P1, C, point);
-            if (location1 == 1)
-            {
-                leftSet1.push_back(point);
-                // Visualize point added to leftSet1
-                visual->addHighlight(sf::Vector2f(point.x, point.y), "P in Left Set 1", sf::Color::Green);
-                visual->setExplanation("Point is on the left side of line P1-C.");
-                co_yield visual;
-                // visual->removeHighlight(sf::Vector2f(point.x, point.y)); // Remove highlight
-            }
-            else
-            {
-                int location2 = pointLocation(C, P2, point);
-                if (location2 == 1)
-                {
-                    leftSet2.push_back(point);
-                    // Visualize point added to leftSet2
-                    visual->addHighlight(sf::Vector2f(point.x, point.y), "P in Left Set 2", sf::Color::Blue);
-                    visual->setExplanation("Point is on the left side of line C-P2.");
-                    co_yield visual;
-                    // visual->removeHighlight(sf::Vector2f(point.x, point.y)); // Remove highlight
-                }
-            }
+        ei::Vec2 A = extremes[0].min;
+        ei::Vec2 B = extremes[0].max;
+        BoundingBox box = extremes[0].box;
+        for (const Extremes& chunkExtremes : extremes) {
+            if (lexicographicLess(chunkExtremes.min, A))
+                A = chunkExtremes.min;
+            if (lexicographicLess(B, chunkExtremes.max))
+                B = chunkExtremes.max;
+            box.extend(chunkExtremes.box);
+        }
+
+        if (A == B) {
+            convexHull.push_back(A);
+        } else {
+            // [left of AB | left of BA], the points on the line AB are dropped
+            auto [sizeAB, sizeBA] = parallelPartition(points.data(), size, data.get(), A, B, A, box.orientationBound());
+
+            size_t countAB = 0, countBA = 0;
+            #pragma omp task default(none) shared(countAB, data, scratch, sizeAB, A, B)
+            countAB = findHullParallel(data.get(), scratch.get(), sizeAB, A, B);
+            #pragma omp task default(none) shared(countBA, data, scratch, sizeAB, sizeBA, A, B)
+            countBA = findHullParallel(data.get() + sizeAB, scratch.get() + sizeAB, sizeBA, B, A);
+            #pragma omp taskwait
+
+            convexHull.reserve(countAB + countBA + 2);
+            convexHull.push_back(A);
+            convexHull.insert(convexHull.end(), data.get(), data.get() + countAB);
+            convexHull.push_back(B);
+            convexHull.insert(convexHull.end(), data.get() + sizeAB, data.get() + sizeAB + countBA);
         }
-        visual->clearHighlights();
+    }
+    return convexHull;
+}
+
+std::vector<ei::Vec2> quick_hull_performance(const INPUT_PARAMETER& points)
+{
+    const PointsSoA soa(points);
+    std::vector<std::uint32_t> indices(points.size());
+    const size_t count = quick_hull_indices({soa.x(), soa.size()}, {soa.y(), soa.size()}, indices);
+    return soa.gather({indices.data(), count});
+}
+
+
+/**
+ * QuickHull step over structure-of-arrays points: (x, y) holds the points strictly left of PQ and (scratchX, scratchY)
+ * the same amount of free space. The points left of PC and CQ are split into the scratch arrays, which become the
+ * input of the two sub-problems, while the input arrays become their scratch space.
+ */
+static void findHullSoA(float* x, float* y, float* scratchX, float* scratchY, size_t count,
+                        const ei::Vec2& P, const ei::Vec2& Q, std::vector<ei::Vec2>& hull) {
+    if (count == 0)
+        return;
+
+    // Every point lies strictly left of PQ (same predicate as the partition), so there is a farthest point.
+    // Only for coordinates of extremely different magnitude the rounded distances may all be 0
+    size_t farthest = farthest_point_kernel(x, y, count, P, Q);
+    if (farthest == count)
+        farthest = 0;
+    const ei::Vec2 C(x[farthest], y[farthest]);
+
+    // scratch: [left of PC | left of CQ], the points inside the triangle PCQ remain in x/y and are dropped
+    const size_t countPC = partition_kernel(x, y, count, P, C, scratchX, scratchY);
+    const size_t countCQ = partition_kernel(x, y, count - countPC, C, Q, scratchX + countPC, scratchY + countPC);
 
-        // Add new edges to the stack for further processing
-        stack.push(std::make_tuple(P1, C, leftSet1));
-        stack.push(std::make_tuple(C, P2, leftSet2));
-        visual->setExplanation("Added new edges to stack for processing.");
-        co_yield visual;
+    findHullSoA(scratchX, scratchY, x, y, countPC, P, C, hull);
+    hull.push_back(C);
+    findHullSoA(scratchX + countPC, scratchY + countPC, x + countPC, y + countPC, countCQ, C, Q, hull);
+}
+
+std::vector<ei::Vec2> quick_hull_simd(const INPUT_PARAMETER& points)
+{
+    if (points.size() < 3)
+    {
+        return points;
     }
 
-    // Final convex hull visualization
-    visual->clearHighlights();
-    visual->clearHighlights();
-    visual->clearHullPoints();
-    for (const auto& point : convexHull)
+    auto minmax = std::minmax_element(points.begin(), points.end(), lexicographicLess);
+    const ei::Vec2 A = *minmax.first;
+    const ei::Vec2 B = *minmax.second;
+    if (A == B)
     {
-        visual->addHullPoint(sf::Vector2f(point.x, point.y));
+        return {A};
     }
-    // Close the loop by adding the first point at the end
-    visual->addHullPoint(sf::Vector2f(convexHull.front().x, convexHull.front().y));
-    visual->setExplanation("Convex hull construction complete.");
-    visual->finished = true;
-    co_yield visual;
 
-    co_return;
+    PointsSoA data(points);
+    PointsSoA scratch(points.size());
+    const size_t size = points.size();
+    const size_t countAB = partition_kernel(data.x(), data.y(), size, A, B, scratch.x(), scratch.y());
+    const size_t countBA = partition_kernel(data.x(), data.y(), size - countAB, B, A,
+                                            scratch.x() + countAB, scratch.y() + countAB);
+
+    std::vector<ei::Vec2> hull;
+    hull.push_back(A);
+    findHullSoA(scratch.x(), scratch.y(), data.x(), data.y(), countAB, A, B, hull);
+    hull.push_back(B);
+    findHullSoA(scratch.x() + countAB, scratch.y() + countAB, data.x() + countAB, data.y() + countAB, countBA, B, A, hull);
+    return hull;
 }
-
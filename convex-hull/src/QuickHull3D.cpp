@@ -0,0 +1,421 @@
+﻿#include "QuickHull3D.h"
+#include "Predicates.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+constexpr std::uint32_t NONE = UINT32_MAX;            ///< Missing point, face or half-edge
+constexpr std::size_t PARALLEL_CUTOFF = 1 << 14;      ///< Fewer conflict points are redistributed sequentially
+
+// Triangle of the hull, its half-edge k runs from vertex[k] to vertex[(k + 1) % 3] and has the index 3 * face + k
+struct Face
+{
+    std::array<std::uint32_t, 3> vertex{};
+    std::array<double, 3> normal{};         ///< (b - a) x (c - a) rounded to double precision
+    std::array<double, 3> permanent{};      ///< Absolute values of the products in normal (for the error bound)
+    std::uint32_t outside = NONE;           ///< First point of the conflict list
+    std::uint32_t farthest = NONE;          ///< Conflict point farthest above the face
+    double farthestDistance = 0.0;
+    std::uint32_t visited = 0;              ///< Search in which visible was determined
+    bool visible = false;
+    bool alive = true;
+};
+
+// Horizon edge a -> b of a visible face and the half-edge of the hidden face behind it
+struct HorizonEdge
+{
+    std::uint32_t a, b, twin;
+};
+
+static inline bool exactlyCollinear(const ei::Vec3& a, const ei::Vec3& b, const ei::Vec3& c)
+{
+    return orient2d(ei::Vec2(a.x, a.y), ei::Vec2(b.x, b.y), ei::Vec2(c.x, c.y)) == 0 &&
+           orient2d(ei::Vec2(a.y, a.z), ei::Vec2(b.y, b.z), ei::Vec2(c.y, c.z)) == 0 &&
+           orient2d(ei::Vec2(a.x, a.z), ei::Vec2(b.x, b.z), ei::Vec2(c.x, c.z)) == 0;
+}
+
+static inline std::array<double, 3> difference(const ei::Vec3& a, const ei::Vec3& b)
+{
+    return {static_cast<double>(a.x) - b.x, static_cast<double>(a.y) - b.y, static_cast<double>(a.z) - b.z};
+}
+
+static inline std::array<double, 3> cross(const std::array<double, 3>& u, const std::array<double, 3>& v)
+{
+    return {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+}
+
+static inline double dot(const std::array<double, 3>& u, const std::array<double, 3>& v)
+{
+    return u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+}
+
+// Index of the point with the largest score (the smallest index on ties) and its score, searched in parallel
+template<typename Score>
+static std::pair<std::uint32_t, double> parallelArgmax(std::size_t count, const Score& score)
+{
+    std::uint32_t bestIndex = NONE;
+    double bestScore = -std::numeric_limits<double>::infinity();
+    const std::int64_t size = static_cast<std::int64_t>(count);
+    #pragma omp parallel default(none) shared(size, score, bestIndex, bestScore)
+    {
+        std::uint32_t localIndex = NONE;
+        double localScore = -std::numeric_limits<double>::infinity();
+        #pragma omp for schedule(static) nowait
+        for (std::int64_t i = 0; i < size; ++i)
+        {
+            const double value = score(static_cast<std::size_t>(i));
+            if (value > localScore)
+            {
+                localScore = value;
+                localIndex = static_cast<std::uint32_t>(i);
+            }
+        }
+        #pragma omp critical
+        if (localIndex != NONE && (localScore > bestScore || (localScore == bestScore && localIndex < bestIndex)))
+        {
+            bestScore = localScore;
+            bestIndex = localIndex;
+        }
+    }
+    return {bestIndex, bestScore};
+}
+
+class HullBuilder3D
+{
+public:
+    explicit HullBuilder3D(std::span<const ei::Vec3> points)
+        : points(points), nextOutside(points.size(), NONE), owner(points.size(), NONE), newFaceAt(points.size(), NONE) {}
+
+    std::vector<std::uint32_t> build();
+
+private:
+    bool initialSimplex(std::array<std::uint32_t, 4>& simplex) const;
+    std::uint32_t addFace(std::uint32_t a, std::uint32_t b, std::uint32_t c);
+    void link(std::uint32_t edge, std::uint32_t twinEdge);
+    void addConflict(std::uint32_t face, std::uint32_t point);
+    std::uint32_t firstFaceAbove(std::span<const std::uint32_t> candidates, std::uint32_t point) const;
+    void distribute(std::span<const std::uint32_t> pointList, std::span<const std::uint32_t> candidates);
+    void addPoint(std::uint32_t face);
+
+    /**
+     * Strictly above the plane of the face (seen from outside, the vertices are counterclockwise).
+     * normal . (p - a) is orient3d with the differences taken to a instead of p, so the same error bound applies.
+     * The normal and its permanent are computed once per face, a test costs 3 differences and 2 dot products.
+     */
+    bool above(std::uint32_t face, std::uint32_t point) const
+    {
+        const Face& f = faces[face];
+        const auto offset = difference(points[point], points[f.vertex[0]]);
+        const double distance = dot(f.normal, offset);
+        const double bound = ORIENT3D_ERROR_BOUND * (std::fabs(offset[0]) * f.permanent[0] +
+                                                     std::fabs(offset[1]) * f.permanent[1] +
+                                                     std::fabs(offset[2]) * f.permanent[2]);
+        if (std::fabs(distance) > bound)
+            return distance > 0.0;
+        return orient3d(points[f.vertex[0]], points[f.vertex[1]], points[f.vertex[2]], points[point]) < 0;
+    }
+
+    std::span<const ei::Vec3> points;
+    std::vector<Face> faces;
+    std::vector<std::uint32_t> twin;          ///< Opposite half-edge of every half-edge
+    std::vector<std::uint32_t> freeFaces;
+    std::vector<std::uint32_t> nextOutside;   ///< Next point of the same conflict list
+    std::vector<std::uint32_t> owner;         ///< Scratch: face a point was assigned to
+    std::vector<std::uint32_t> newFaceAt;     ///< Scratch: new face whose horizon edge starts at a vertex
+    std::vector<std::uint32_t> work;          ///< Faces that may have conflict points
+    std::vector<std::uint32_t> stack;
+    std::vector<std::uint32_t> visibleFaces;
+    std::vector<HorizonEdge> horizon;
+    std::vector<std::uint32_t> newFaces;
+    std::vector<std::uint32_t> pending;
+    std::uint32_t search = 0;
+};
+
+/**
+ * Finds 4 points that are not coplanar: the two most distant of the 6 axis extremes, the point farthest from their
+ * line and the point farthest from the plane of the three. Near-degenerate choices are checked with the exact
+ * predicates and replaced by a scan for any suitable point.
+ * @return false if all points are coplanar.
+ */
+bool HullBuilder3D::initialSimplex(std::array<std::uint32_t, 4>& simplex) const
+{
+    const std::size_t count = points.size();
+    std::array<std::uint32_t, 6> extremes{};
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        for (int sign = 0; sign < 2; ++sign)
+        {
+            const double factor = sign == 0 ? 1.0 : -1.0;
+            extremes[2 * axis + sign] = parallelArgmax(count, [&](std::size_t i) {
+                const ei::Vec3& p = points[i];
+                return factor * (axis == 0 ? p.x : (axis == 1 ? p.y : p.z));
+            }).first;
+        }
+    }
+    double longest = 0.0;
+    for (std::uint32_t first : extremes)
+    {
+        for (std::uint32_t second : extremes)
+        {
+            const auto edge = difference(points[second], points[first]);
+            if (dot(edge, edge) > longest)
+            {
+                longest = dot(edge, edge);
+                simplex[0] = first;
+                simplex[1] = second;
+            }
+        }
+    }
+    if (longest == 0.0)
+        return false; // All points are equal
+
+    const ei::Vec3& a = points[simplex[0]];
+    const ei::Vec3& b = points[simplex[1]];
+    const auto line = difference(b, a);
+    simplex[2] = parallelArgmax(count, [&](std::size_t i) {
+        const auto normal = cross(line, difference(points[i], a));
+        return dot(normal, normal);
+    }).first;
+    if (exactlyCollinear(a, b, points[simplex[2]]))
+    {
+        std::size_t i = 0;
+        while (i < count && exactlyCollinear(a, b, points[i]))
+            ++i;
+        if (i == count)
+            return false;
+        simplex[2] = static_cast<std::uint32_t>(i);
+    }
+
+    const ei::Vec3& c = points[simplex[2]];
+    const auto normal = cross(line, difference(c, a));
+    simplex[3] = parallelArgmax(count, [&](std::size_t i) {
+        return std::fabs(dot(normal, difference(points[i], a)));
+    }).first;
+    if (orient3d(a, b, c, points[simplex[3]]) == 0)
+    {
+        std::size_t i = 0;
+        while (i < count && orient3d(a, b, c, points[i]) == 0)
+            ++i;
+        if (i == count)
+            return false;
+        simplex[3] = static_cast<std::uint32_t>(i);
+    }
+    return true;
+}
+
+std::uint32_t HullBuilder3D::addFace(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+{
+    std::uint32_t index;
+    if (freeFaces.empty())
+    {
+        index = static_cast<std::uint32_t>(faces.size());
+        faces.emplace_back();
+        twin.resize(twin.size() + 3, NONE);
+    }
+    else
+    {
+        index = freeFaces.back();
+        freeFaces.pop_back();
+        faces[index] = Face();
+    }
+    Face& face = faces[index];
+    face.vertex = {a, b, c};
+    const auto u = difference(points[b], points[a]);
+    const auto v = difference(points[c], points[a]);
+    face.normal = cross(u, v);
+    face.permanent = {std::fabs(u[1] * v[2]) + std::fabs(u[2] * v[1]), std::fabs(u[2] * v[0]) + std::fabs(u[0] * v[2]),
+                      std::fabs(u[0] * v[1]) + std::fabs(u[1] * v[0])};
+    return index;
+}
+
+void HullBuilder3D::link(std::uint32_t edge, std::uint32_t twinEdge)
+{
+    twin[edge] = twinEdge;
+    twin[twinEdge] = edge;
+}
+
+void HullBuilder3D::addConflict(std::uint32_t face, std::uint32_t point)
+{
+    Face& f = faces[face];
+    nextOutside[point] = f.outside;
+    f.outside = point;
+    const double distance = dot(f.normal, difference(points[point], points[f.vertex[0]]));
+    if (f.farthest == NONE || distance > f.farthestDistance)
+    {
+        f.farthest = point;
+        f.farthestDistance = distance;
+    }
+}
+
+std::uint32_t HullBuilder3D::firstFaceAbove(std::span<const std::uint32_t> candidates, std::uint32_t point) const
+{
+    for (std::uint32_t face : candidates)
+    {
+        if (above(face, point))
+            return face;
+    }
+    return NONE;
+}
+
+// Assigns every point of the list to the first candidate face it is above, points above none are inside the hull
+void HullBuilder3D::distribute(std::span<const std::uint32_t> pointList, std::span<const std::uint32_t> candidates)
+{
+    if (pointList.size() < PARALLEL_CUTOFF)
+    {
+        for (std::uint32_t point : pointList)
+        {
+            const std::uint32_t face = firstFaceAbove(candidates, point);
+            if (face != NONE)
+                addConflict(face, point);
+        }
+        return;
+    }
+
+    // The tests dominate, so only they run in parallel and the lists are linked afterwards
+    const std::int64_t size = static_cast<std::int64_t>(pointList.size());
+    #pragma omp parallel for default(none) shared(size, pointList, candidates) schedule(static)
+    for (std::int64_t i = 0; i < size; ++i)
+        owner[pointList[i]] = firstFaceAbove(candidates, pointList[i]);
+    for (std::uint32_t point : pointList)
+    {
+        if (owner[point] != NONE)
+            addConflict(owner[point], point);
+    }
+}
+
+// Adds the farthest conflict point of the face to the hull
+void HullBuilder3D::addPoint(std::uint32_t face)
+{
+    const std::uint32_t eye = faces[face].farthest;
+
+    // Visible faces (connected, starting at the face) and the horizon edges to the hidden faces around them
+    ++search;
+    visibleFaces.clear();
+    horizon.clear();
+    faces[face].visited = search;
+    faces[face].visible = true;
+    stack.assign(1, face);
+    while (!stack.empty())
+    {
+        const std::uint32_t current = stack.back();
+        stack.pop_back();
+        visibleFaces.push_back(current);
+        for (std::uint32_t k = 0; k < 3; ++k)
+        {
+            const std::uint32_t edge = 3 * current + k;
+            const std::uint32_t neighbour = twin[edge] / 3;
+            Face& other = faces[neighbour];
+            if (other.visited != search)
+            {
+                other.visited = search;
+                other.visible = above(neighbour, eye);
+                if (other.visible)
+                    stack.push_back(neighbour);
+            }
+            if (!other.visible)
+                horizon.push_back({faces[current].vertex[k], faces[current].vertex[(k + 1) % 3], twin[edge]});
+        }
+    }
+
+    // The conflict points of the visible faces are redistributed, the faces themselves are reused
+    pending.clear();
+    for (std::uint32_t visible : visibleFaces)
+    {
+        for (std::uint32_t point = faces[visible].outside; point != NONE; point = nextOutside[point])
+        {
+            if (point != eye)
+                pending.push_back(point);
+        }
+        faces[visible].alive = false;
+        freeFaces.push_back(visible);
+    }
+
+    // A cone of new faces from the horizon to the eye: edge 0 lies on the horizon, edge 1 (b -> eye) is the twin of
+    // edge 2 (eye -> b) of the new face whose horizon edge starts at b
+    newFaces.clear();
+    for (const HorizonEdge& edge : horizon)
+    {
+        const std::uint32_t created = addFace(edge.a, edge.b, eye);
+        link(3 * created, edge.twin);
+        newFaceAt[edge.a] = created;
+        newFaces.push_back(created);
+    }
+    for (std::uint32_t created : newFaces)
+        link(3 * created + 1, 3 * newFaceAt[faces[created].vertex[1]] + 2);
+
+    distribute(pending, newFaces);
+    for (std::uint32_t created : newFaces)
+    {
+        if (faces[created].outside != NONE)
+            work.push_back(created);
+    }
+}
+
+std::vector<std::uint32_t> HullBuilder3D::build()
+{
+    std::array<std::uint32_t, 4> simplex{};
+    if (points.size() < 4 || !initialSimplex(simplex))
+        return {};
+
+    // Orient the tetrahedron, so that every face is counterclockwise seen from outside
+    auto [a, b, c, d] = simplex;
+    if (orient3d(points[a], points[b], points[c], points[d]) < 0)
+        std::swap(b, c);
+    const std::uint32_t tetrahedron[4][3] = {{a, b, c}, {a, d, b}, {b, d, c}, {c, d, a}};
+    for (const auto& face : tetrahedron)
+        addFace(face[0], face[1], face[2]);
+    for (std::uint32_t edge = 0; edge < 12; ++edge)
+    {
+        for (std::uint32_t other = 0; other < 12; ++other)
+        {
+            if (faces[edge / 3].vertex[edge % 3] == faces[other / 3].vertex[(other % 3 + 1) % 3] &&
+                faces[edge / 3].vertex[(edge % 3 + 1) % 3] == faces[other / 3].vertex[other % 3])
+                twin[edge] = other;
+        }
+    }
+
+    // Initial partition of all points to the 4 faces
+    const std::uint32_t initialFaces[4] = {0, 1, 2, 3};
+    const std::int64_t size = static_cast<std::int64_t>(points.size());
+    #pragma omp parallel for default(none) shared(size, initialFaces) schedule(static)
+    for (std::int64_t i = 0; i < size; ++i)
+        owner[i] = firstFaceAbove(initialFaces, static_cast<std::uint32_t>(i));
+    for (std::uint32_t point = 0; point < points.size(); ++point)
+    {
+        if (owner[point] != NONE)
+            addConflict(owner[point], point);
+    }
+    for (std::uint32_t face = 0; face < 4; ++face)
+    {
+        if (faces[face].outside != NONE)
+            work.push_back(face);
+    }
+
+    while (!work.empty())
+    {
+        const std::uint32_t face = work.back();
+        work.pop_back();
+        // Deleted faces and faces that were reused since they were queued
+        if (faces[face].alive && faces[face].outside != NONE)
+            addPoint(face);
+    }
+
+    std::vector<std::uint32_t> triangles;
+    for (const Face& face : faces)
+    {
+        if (face.alive)
+            triangles.insert(triangles.end(), face.vertex.begin(), face.vertex.end());
+    }
+    return triangles;
+}
+
+std::vector<std::uint32_t> quick_hull_3d(std::span<const ei::Vec3> points)
+{
+    if (points.size() > UINT32_MAX)
+        throw std::invalid_argument("quick_hull_3d supports at most " + std::to_string(UINT32_MAX) + " points.");
+    return HullBuilder3D(points).build();
+}
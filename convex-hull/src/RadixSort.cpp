@@ -0,0 +1,76 @@
+﻿#include "RadixSort.h"
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <omp.h>
+
+constexpr unsigned int RADIX_BITS = 8;
+constexpr unsigned int RADIX_BUCKETS = 1u << RADIX_BITS;
+constexpr unsigned int RADIX_PASSES = 64 / RADIX_BITS;
+
+void radix_sort_points(std::vector<ei::Vec2>& points)
+{
+    const size_t size = points.size();
+    if (size < 2)
+        return;
+
+    // NOTE: Default-initialized (no zeroing), the pages are first touched by the threads encoding/scattering into them
+    std::unique_ptr<uint64_t[]> keyStorage(new uint64_t[size]);
+    std::unique_ptr<uint64_t[]> bufferStorage(new uint64_t[size]);
+    uint64_t* keys = keyStorage.get();
+    uint64_t* buffer = bufferStorage.get();
+    std::vector<std::array<size_t, RADIX_BUCKETS>> histograms(omp_get_max_threads());
+    bool skipPass = false;
+
+    #pragma omp parallel default(none) shared(points, size, keys, buffer, histograms, skipPass)
+    {
+        const size_t threads = omp_get_num_threads();
+        const size_t thread = omp_get_thread_num();
+        // Contiguous block per thread, so the scatter of equal digits keeps the thread (= input) order
+        const size_t begin = size * thread / threads;
+        const size_t end = size * (thread + 1) / threads;
+
+        for (size_t i = begin; i < end; ++i)
+            keys[i] = (static_cast<uint64_t>(floatToSortable(points[i].x)) << 32) | floatToSortable(points[i].y);
+
+        for (unsigned int pass = 0; pass < RADIX_PASSES; ++pass) {
+            const unsigned int shift = pass * RADIX_BITS;
+            auto& histogram = histograms[thread];
+            histogram.fill(0);
+            for (size_t i = begin; i < end; ++i)
+                ++histogram[(keys[i] >> shift) & (RADIX_BUCKETS - 1)];
+            #pragma omp barrier
+
+            // Exclusive prefix sum in (digit, thread) order, histograms become output offsets
+            #pragma omp single
+            {
+                size_t offset = 0;
+                skipPass = false;
+                for (unsigned int digit = 0; digit < RADIX_BUCKETS; ++digit) {
+                    size_t count = 0;
+                    for (size_t t = 0; t < threads; ++t) {
+                        const size_t threadCount = histograms[t][digit];
+                        histograms[t][digit] = offset;
+                        offset += threadCount;
+                        count += threadCount;
+                    }
+                    skipPass |= count == size;
+                }
+            }
+
+            if (skipPass)
+                continue; // Uniform decision of all threads (shared value, no writes until the next single)
+
+            for (size_t i = begin; i < end; ++i)
+                buffer[histogram[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++] = keys[i];
+            #pragma omp barrier
+            #pragma omp single
+            std::swap(keys, buffer);
+        }
+
+        for (size_t i = begin; i < end; ++i)
+            points[i] = ei::Vec2(sortableToFloat(static_cast<uint32_t>(keys[i] >> 32)),
+                                 sortableToFloat(static_cast<uint32_t>(keys[i])));
+    }
+}
@@ -0,0 +1,403 @@
+﻿#include "SimdKernels.h"
+#include "Predicates.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+// Line AB as origin and direction, cross(P) = dx * (P.y - ay) - dy * (P.x - ax) (same operations as pointLocation).
+// Compiled without FMA contraction (CMakeLists.txt), so A and B themselves always get an exact 0
+struct Line {
+    ei::Vec2 A, B;
+    float ax, ay, dx, dy;
+};
+
+static inline Line makeLine(const ei::Vec2& A, const ei::Vec2& B) {
+    return {A, B, A.x, A.y, B.x - A.x, B.y - A.y};
+}
+
+static inline int orientation(const Line& line, float x, float y) {
+    return orient2d(line.A, line.B, ei::Vec2(x, y));
+}
+
+// The farthest point search evaluates the cross product in double: the differences and products of float
+// coordinates are exact, so only the final subtraction rounds and the order of the distances is kept.
+// The farthest point then is a corner of the hull even if all points lie within float rounding of AB
+static inline double distance(const Line& line, float x, float y) {
+    return (static_cast<double>(line.B.x) - line.A.x) * (static_cast<double>(y) - line.A.y)
+         - (static_cast<double>(line.B.y) - line.A.y) * (static_cast<double>(x) - line.A.x);
+}
+
+// Ties of the farthest point search are broken by coordinates, so the result is always a corner of the hull
+// (never a point in the middle of an edge parallel to AB) and independent of the order of the points
+static inline bool isFarther(double cross, double x, double y, double bestCross, double bestX, double bestY) {
+    return cross > bestCross || (cross == bestCross && (x < bestX || (x == bestX && y < bestY)));
+}
+
+// Best candidate of a farthest point search, starts with no candidate (only points strictly left of AB qualify)
+struct Farthest {
+    double cross = 0.0;
+    float x = -std::numeric_limits<float>::infinity();
+    float y = -std::numeric_limits<float>::infinity();
+    std::size_t index;
+};
+
+// Scalar kernels, also used for the tails of the vector loops (starting at begin)
+
+static void orientationScalar(const float* x, const float* y, std::size_t begin, std::size_t count,
+                              const Line& line, std::int8_t* orientations) {
+    for (std::size_t i = begin; i < count; ++i)
+        orientations[i] = static_cast<std::int8_t>(orientation(line, x[i], y[i]));
+}
+
+static void farthestScalar(const float* x, const float* y, std::size_t begin, std::size_t count,
+                           const Line& line, Farthest& best) {
+    for (std::size_t i = begin; i < count; ++i) {
+        const double cross = distance(line, x[i], y[i]);
+        if (isFarther(cross, x[i], y[i], best.cross, best.x, best.y))
+            best = {cross, x[i], y[i], i};
+    }
+}
+
+static std::size_t partitionScalar(float* x, float* y, std::size_t begin, std::size_t count, const Line& line,
+                                   float* leftX, float* leftY, std::size_t left, std::size_t rest) {
+    for (std::size_t i = begin; i < count; ++i) {
+        const float px = x[i];
+        const float py = y[i];
+        if (orientation(line, px, py) > 0) {
+            leftX[left] = px;
+            leftY[left] = py;
+            ++left;
+        } else {
+            x[rest] = px;
+            y[rest] = py;
+            ++rest;
+        }
+    }
+    return left;
+}
+
+static void orientationDefault(const float* x, const float* y, std::size_t count, const Line& line,
+                               std::int8_t* orientations) {
+    orientationScalar(x, y, 0, count, line, orientations);
+}
+
+static std::size_t farthestDefault(const float* x, const float* y, std::size_t count, const Line& line) {
+    Farthest best{.index = count};
+    farthestScalar(x, y, 0, count, line, best);
+    return best.index;
+}
+
+static std::size_t partitionDefault(float* x, float* y, std::size_t count, const Line& line,
+                                    float* leftX, float* leftY) {
+    return partitionScalar(x, y, 0, count, line, leftX, leftY, 0, 0);
+}
+
+#ifdef SIMD_KERNELS_X86
+
+// Byte j is 0xFF if bit j of the index is set, turns 8 compare bits into 8 orientation bytes
+static constexpr std::array<std::uint64_t, 256> BYTE_MASKS = [] {
+    std::array<std::uint64_t, 256> masks{};
+    for (unsigned bits = 0; bits < 256; ++bits)
+        for (unsigned lane = 0; lane < 8; ++lane)
+            if (bits & (1u << lane))
+                masks[bits] |= std::uint64_t{0xFF} << (8 * lane);
+    return masks;
+}();
+
+static inline void storeOrientations(unsigned positive, unsigned negative, std::int8_t* orientations) {
+    const std::uint64_t bytes = (BYTE_MASKS[positive] & 0x0101010101010101ull) | BYTE_MASKS[negative];
+    std::memcpy(orientations, &bytes, sizeof(bytes));
+}
+
+// The vector loops evaluate the cross product in float and compare it against the error bound of
+// orient2dFloatFiltered (Predicates.h), including its absolute term for products that underflow. Lanes whose sign is
+// not certain (also NaN) are decided by the exact predicate one by one
+
+// Bits of the uncertain lanes whose point lies exactly left of AB
+static inline unsigned exactLeftLanes(const Line& line, const float* x, const float* y, unsigned uncertain) {
+    unsigned left = 0;
+    for (; uncertain; uncertain &= uncertain - 1) {
+        const int lane = std::countr_zero(uncertain);
+        if (orientation(line, x[lane], y[lane]) > 0)
+            left |= 1u << lane;
+    }
+    return left;
+}
+
+// Lane permutations that move the lanes with a set bit to the front (in order), for compaction with AVX2
+struct alignas(32) Permutation {
+    std::int32_t lanes[8];
+};
+
+static constexpr std::array<Permutation, 256> COMPACT_PERMUTATIONS = [] {
+    std::array<Permutation, 256> permutations{};
+    for (unsigned bits = 0; bits < 256; ++bits) {
+        unsigned next = 0;
+        for (unsigned lane = 0; lane < 8; ++lane)
+            if (bits & (1u << lane))
+                permutations[bits].lanes[next++] = static_cast<std::int32_t>(lane);
+        while (next < 8)
+            permutations[bits].lanes[next++] = 0;
+    }
+    return permutations;
+}();
+
+__attribute__((target("avx2")))
+static void orientationAvx2(const float* x, const float* y, std::size_t count, const Line& line,
+                            std::int8_t* orientations) {
+    const __m256 ax = _mm256_set1_ps(line.ax), ay = _mm256_set1_ps(line.ay);
+    const __m256 dx = _mm256_set1_ps(line.dx), dy = _mm256_set1_ps(line.dy);
+    const __m256 errorBound = _mm256_set1_ps(ORIENT2D_FLOAT_ERROR_BOUND), underflowBound = _mm256_set1_ps(0x1p-100f);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 left = _mm256_mul_ps(dx, _mm256_sub_ps(_mm256_loadu_ps(y + i), ay));
+        const __m256 right = _mm256_mul_ps(dy, _mm256_sub_ps(_mm256_loadu_ps(x + i), ax));
+        const __m256 cross = _mm256_sub_ps(left, right);
+        const __m256 bound = _mm256_add_ps(_mm256_mul_ps(errorBound, _mm256_add_ps(_mm256_andnot_ps(signBit, left),
+                                                                                   _mm256_andnot_ps(signBit, right))),
+                                           underflowBound);
+        const unsigned positive = _mm256_movemask_ps(_mm256_cmp_ps(cross, bound, _CMP_GT_OQ));
+        const unsigned negative = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_xor_ps(cross, signBit), bound, _CMP_GT_OQ));
+        const unsigned uncertain = ~(positive | negative) & 0xFFu;
+        storeOrientations(positive, negative, orientations + i);
+        for (unsigned bits = uncertain; bits; bits &= bits - 1) {
+            const std::size_t lane = i + std::countr_zero(bits);
+            orientations[lane] = static_cast<std::int8_t>(orientation(line, x[lane], y[lane]));
+        }
+    }
+    orientationScalar(x, y, i, count, line, orientations);
+}
+
+__attribute__((target("avx2")))
+static std::size_t farthestAvx2(const float* x, const float* y, std::size_t count, const Line& line) {
+    const __m256d ax = _mm256_set1_pd(line.A.x), ay = _mm256_set1_pd(line.A.y);
+    const __m256d dx = _mm256_set1_pd(static_cast<double>(line.B.x) - line.A.x);
+    const __m256d dy = _mm256_set1_pd(static_cast<double>(line.B.y) - line.A.y);
+    // Every lane keeps its own candidate (same comparison as isFarther), they are combined after the loop
+    const __m256d start = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    __m256d bestCross = _mm256_setzero_pd(), bestX = start, bestY = start;
+    __m256i best = _mm256_set1_epi64x(-1);
+    __m256i index = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i step = _mm256_set1_epi64x(4);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d px = _mm256_cvtps_pd(_mm_loadu_ps(x + i));
+        const __m256d py = _mm256_cvtps_pd(_mm_loadu_ps(y + i));
+        const __m256d cross = _mm256_sub_pd(_mm256_mul_pd(dx, _mm256_sub_pd(py, ay)),
+                                            _mm256_mul_pd(dy, _mm256_sub_pd(px, ax)));
+        const __m256d smaller = _mm256_or_pd(_mm256_cmp_pd(px, bestX, _CMP_LT_OQ),
+                                             _mm256_and_pd(_mm256_cmp_pd(px, bestX, _CMP_EQ_OQ),
+                                                           _mm256_cmp_pd(py, bestY, _CMP_LT_OQ)));
+        const __m256d farther = _mm256_or_pd(_mm256_cmp_pd(cross, bestCross, _CMP_GT_OQ),
+                                             _mm256_and_pd(_mm256_cmp_pd(cross, bestCross, _CMP_EQ_OQ), smaller));
+        bestCross = _mm256_blendv_pd(bestCross, cross, farther);
+        bestX = _mm256_blendv_pd(bestX, px, farther);
+        bestY = _mm256_blendv_pd(bestY, py, farther);
+        best = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(best), _mm256_castsi256_pd(index), farther));
+        index = _mm256_add_epi64(index, step);
+    }
+
+    alignas(32) double laneCross[4], laneX[4], laneY[4];
+    alignas(32) std::int64_t laneBest[4];
+    _mm256_store_pd(laneCross, bestCross);
+    _mm256_store_pd(laneX, bestX);
+    _mm256_store_pd(laneY, bestY);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(laneBest), best);
+    Farthest result{.index = count};
+    for (int lane = 0; lane < 4; ++lane) {
+        if (laneBest[lane] >= 0 && isFarther(laneCross[lane], laneX[lane], laneY[lane], result.cross, result.x, result.y))
+            result = {laneCross[lane], static_cast<float>(laneX[lane]), static_cast<float>(laneY[lane]),
+                      static_cast<std::size_t>(laneBest[lane])};
+    }
+    farthestScalar(x, y, i, count, line, result);
+    return result.index;
+}
+
+__attribute__((target("avx2")))
+static std::size_t partitionAvx2(float* x, float* y, std::size_t count, const Line& line,
+                                 float* leftX, float* leftY) {
+    const __m256 ax = _mm256_set1_ps(line.ax), ay = _mm256_set1_ps(line.ay);
+    const __m256 dx = _mm256_set1_ps(line.dx), dy = _mm256_set1_ps(line.dy);
+    const __m256 errorBound = _mm256_set1_ps(ORIENT2D_FLOAT_ERROR_BOUND), underflowBound = _mm256_set1_ps(0x1p-100f);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    std::size_t leftCount = 0, restCount = 0, i = 0;
+    // Both outputs are written as full vectors behind their last point, which is safe as leftCount + restCount == i:
+    // the left output holds count points, the rest overwrites only input that has already been loaded
+    for (; i + 8 <= count; i += 8) {
+        const __m256 px = _mm256_loadu_ps(x + i);
+        const __m256 py = _mm256_loadu_ps(y + i);
+        const __m256 left = _mm256_mul_ps(dx, _mm256_sub_ps(py, ay));
+        const __m256 right = _mm256_mul_ps(dy, _mm256_sub_ps(px, ax));
+        const __m256 cross = _mm256_sub_ps(left, right);
+        const __m256 bound = _mm256_add_ps(_mm256_mul_ps(errorBound, _mm256_add_ps(_mm256_andnot_ps(signBit, left),
+                                                                                   _mm256_andnot_ps(signBit, right))),
+                                           underflowBound);
+        const unsigned positive = _mm256_movemask_ps(_mm256_cmp_ps(cross, bound, _CMP_GT_OQ));
+        const unsigned negative = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_xor_ps(cross, signBit), bound, _CMP_GT_OQ));
+        const unsigned uncertain = ~(positive | negative) & 0xFFu;
+        const unsigned mask = positive | (uncertain ? exactLeftLanes(line, x + i, y + i, uncertain) : 0u);
+        const __m256i toLeft = _mm256_load_si256(reinterpret_cast<const __m256i*>(&COMPACT_PERMUTATIONS[mask]));
+        const __m256i toRest = _mm256_load_si256(reinterpret_cast<const __m256i*>(&COMPACT_PERMUTATIONS[mask ^ 0xFFu]));
+        _mm256_storeu_ps(leftX + leftCount, _mm256_permutevar8x32_ps(px, toLeft));
+        _mm256_storeu_ps(leftY + leftCount, _mm256_permutevar8x32_ps(py, toLeft));
+        _mm256_storeu_ps(x + restCount, _mm256_permutevar8x32_ps(px, toRest));
+        _mm256_storeu_ps(y + restCount, _mm256_permutevar8x32_ps(py, toRest));
+        const unsigned lanes = std::popcount(mask);
+        leftCount += lanes;
+        restCount += 8 - lanes;
+    }
+    return partitionScalar(x, y, i, count, line, leftX, leftY, leftCount, restCount);
+}
+
+__attribute__((target("avx512f")))
+static void orientationAvx512(const float* x, const float* y, std::size_t count, const Line& line,
+                              std::int8_t* orientations) {
+    const __m512 ax = _mm512_set1_ps(line.ax), ay = _mm512_set1_ps(line.ay);
+    const __m512 dx = _mm512_set1_ps(line.dx), dy = _mm512_set1_ps(line.dy);
+    const __m512 errorBound = _mm512_set1_ps(ORIENT2D_FLOAT_ERROR_BOUND), underflowBound = _mm512_set1_ps(0x1p-100f);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512 left = _mm512_mul_ps(dx, _mm512_sub_ps(_mm512_loadu_ps(y + i), ay));
+        const __m512 right = _mm512_mul_ps(dy, _mm512_sub_ps(_mm512_loadu_ps(x + i), ax));
+        const __m512 cross = _mm512_sub_ps(left, right);
+        const __m512 bound = _mm512_add_ps(_mm512_mul_ps(errorBound, _mm512_add_ps(_mm512_abs_ps(left), _mm512_abs_ps(right))),
+                                           underflowBound);
+        const unsigned positive = _mm512_cmp_ps_mask(cross, bound, _CMP_GT_OQ);
+        const unsigned negative = _mm512_cmp_ps_mask(_mm512_sub_ps(_mm512_setzero_ps(), cross), bound, _CMP_GT_OQ);
+        const unsigned uncertain = ~(positive | negative) & 0xFFFFu;
+        storeOrientations(positive & 0xFFu, negative & 0xFFu, orientations + i);
+        storeOrientations(positive >> 8, negative >> 8, orientations + i + 8);
+        for (unsigned bits = uncertain; bits; bits &= bits - 1) {
+            const std::size_t lane = i + std::countr_zero(bits);
+            orientations[lane] = static_cast<std::int8_t>(orientation(line, x[lane], y[lane]));
+        }
+    }
+    orientationScalar(x, y, i, count, line, orientations);
+}
+
+__attribute__((target("avx512f")))
+static std::size_t farthestAvx512(const float* x, const float* y, std::size_t count, const Line& line) {
+    const __m512d ax = _mm512_set1_pd(line.A.x), ay = _mm512_set1_pd(line.A.y);
+    const __m512d dx = _mm512_set1_pd(static_cast<double>(line.B.x) - line.A.x);
+    const __m512d dy = _mm512_set1_pd(static_cast<double>(line.B.y) - line.A.y);
+    const __m512d start = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+    __m512d bestCross = _mm512_setzero_pd(), bestX = start, bestY = start;
+    __m512i best = _mm512_set1_epi64(-1);
+    __m512i index = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m512i step = _mm512_set1_epi64(8);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d px = _mm512_cvtps_pd(_mm256_loadu_ps(x + i));
+        const __m512d py = _mm512_cvtps_pd(_mm256_loadu_ps(y + i));
+        const __m512d cross = _mm512_sub_pd(_mm512_mul_pd(dx, _mm512_sub_pd(py, ay)),
+                                            _mm512_mul_pd(dy, _mm512_sub_pd(px, ax)));
+        const __mmask8 smaller = _mm512_cmp_pd_mask(px, bestX, _CMP_LT_OQ) |
+                                 (_mm512_cmp_pd_mask(px, bestX, _CMP_EQ_OQ) & _mm512_cmp_pd_mask(py, bestY, _CMP_LT_OQ));
+        const __mmask8 farther = _mm512_cmp_pd_mask(cross, bestCross, _CMP_GT_OQ) |
+                                 (_mm512_cmp_pd_mask(cross, bestCross, _CMP_EQ_OQ) & smaller);
+        bestCross = _mm512_mask_mov_pd(bestCross, farther, cross);
+        bestX = _mm512_mask_mov_pd(bestX, farther, px);
+        bestY = _mm512_mask_mov_pd(bestY, farther, py);
+        best = _mm512_mask_mov_epi64(best, farther, index);
+        index = _mm512_add_epi64(index, step);
+    }
+
+    alignas(64) double laneCross[8], laneX[8], laneY[8];
+    alignas(64) std::int64_t laneBest[8];
+    _mm512_store_pd(laneCross, bestCross);
+    _mm512_store_pd(laneX, bestX);
+    _mm512_store_pd(laneY, bestY);
+    _mm512_store_si512(laneBest, best);
+    Farthest result{.index = count};
+    for (int lane = 0; lane < 8; ++lane) {
+        if (laneBest[lane] >= 0 && isFarther(laneCross[lane], laneX[lane], laneY[lane], result.cross, result.x, result.y))
+            result = {laneCross[lane], static_cast<float>(laneX[lane]), static_cast<float>(laneY[lane]),
+                      static_cast<std::size_t>(laneBest[lane])};
+    }
+    farthestScalar(x, y, i, count, line, result);
+    return result.index;
+}
+
+__attribute__((target("avx512f")))
+static std::size_t partitionAvx512(float* x, float* y, std::size_t count, const Line& line,
+                                   float* leftX, float* leftY) {
+    const __m512 ax = _mm512_set1_ps(line.ax), ay = _mm512_set1_ps(line.ay);
+    const __m512 dx = _mm512_set1_ps(line.dx), dy = _mm512_set1_ps(line.dy);
+    const __m512 errorBound = _mm512_set1_ps(ORIENT2D_FLOAT_ERROR_BOUND), underflowBound = _mm512_set1_ps(0x1p-100f);
+    std::size_t leftCount = 0, restCount = 0, i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512 px = _mm512_loadu_ps(x + i);
+        const __m512 py = _mm512_loadu_ps(y + i);
+        const __m512 left = _mm512_mul_ps(dx, _mm512_sub_ps(py, ay));
+        const __m512 right = _mm512_mul_ps(dy, _mm512_sub_ps(px, ax));
+        const __m512 cross = _mm512_sub_ps(left, right);
+        const __m512 bound = _mm512_add_ps(_mm512_mul_ps(errorBound, _mm512_add_ps(_mm512_abs_ps(left), _mm512_abs_ps(right))),
+                                           underflowBound);
+        const unsigned positive = _mm512_cmp_ps_mask(cross, bound, _CMP_GT_OQ);
+        const unsigned negative = _mm512_cmp_ps_mask(_mm512_sub_ps(_mm512_setzero_ps(), cross), bound, _CMP_GT_OQ);
+        const unsigned uncertain = ~(positive | negative) & 0xFFFFu;
+        const __mmask16 mask = static_cast<__mmask16>(
+            positive | (uncertain ? exactLeftLanes(line, x + i, y + i, uncertain) : 0u));
+        _mm512_mask_compressstoreu_ps(leftX + leftCount, mask, px);
+        _mm512_mask_compressstoreu_ps(leftY + leftCount, mask, py);
+        _mm512_mask_compressstoreu_ps(x + restCount, static_cast<__mmask16>(~mask), px);
+        _mm512_mask_compressstoreu_ps(y + restCount, static_cast<__mmask16>(~mask), py);
+        const unsigned lanes = std::popcount(static_cast<unsigned>(mask));
+        leftCount += lanes;
+        restCount += 16 - lanes;
+    }
+    return partitionScalar(x, y, i, count, line, leftX, leftY, leftCount, restCount);
+}
+
+#endif
+
+struct KernelSet {
+    const char* name;
+    void (*orientation)(const float*, const float*, std::size_t, const Line&, std::int8_t*);
+    std::size_t (*farthest)(const float*, const float*, std::size_t, const Line&);
+    std::size_t (*partition)(float*, float*, std::size_t, const Line&, float*, float*);
+};
+
+static KernelSet selectKernels() {
+#ifdef SIMD_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return {"AVX-512", orientationAvx512, farthestAvx512, partitionAvx512};
+    if (__builtin_cpu_supports("avx2"))
+        return {"AVX2", orientationAvx2, farthestAvx2, partitionAvx2};
+#endif
+    return {"scalar", orientationDefault, farthestDefault, partitionDefault};
+}
+
+static const KernelSet& kernels() {
+    static const KernelSet kernelSet = selectKernels();
+    return kernelSet;
+}
+
+void orientation_kernel(const float* x, const float* y, std::size_t count,
+                        const ei::Vec2& A, const ei::Vec2& B, std::int8_t* orientations) {
+    kernels().orientation(x, y, count, makeLine(A, B), orientations);
+}
+
+std::size_t farthest_point_kernel(const float* x, const float* y, std::size_t count,
+                                  const ei::Vec2& A, const ei::Vec2& B) {
+    return kernels().farthest(x, y, count, makeLine(A, B));
+}
+
+std::size_t partition_kernel(float* x, float* y, std::size_t count, const ei::Vec2& A, const ei::Vec2& B,
+                             float* leftX, float* leftY) {
+    return kernels().partition(x, y, count, makeLine(A, B), leftX, leftY);
+}
+
+const char* simd_kernel_name() {
+    return kernels().name;
+}
@@ -0,0 +1,41 @@
+﻿#include "StreamHull.h"
+
+#include <future>
+#include <utility>
+
+#include "ConvexHull.h"
+#include "PointIO.h"
+
+std::vector<ei::Vec2> stream_hull(Algorithm algorithm, const std::string& filename, std::size_t chunkBytes,
+                                  StreamHullStats* stats)
+{
+    PointFileReader reader(filename, chunkBytes);
+    std::vector<ei::Vec2> hull;
+    std::vector<ei::Vec2> chunk;
+    std::vector<ei::Vec2> nextChunk;
+    std::size_t chunks = 0;
+
+    bool available = reader.next(chunk);
+    while (available)
+    {
+        // Read ahead while this chunk is hulled, the reader is only used by one thread at a time
+        std::future<bool> pending = std::async(std::launch::async, [&reader, &nextChunk] { return reader.next(nextChunk); });
+
+        // The running hull points are part of the chunk, so the chunk hull is the hull of everything read so far
+        chunk.insert(chunk.end(), hull.begin(), hull.end());
+        // NOTE: If this throws, the destructor of pending waits for the read ahead
+        hull = computeHull(algorithm, chunk);
+        ++chunks;
+
+        available = pending.get();
+        std::swap(chunk, nextChunk);
+    }
+
+    if (stats != nullptr)
+    {
+        stats->points = reader.pointsRead();
+        stats->bytes = reader.bytesRead();
+        stats->chunks = chunks;
+    }
+    return hull;
+}
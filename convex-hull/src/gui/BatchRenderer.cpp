@@ -0,0 +1,303 @@
+﻿#include "BatchRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_set>
+
+#include "app.h"
+
+constexpr float GLYPH_PADDING = 1.f;                ///< Texture padding around glyphs (as sf::Text) against bleeding
+constexpr std::size_t MAX_DETAIL_LEVELS = 24;       ///< Cells of 2^22 units, far beyond any window
+constexpr std::size_t MIN_DETAIL_POINTS = 1 << 16;  ///< No coarser levels are built for fewer points
+constexpr double MAX_BITMAP_CELLS_PER_POINT = 8;    ///< Decimation uses a bitmap of the grid up to this size
+constexpr double MAX_CELL_COORDINATE = 0x1p61;      ///< Decimation cell coordinates are clamped to +-2^61
+
+sf::FloatRect viewBounds(const sf::RenderWindow& window)
+{
+    const sf::View& view = window.getView();
+    return {view.getCenter().x - view.getSize().x / 2, view.getCenter().y - view.getSize().y / 2,
+            view.getSize().x, view.getSize().y};
+}
+
+VertexBatch::VertexBatch(sf::PrimitiveType type, sf::VertexBuffer::Usage usage) : type_(type), buffer_(type, usage)
+{
+}
+
+void VertexBatch::setPrimitiveType(sf::PrimitiveType type)
+{
+    type_ = type;
+    buffer_.setPrimitiveType(type);
+}
+
+void VertexBatch::upload()
+{
+    uploaded_ = false;
+    if (vertices_.empty() || !sf::VertexBuffer::isAvailable())
+        return;
+    // Grow by doubling, a step usually adds a few vertices
+    if (buffer_.getVertexCount() < vertices_.size() &&
+        !buffer_.create(std::max(vertices_.size(), 2 * buffer_.getVertexCount())))
+        return;
+    uploaded_ = buffer_.update(vertices_.data(), vertices_.size(), 0);
+}
+
+void VertexBatch::draw(sf::RenderWindow& window, const sf::RenderStates& states) const
+{
+    if (vertices_.empty())
+        return;
+    if (uploaded_)
+        window.draw(buffer_, 0, vertices_.size(), states);
+    else
+        window.draw(vertices_.data(), vertices_.size(), type_, states);
+}
+
+void LabelBatch::add(const std::string& text, sf::Vector2f pixel, const sf::Color& color)
+{
+    if (!font_)
+        return;
+    const float lineSpacing = font_->getLineSpacing(LABEL_CHARACTER_SIZE);
+    float x = pixel.x;
+    float y = pixel.y + LABEL_CHARACTER_SIZE; // Baseline of the first line
+    auto& vertices = batch_.vertices();
+    for (const char character : text)
+    {
+        if (character == '\n')
+        {
+            x = pixel.x;
+            y += lineSpacing;
+            continue;
+        }
+        // getGlyph adds missing glyphs to the atlas, the texture coordinates (pixels) stay valid when it grows
+        const sf::Glyph& glyph = font_->getGlyph(static_cast<unsigned char>(character), LABEL_CHARACTER_SIZE, false);
+        if (glyph.textureRect.width > 0 && glyph.textureRect.height > 0)
+        {
+            const float left = x + glyph.bounds.left - GLYPH_PADDING;
+            const float top = y + glyph.bounds.top - GLYPH_PADDING;
+            const float right = x + glyph.bounds.left + glyph.bounds.width + GLYPH_PADDING;
+            const float bottom = y + glyph.bounds.top + glyph.bounds.height + GLYPH_PADDING;
+            const float u1 = static_cast<float>(glyph.textureRect.left) - GLYPH_PADDING;
+            const float v1 = static_cast<float>(glyph.textureRect.top) - GLYPH_PADDING;
+            const float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + GLYPH_PADDING;
+            const float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + GLYPH_PADDING;
+            const sf::Vertex topLeft({left, top}, color, {u1, v1}), topRight({right, top}, color, {u2, v1});
+            const sf::Vertex bottomLeft({left, bottom}, color, {u1, v2}), bottomRight({right, bottom}, color, {u2, v2});
+            vertices.insert(vertices.end(), {topLeft, topRight, bottomLeft, bottomLeft, topRight, bottomRight});
+        }
+        x += glyph.advance;
+    }
+}
+
+void LabelBatch::draw(sf::RenderWindow& window) const
+{
+    if (!font_ || batch_.size() == 0)
+        return;
+    const sf::View view = window.getView();
+    window.setView(window.getDefaultView());
+    sf::RenderStates states;
+    states.texture = &font_->getTexture(LABEL_CHARACTER_SIZE);
+    batch_.draw(window, states);
+    window.setView(view);
+}
+
+void PointIndex::build(const std::vector<sf::Vector2f>& positions)
+{
+    clear();
+    entries_.reserve(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        if (std::isfinite(positions[i].x) && std::isfinite(positions[i].y))
+            entries_.push_back({positions[i], static_cast<std::uint32_t>(i)});
+    }
+    std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) { return a.position.x < b.position.x; });
+
+    for (std::size_t first = 0; first < entries_.size(); first += POINT_INDEX_BLOCK_SIZE)
+    {
+        const auto begin = entries_.begin() + static_cast<std::ptrdiff_t>(first);
+        const auto end = entries_.begin() + static_cast<std::ptrdiff_t>(std::min(first + POINT_INDEX_BLOCK_SIZE, entries_.size()));
+        blockMinX_.push_back(begin->position.x);
+        blockMaxX_.push_back((end - 1)->position.x);
+        std::sort(begin, end, [](const Entry& a, const Entry& b) { return a.position.y < b.position.y; });
+    }
+}
+
+void PointIndex::clear()
+{
+    entries_.clear();
+    blockMinX_.clear();
+    blockMaxX_.clear();
+}
+
+bool PointIndex::query(const sf::FloatRect& bounds, std::size_t limit, std::vector<std::uint32_t>& visible) const
+{
+    visible.clear();
+    const float minX = std::min(bounds.left, bounds.left + bounds.width);
+    const float maxX = std::max(bounds.left, bounds.left + bounds.width);
+    const float minY = std::min(bounds.top, bounds.top + bounds.height);
+    const float maxY = std::max(bounds.top, bounds.top + bounds.height);
+
+    // The blocks are sorted by x among each other, so the ones overlapping [minX, maxX] are contiguous
+    for (std::size_t block = std::lower_bound(blockMaxX_.begin(), blockMaxX_.end(), minX) - blockMaxX_.begin();
+         block < blockMinX_.size() && blockMinX_[block] <= maxX; ++block)
+    {
+        const auto begin = entries_.begin() + static_cast<std::ptrdiff_t>(block * POINT_INDEX_BLOCK_SIZE);
+        const auto end = entries_.begin() + static_cast<std::ptrdiff_t>(std::min((block + 1) * POINT_INDEX_BLOCK_SIZE, entries_.size()));
+        auto entry = std::lower_bound(begin, end, minY, [](const Entry& a, float y) { return a.position.y < y; });
+        for (; entry != end && entry->position.y <= maxY; ++entry)
+        {
+            if (!bounds.contains(entry->position))
+                continue;
+            visible.push_back(entry->index);
+            if (visible.size() > limit)
+                return false;
+        }
+    }
+    std::sort(visible.begin(), visible.end());
+    return true;
+}
+
+// Grid cell of a decimation level as column and row
+struct Cell
+{
+    std::int64_t column;
+    std::int64_t row;
+    bool operator==(const Cell& other) const { return column == other.column && row == other.row; }
+};
+
+struct CellHash
+{
+    std::size_t operator()(const Cell& cell) const
+    {
+        return std::hash<std::uint64_t>{}(static_cast<std::uint64_t>(cell.column) * 0x9E3779B97F4A7C15ull
+                                          ^ static_cast<std::uint64_t>(cell.row));
+    }
+};
+
+/**
+ * Keeps the first point of every grid cell. Cell coordinates are computed in double and clamped to
+ * +-MAX_CELL_COORDINATE, so far outliers share the border cells and differences of cell coordinates can not overflow.
+ * Points with non-finite coordinates are dropped (they can not be drawn).
+ */
+static std::vector<sf::Vertex> decimate(const std::vector<sf::Vertex>& vertices, float cellSize)
+{
+    std::vector<sf::Vertex> kept;
+    auto finite = [](const sf::Vertex& vertex) { return std::isfinite(vertex.position.x) && std::isfinite(vertex.position.y); };
+    auto coordinateOf = [cellSize](float coordinate) {
+        const double cell = std::floor(static_cast<double>(coordinate) / cellSize);
+        return static_cast<std::int64_t>(std::clamp(cell, -MAX_CELL_COORDINATE, MAX_CELL_COORDINATE));
+    };
+    auto cellOf = [&](const sf::Vertex& vertex) { return Cell{coordinateOf(vertex.position.x), coordinateOf(vertex.position.y)}; };
+
+    const auto first = std::find_if(vertices.begin(), vertices.end(), finite);
+    if (first == vertices.end())
+        return kept;
+    Cell min = cellOf(*first), max = min;
+    for (const auto& vertex : vertices)
+    {
+        if (!finite(vertex))
+            continue;
+        const Cell cell = cellOf(vertex);
+        min = {std::min(min.column, cell.column), std::min(min.row, cell.row)};
+        max = {std::max(max.column, cell.column), std::max(max.row, cell.row)};
+    }
+
+    // The cells of the bounding box as bitmap if there are not many more cells than points, otherwise hashed
+    const double columns = static_cast<double>(max.column - min.column + 1);
+    const double cells = columns * static_cast<double>(max.row - min.row + 1);
+    if (cells <= static_cast<double>(vertices.size()) * MAX_BITMAP_CELLS_PER_POINT)
+    {
+        std::vector<bool> occupied(static_cast<std::size_t>(cells));
+        for (const auto& vertex : vertices)
+        {
+            if (!finite(vertex))
+                continue;
+            const Cell cell = cellOf(vertex);
+            const auto index = static_cast<std::size_t>((cell.row - min.row) * static_cast<std::int64_t>(columns)
+                                                        + cell.column - min.column);
+            if (!occupied[index])
+            {
+                occupied[index] = true;
+                kept.push_back(vertex);
+            }
+        }
+        return kept;
+    }
+
+    std::unordered_set<Cell, CellHash> occupied;
+    occupied.reserve(vertices.size());
+    for (const auto& vertex : vertices)
+    {
+        if (finite(vertex) && occupied.insert(cellOf(vertex)).second)
+            kept.push_back(vertex);
+    }
+    return kept;
+}
+
+void PointCloud::setPoints(const std::vector<ei::Vec2>& points)
+{
+    points_ = points;
+    levels_.clear();
+    labelsValid_ = false;
+
+    Level all{0.f, VertexBatch(sf::Points, sf::VertexBuffer::Static)};
+    all.points.vertices().reserve(points.size());
+    std::vector<sf::Vector2f> positions;
+    positions.reserve(points.size());
+    for (const auto& point : points)
+    {
+        all.points.vertices().emplace_back(sf::Vector2f(point.x, point.y), sf::Color::White);
+        positions.emplace_back(point.x, point.y);
+    }
+    levels_.push_back(std::move(all));
+    labelIndex_.build(positions);
+
+    // Each level decimates the previous one (the grids are nested), down to a few points for zooming out
+    for (float cellSize = 1.f; levels_.back().points.size() > MIN_DETAIL_POINTS && levels_.size() < MAX_DETAIL_LEVELS;
+         cellSize *= 2)
+    {
+        Level level{cellSize, VertexBatch(sf::Points, sf::VertexBuffer::Static)};
+        level.points.vertices() = decimate(levels_.back().points.vertices(), cellSize);
+        levels_.push_back(std::move(level));
+    }
+    for (auto& level : levels_)
+    {
+        level.points.upload();
+    }
+}
+
+void PointCloud::draw(sf::RenderWindow& window)
+{
+    if (levels_.empty())
+        return;
+
+    // Size of a pixel in world units
+    const float pixelSize = window.getView().getSize().x / static_cast<float>(window.getSize().x);
+    std::size_t level = 0;
+    while (level + 1 < levels_.size() &&
+           (levels_[level + 1].cellSize <= pixelSize || levels_[level].points.size() > POINT_BUDGET))
+    {
+        ++level;
+    }
+    levels_[level].points.draw(window);
+
+    const sf::FloatRect bounds = viewBounds(window);
+    if (!labelsValid_ || bounds != labelBounds_)
+    {
+        labels_.clear();
+        std::vector<std::uint32_t> visible;
+        if (labelIndex_.query(bounds, MAX_VISIBLE_LABELS, visible))
+        {
+            for (const std::uint32_t index : visible)
+            {
+                const ei::Vec2& point = points_[index];
+                const sf::Vector2i pixel = window.mapCoordsToPixel(sf::Vector2f(point.x, point.y));
+                labels_.add("X: " + formatFloat(point.x, 2) + "\nY: " + formatFloat(point.y, 2),
+                            sf::Vector2f(static_cast<float>(pixel.x), static_cast<float>(pixel.y)));
+            }
+        }
+        labels_.upload();
+        labelBounds_ = bounds;
+        labelsValid_ = true;
+    }
+    labels_.draw(window);
+}
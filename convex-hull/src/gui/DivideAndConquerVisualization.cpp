@@ -0,0 +1,119 @@
+﻿#include <algorithm>
+
+#include "DivideAndConquer.h"
+#include "Visualizations.h"
+
+static inline bool lexicographicLess(const ei::Vec2& a, const ei::Vec2& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Adds the edges of the sub-hull (chains at upper and lower) as indicator lines
+static void addSubHull(VisualDelta& visual, const ei::Vec2* upper, size_t upperCount,
+                       const ei::Vec2* lower, size_t lowerCount, const sf::Color& color)
+{
+    std::vector<ei::Vec2> hull = chainsToHull(upper, upperCount, lower, lowerCount);
+    if (hull.size() == 1)
+    {
+        visual.addHighlight(sf::Vector2f(hull[0].x, hull[0].y), "", color);
+        return;
+    }
+    const size_t edges = hull.size() == 2 ? 1 : hull.size();
+    for (size_t i = 0; i < edges; ++i)
+    {
+        const ei::Vec2& from = hull[i];
+        const ei::Vec2& to = hull[(i + 1) % hull.size()];
+        visual.addIndicatorLine(sf::Vector2f(from.x, from.y), sf::Vector2f(to.x, to.y), color);
+    }
+}
+
+AlgorithmGenerator divide_and_conquer_visualization(const INPUT_PARAMETER& points)
+{
+    VisualDelta visual;
+
+    if (points.size() < 3)
+    {
+        visual.setExplanation("Point cloud has less than 3 points. Convex hull is the point cloud itself.");
+        for (const auto& point : points)
+        {
+            visual.addHullPoint(sf::Vector2f(point.x, point.y));
+            visual.addHighlight(sf::Vector2f(point.x, point.y), "P", sf::Color::Blue);
+            co_yield visual;
+        }
+        co_return;
+    }
+
+    std::vector<ei::Vec2> upper(points);
+    std::sort(upper.begin(), upper.end(), lexicographicLess);
+    upper.erase(std::unique(upper.begin(), upper.end()), upper.end());
+    std::vector<ei::Vec2> lower(upper);
+    const size_t size = upper.size();
+
+    visual.setExplanation("Sorting points by x-coordinate. Every point is a sub-hull of its own.");
+    for (size_t i = 0; i < size; ++i)
+    {
+        visual.addHighlight(sf::Vector2f(upper[i].x, upper[i].y), std::to_string(i), sf::Color::Blue);
+    }
+    co_yield visual;
+    visual.clearHighlights();
+
+    // Bottom-up version of buildHull: neighboring sub-hulls of width points are merged level by level
+    std::vector<std::pair<size_t, size_t>> counts(size, {1, 1});
+    for (size_t width = 1; width < size; width *= 2)
+    {
+        for (size_t first = 0; first + width < size; first += 2 * width)
+        {
+            const size_t middle = first + width;
+            auto& left = counts[first];
+            const auto& right = counts[middle];
+
+            visual.clearIndicatorLines();
+            visual.clearHighlights();
+            addSubHull(visual, &upper[first], left.first, &lower[first], left.second, sf::Color::Blue);
+            addSubHull(visual, &upper[middle], right.first, &lower[middle], right.second, sf::Color::Green);
+            visual.setExplanation("Merging left (blue) and right (green) sub-hull.");
+            co_yield visual;
+
+            auto [upperLeft, upperRight] = findTangent(&upper[first], left.first, &upper[middle], right.first, 1);
+            const ei::Vec2 A = upper[first + upperLeft], B = upper[middle + upperRight];
+            visual.addIndicatorLine(sf::Vector2f(A.x, A.y), sf::Vector2f(B.x, B.y), sf::Color::Yellow);
+            visual.addHighlight(sf::Vector2f(A.x, A.y), "Upper tangent", sf::Color::Yellow);
+            visual.addHighlight(sf::Vector2f(B.x, B.y), "Upper tangent", sf::Color::Yellow);
+            visual.setExplanation("Found upper tangent: no point lies above the line.");
+            co_yield visual;
+
+            auto [lowerLeft, lowerRight] = findTangent(&lower[first], left.second, &lower[middle], right.second, -1);
+            const ei::Vec2 C = lower[first + lowerLeft], D = lower[middle + lowerRight];
+            visual.addIndicatorLine(sf::Vector2f(C.x, C.y), sf::Vector2f(D.x, D.y), sf::Color::Magenta);
+            visual.addHighlight(sf::Vector2f(C.x, C.y), "Lower tangent", sf::Color::Magenta);
+            visual.addHighlight(sf::Vector2f(D.x, D.y), "Lower tangent", sf::Color::Magenta);
+            visual.setExplanation("Found lower tangent: no point lies below the line.");
+            co_yield visual;
+
+            left = {joinChains(&upper[first], upperLeft, &upper[middle], upperRight, right.first),
+                    joinChains(&lower[first], lowerLeft, &lower[middle], lowerRight, right.second)};
+
+            visual.clearIndicatorLines();
+            visual.clearHighlights();
+            addSubHull(visual, &upper[first], left.first, &lower[first], left.second, sf::Color::Red);
+            visual.setExplanation("Merged sub-hull: points between the tangents are removed.");
+            co_yield visual;
+        }
+    }
+
+    // Final convex hull visualization
+    std::vector<ei::Vec2> convexHull = chainsToHull(upper.data(), counts[0].first, lower.data(), counts[0].second);
+    visual.clearHighlights();
+    visual.clearIndicatorLines();
+    visual.clearHullPoints();
+    for (const auto& point : convexHull)
+    {
+        visual.addHullPoint(sf::Vector2f(point.x, point.y));
+    }
+    // Close the loop by adding the first point at the end
+    visual.addHullPoint(sf::Vector2f(convexHull.front().x, convexHull.front().y));
+    visual.setExplanation("Convex hull construction complete.");
+    visual.finished = true;
+    co_yield visual;
+
+    co_return;
+}
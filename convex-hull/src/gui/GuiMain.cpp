@@ -0,0 +1,317 @@
+﻿#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <SFML/Graphics.hpp>
+#include <SFML/Window/Event.hpp>
+
+#include "app.h"
+#include "BatchRenderer.h"
+#include "VisualAlgorithm.h"
+#include "VisualTrace.h"
+#include "Visualizations.h"
+
+constexpr float ZOOM_STEP = 1.25f; ///< Zoom factor of one mouse wheel step
+
+// Loads the font for all texts
+static bool loadFont(sf::Font& font)
+{
+    // Font file path is relative to binary output. CMakelists.txt copies the font file to the binary directory.
+    if (!font.loadFromFile("../resources/FiraCodeNerdFontMono-Retina.ttf"))
+    {
+        std::cerr << "Error loading font\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Zooms with the mouse wheel (the point under the cursor stays in place), pans while the right mouse button is held
+ * and resets the view with V. Returns true if the event was used.
+ */
+static bool handleViewEvent(sf::RenderWindow& window, const sf::Event& event, std::optional<sf::Vector2i>& drag)
+{
+    if (event.type == sf::Event::MouseWheelScrolled)
+    {
+        const sf::Vector2i pixel(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+        const sf::Vector2f before = window.mapPixelToCoords(pixel);
+        sf::View view = window.getView();
+        view.zoom(event.mouseWheelScroll.delta > 0 ? 1 / ZOOM_STEP : ZOOM_STEP);
+        view.move(before - window.mapPixelToCoords(pixel, view));
+        window.setView(view);
+        return true;
+    }
+    if ((event.type == sf::Event::MouseButtonPressed || event.type == sf::Event::MouseButtonReleased)
+        && event.mouseButton.button == sf::Mouse::Right)
+    {
+        if (event.type == sf::Event::MouseButtonPressed)
+            drag = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+        else
+            drag.reset();
+        return true;
+    }
+    if (event.type == sf::Event::MouseMoved && drag)
+    {
+        const sf::Vector2i pixel(event.mouseMove.x, event.mouseMove.y);
+        sf::View view = window.getView();
+        view.move(window.mapPixelToCoords(*drag) - window.mapPixelToCoords(pixel));
+        window.setView(view);
+        drag = pixel;
+        return true;
+    }
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::V)
+    {
+        window.setView(window.getDefaultView());
+        return true;
+    }
+    return false;
+}
+
+int gui_main(Algorithm algorithm, std::vector<ei::Vec2>* loadedPoints)
+{
+    sf::RenderWindow window(sf::VideoMode(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT), "APRG - Convex Hull");
+    // Center position (for resetting shape positions)
+    sf::Vector2f windowCenter = {WINDOW_DEFAULT_WIDTH / 2.f, WINDOW_DEFAULT_HEIGHT / 2.f};
+
+    sf::Font font;
+    if (!loadFont(font))
+    {
+        return EXIT_FAILURE;
+    }
+
+    PointCloud cloud(font);
+    std::vector<ei::Vec2> points;
+    std::optional<sf::Vector2i> drag;
+
+    // Create algorithm holder for step visualization
+    const auto visualization = visualization_for(algorithm);
+    if (!visualization)
+    {
+        std::cerr << "No visualization available for " << algorithmToString(algorithm) << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+    VisualAlgorithm alg_holder(visualization);
+    alg_holder.setFont(font);
+
+    // Handle pre-loaded points
+    if(loadedPoints)
+    {
+        points = *loadedPoints;
+        cloud.setPoints(points);
+        alg_holder.setInput(points);
+    }
+
+    // Main loop
+    while (window.isOpen())
+    {
+        // Handle events
+        sf::Event event{};
+        while (window.pollEvent(event))
+        {
+            // Close window : exit
+            if (event.type == sf::Event::Closed)
+                window.close();
+
+            if (handleViewEvent(window, event, drag))
+                continue;
+
+            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left)
+            {
+                if (alg_holder.IsStarted())
+                {
+                    std::cout << "Cannot add points after algorithm calculation started. Please complete calculation." << std::endl;
+                    continue;
+                }
+                // Get mouse position
+                sf::Vector2i mousePosWindow = sf::Mouse::getPosition(window);
+                sf::Vector2f mousePos = window.mapPixelToCoords(mousePosWindow);
+                points.emplace_back(mousePos.x, mousePos.y);
+                cloud.setPoints(points);
+                std::cout << "Added point at: (" << mousePos.x << "," << mousePos.y << ")" << std::endl;
+                alg_holder.setInput(points);
+            }
+
+            if (event.type == sf::Event::KeyPressed)
+            {
+                switch (event.key.code)
+                {
+                case sf::Keyboard::Enter:
+                    alg_holder.runAlgorithm();
+                    break;
+                case sf::Keyboard::Space:
+                    alg_holder.visualStep();
+                    break;
+                case sf::Keyboard::N:
+                    alg_holder.skipToHullVertex();
+                    break;
+                case sf::Keyboard::R:
+                    std::cout << "Resetting algorithm" << std::endl;
+                    alg_holder.reset();
+                    break;
+                default:
+                    std::cout << "Key: " << event.key.code << " not used/supported" << std::endl;
+                    break;
+                }
+            }
+        }
+
+        // Clear the window with a black color
+        window.clear(sf::Color::Black);
+
+        cloud.draw(window);
+        alg_holder.draw(window);
+
+        window.display();
+    }
+    return EXIT_SUCCESS;
+}
+
+int record_trace_main(Algorithm algorithm, std::vector<ei::Vec2>& points, const std::string& traceFile)
+{
+    const auto visualization = visualization_for(algorithm);
+    if (!visualization)
+    {
+        std::cerr << "No visualization available for " << algorithmToString(algorithm) << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    std::size_t steps = 0;
+    try
+    {
+        steps = VisualTrace::record(algorithm, visualization, points, traceFile);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Recorded " << steps << " steps of " << algorithmToString(algorithm) << " on " << points.size()
+              << " points in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms to trace file: "
+              << traceFile << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int replay_trace_main(const std::string& traceFile)
+{
+    VisualTrace trace;
+    try
+    {
+        trace = VisualTrace::load(traceFile);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (trace.size() == 0)
+    {
+        std::cerr << "Trace file has no steps: " << traceFile << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Loaded " << trace.size() << " steps of " << algorithmToString(trace.algorithm()) << " on "
+              << trace.points().size() << " points." << std::endl;
+
+    sf::RenderWindow window(sf::VideoMode(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT), "APRG - Convex Hull (Replay)");
+    sf::Font font;
+    if (!loadFont(font))
+    {
+        return EXIT_FAILURE;
+    }
+
+    PointCloud cloud(font);
+    cloud.setPoints(trace.points());
+    std::optional<sf::Vector2i> drag;
+
+    sf::Text status;
+    status.setFont(font);
+    status.setCharacterSize(12);
+    status.setFillColor(sf::Color::White);
+    status.setPosition(10, WINDOW_DEFAULT_HEIGHT - 24); // bottom-left
+
+    // Shows the step: the next step is applied to the shown visual, any other step is built from the closest keyframe
+    Visual visual;
+    std::size_t current = trace.size(); // Nothing shown yet
+    auto show = [&](std::size_t step) {
+        if (step == current)
+            return;
+        if (current < trace.size() && step == current + 1)
+        {
+            trace.apply(step, visual);
+        }
+        else
+        {
+            visual = Visual();
+            visual.setFont(font);
+            trace.seek(step, visual);
+        }
+        current = step;
+        status.setString("Step " + std::to_string(current + 1) + " / " + std::to_string(trace.size())
+                         + "   Left/Right: step, PageUp/PageDown: 1%, Home/End: first/last, N/B: next/previous hull vertex");
+    };
+    show(0);
+
+    const std::size_t last = trace.size() - 1;
+    const std::size_t jump = std::max<std::size_t>(1, trace.size() / 100);
+    while (window.isOpen())
+    {
+        sf::Event event{};
+        while (window.pollEvent(event))
+        {
+            if (event.type == sf::Event::Closed)
+                window.close();
+
+            if (handleViewEvent(window, event, drag) || event.type != sf::Event::KeyPressed)
+                continue;
+            switch (event.key.code)
+            {
+            case sf::Keyboard::Right:
+                show(std::min(current + 1, last));
+                break;
+            case sf::Keyboard::Left:
+                show(current > 0 ? current - 1 : 0);
+                break;
+            case sf::Keyboard::PageDown:
+                show(std::min(current + jump, last));
+                break;
+            case sf::Keyboard::PageUp:
+                show(current > jump ? current - jump : 0);
+                break;
+            case sf::Keyboard::Home:
+                show(0);
+                break;
+            case sf::Keyboard::End:
+                show(last);
+                break;
+            case sf::Keyboard::N:
+            {
+                std::size_t step = current + 1;
+                while (step < last && !trace.step(step).addsHullPoint())
+                    ++step;
+                show(std::min(step, last));
+                break;
+            }
+            case sf::Keyboard::B:
+            {
+                std::size_t step = current;
+                while (step > 0 && !trace.step(--step).addsHullPoint()) {}
+                show(step);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        window.clear(sf::Color::Black);
+        cloud.draw(window);
+        visual.draw(window);
+        const sf::View view = window.getView();
+        window.setView(window.getDefaultView());
+        window.draw(status);
+        window.setView(view);
+        window.display();
+    }
+    return EXIT_SUCCESS;
+}
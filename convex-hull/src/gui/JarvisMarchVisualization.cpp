@@ -0,0 +1,128 @@
+﻿#include "JarvisMarch.h"
+#include "Visualizations.h"
+
+AlgorithmGenerator jarvis_march_visualization(INPUT_PARAMETER& points)
+{
+    VisualDelta visual;
+    unsigned int point_count = points.size();
+
+    if (point_count < 3)
+    {
+        visual.setExplanation("Point cloud has less than 3 points. Convex hull is the point cloud itself.");
+        for (const auto& point : points)
+        {
+            visual.addHullPoint(sf::Vector2f(point.x, point.y), sf::Color::Green);
+            visual.addHighlight(sf::Vector2f(point.x, point.y), "P", sf::Color::Blue);
+            co_yield visual;
+        }
+        co_return;
+    }
+
+    // Find the leftmost point
+    visual.setExplanation("Finding the leftmost point.");
+    unsigned int leftmost = 0;
+    visual.addHighlight(sf::Vector2f(points[leftmost].x, points[leftmost].y), "Initial Point", sf::Color::Red);
+    co_yield visual;
+
+    for (unsigned int i = 1; i < point_count; i++)
+    {
+        if (points[i].x < points[leftmost].x)
+        {
+            // Remove previous highlight
+            visual.removeHighlight(sf::Vector2f(points[leftmost].x, points[leftmost].y));
+
+            leftmost = i;
+            visual.addHighlight(sf::Vector2f(points[leftmost].x, points[leftmost].y), "New Leftmost Point", sf::Color::Red);
+            co_yield visual;
+        }
+    }
+    visual.clearHighlights();
+    visual.setExplanation("Found leftmost as starting point for algorithm.");
+    visual.addHighlight(sf::Vector2f(points[leftmost].x, points[leftmost].y), "The Leftmost Point", sf::Color::Magenta);
+    co_yield visual;
+    visual.clearHighlights();
+
+    std::vector<ei::Vec2> convexHull;
+    unsigned int p = leftmost, q;
+
+    do
+    {
+        // Highlight current point p
+        visual.addHighlight(sf::Vector2f(points[p].x, points[p].y), "Hull Point P", sf::Color::Red);
+        visual.setExplanation("Hull point P selected.");
+        convexHull.push_back(points[p]);
+        // Visualize current convex hull (only the new point is sent, not the whole hull)
+        visual.addHullPoint(sf::Vector2f(points[p].x, points[p].y));
+        co_yield visual;
+
+        q = (p + 1) % point_count;
+
+        // Highlight candidate point q
+        visual.addHighlight(sf::Vector2f(points[q].x, points[q].y), "Candidate Q", sf::Color::Yellow);
+        visual.setExplanation("Selected candidate point Q.");
+        co_yield visual;
+
+        for (unsigned int i = 0; i < point_count; i++)
+        {
+            if (i == p || i == q)
+                continue;
+
+            // Clear indicator lines
+            visual.clearIndicatorLines();
+
+            // Draw indicator lines between p-q and p-i
+            visual.addIndicatorLine(sf::Vector2f(points[p].x, points[p].y), sf::Vector2f(points[q].x, points[q].y), sf::Color::Blue);
+            visual.addIndicatorLine(sf::Vector2f(points[p].x, points[p].y), sf::Vector2f(points[i].x, points[i].y), sf::Color::Green);
+
+            // Highlight point i being considered
+            visual.addHighlight(sf::Vector2f(points[i].x, points[i].y), "Probe I", sf::Color::Cyan);
+            visual.setExplanation("Checking orientation between P, I, and Q.");
+            co_yield visual;
+            visual.removeHighlight(sf::Vector2f(points[i].x, points[i].y));
+
+            int orientation = check_orientation(points[p], points[i], points[q]);
+
+            if (orientation == ORIENTATION_COUNTERCLOCKWISE)
+            {
+                // Remove previous highlight for q
+                visual.removeHighlight(sf::Vector2f(points[q].x, points[q].y));
+
+                // Update q
+                q = i;
+
+                // Highlight new candidate q
+                visual.addHighlight(sf::Vector2f(points[q].x, points[q].y), "New Candidate Q", sf::Color::Yellow);
+                visual.setExplanation("Found more counterclockwise point. Updating Q.");
+                co_yield visual;
+            }
+        }
+
+        // Clear after comparisons
+        visual.clearIndicatorLines();
+        visual.clearHighlights();
+
+        // Move to next point
+        p = q;
+        visual.addHighlight(sf::Vector2f(points[p].x, points[p].y), "Next Point P", sf::Color::Magenta);
+        // Optional: Yield to show movement to next point
+        visual.setExplanation("P is on Hull. Selected as next point P.");
+        co_yield visual;
+        visual.removeHighlight(sf::Vector2f(points[p].x, points[p].y));
+    } while (p != leftmost); // While we don't come back to the first point
+
+    // Final convex hull visualization
+    visual.clearHighlights();
+    visual.clearIndicatorLines();
+    visual.clearHullPoints();
+    for (const auto& point : convexHull)
+    {
+        visual.addHullPoint(sf::Vector2f(point.x, point.y));
+    }
+    // Close the loop by adding the first point at the end
+    visual.addHullPoint(sf::Vector2f(convexHull.front().x, convexHull.front().y));
+    visual.setExplanation("Convex hull construction complete.");
+    visual.finished = true;
+    co_yield visual;
+
+    co_return;
+}
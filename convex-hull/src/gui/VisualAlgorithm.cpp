@@ -0,0 +1,228 @@
+﻿//
+// Created by RINI on 25/09/2024.
+//
+
+#include "VisualAlgorithm.h"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+
+constexpr float HIGHLIGHT_RADIUS = 5.f;         ///< Highlights are octagons of this radius around the point
+constexpr int HIGHLIGHT_CORNERS = 8;
+constexpr float HIGHLIGHT_TEXT_OFFSET = 30.f;   ///< Texts of the highlights are shown below the point
+
+void Visual::rebuildBatches() const
+{
+    hull_batch_.vertices().assign(current_hull.begin(), current_hull.end());
+    hull_batch_.upload();
+
+    auto& lines = line_batch_.vertices();
+    lines.clear();
+    for (const auto& line : indicator_lines)
+    {
+        lines.emplace_back(line.start, line.color);
+        lines.emplace_back(line.end, line.color);
+    }
+    line_batch_.upload();
+
+    // Many highlights (e.g. while partitioning all points) are single pixels instead of octagons
+    static const std::array<sf::Vector2f, HIGHLIGHT_CORNERS> corners = [] {
+        std::array<sf::Vector2f, HIGHLIGHT_CORNERS> result;
+        for (int i = 0; i < HIGHLIGHT_CORNERS; ++i)
+        {
+            const float angle = 2 * std::numbers::pi_v<float> * static_cast<float>(i) / HIGHLIGHT_CORNERS;
+            result[i] = sf::Vector2f(HIGHLIGHT_RADIUS * std::cos(angle), HIGHLIGHT_RADIUS * std::sin(angle));
+        }
+        return result;
+    }();
+    auto& shapes = highlight_batch_.vertices();
+    shapes.clear();
+    if (highlights.size() > MAX_HIGHLIGHT_SHAPES)
+    {
+        highlight_batch_.setPrimitiveType(sf::Points);
+        for (const auto& highlight : highlights)
+        {
+            shapes.emplace_back(highlight.position, highlight.color);
+        }
+    }
+    else
+    {
+        highlight_batch_.setPrimitiveType(sf::Triangles);
+        shapes.reserve(highlights.size() * HIGHLIGHT_CORNERS * 3);
+        for (const auto& highlight : highlights)
+        {
+            for (int i = 0; i < HIGHLIGHT_CORNERS; ++i)
+            {
+                shapes.emplace_back(highlight.position, highlight.color);
+                shapes.emplace_back(highlight.position + corners[i], highlight.color);
+                shapes.emplace_back(highlight.position + corners[(i + 1) % HIGHLIGHT_CORNERS], highlight.color);
+            }
+        }
+    }
+    highlight_batch_.upload();
+
+    dirty_ = false;
+    labels_dirty_ = true;
+    label_index_valid_ = false;
+}
+
+bool Visual::visibleLabels(const sf::FloatRect& bounds, std::vector<const Highlight*>& visible) const
+{
+    // After a step one scan (like rebuilding the batches), the index only pays off once the view moves
+    if (labels_dirty_)
+    {
+        for (const auto& highlight : highlights)
+        {
+            if (highlight.text.empty() || !bounds.contains(highlight.position))
+                continue;
+            visible.push_back(&highlight);
+            if (visible.size() > MAX_VISIBLE_LABELS)
+                return false;
+        }
+        return true;
+    }
+
+    if (!label_index_valid_)
+    {
+        labeled_highlights_.clear();
+        std::vector<sf::Vector2f> positions;
+        for (std::size_t slot = 0; slot < highlights.size(); ++slot)
+        {
+            if (highlights[slot].text.empty())
+                continue;
+            labeled_highlights_.push_back(static_cast<std::uint32_t>(slot));
+            positions.push_back(highlights[slot].position);
+        }
+        label_index_.build(positions);
+        label_index_valid_ = true;
+    }
+    std::vector<std::uint32_t> indices;
+    if (!label_index_.query(bounds, MAX_VISIBLE_LABELS, indices))
+        return false;
+    for (const std::uint32_t index : indices)
+        visible.push_back(&highlights[labeled_highlights_[index]]);
+    return true;
+}
+
+void Visual::draw(sf::RenderWindow& window) const
+{
+    if (dirty_)
+        rebuildBatches();
+    hull_batch_.draw(window);
+    highlight_batch_.draw(window);
+    line_batch_.draw(window);
+
+    const sf::FloatRect bounds = viewBounds(window);
+    if (labels_dirty_ || bounds != label_bounds_)
+    {
+        labels_.clear();
+        std::vector<const Highlight*> visible;
+        if (visibleLabels(bounds, visible))
+        {
+            for (const Highlight* highlight : visible)
+            {
+                const sf::Vector2i pixel = window.mapCoordsToPixel(
+                    sf::Vector2f(highlight->position.x, highlight->position.y + HIGHLIGHT_TEXT_OFFSET));
+                labels_.add(highlight->text, sf::Vector2f(static_cast<float>(pixel.x), static_cast<float>(pixel.y)));
+            }
+        }
+        labels_.upload();
+        label_bounds_ = bounds;
+        labels_dirty_ = false;
+    }
+    labels_.draw(window);
+
+    // The explanation stays in the top-left corner of the window
+    const sf::View view = window.getView();
+    window.setView(window.getDefaultView());
+    window.draw(explanation);
+    window.setView(view);
+}
+
+VisualAlgorithm::VisualAlgorithm(const std::function<AlgorithmGenerator(INPUT_PARAMETER&)>& generator_func)
+{
+    algorithm_ = generator_func;
+}
+
+void VisualAlgorithm::setInput(const INPUT_PARAMETER& input_data)
+{
+    input_data_ = input_data;
+}
+
+void VisualAlgorithm::setFont(const sf::Font& font)
+{
+    font_ = font;
+}
+
+void VisualAlgorithm::draw(sf::RenderWindow& window) const
+{
+    if(started_)
+    {
+        visualization_.draw(window);
+    }
+}
+
+void VisualAlgorithm::visualStep()
+{
+    const VisualDelta* delta = step();
+    if (delta)
+    {
+        std::cout << "Step '" << delta->explanation << "' completed." << std::endl;
+    }
+    else
+    {
+        std::cout << "Algorithm finished. Press R to reset." << std::endl;
+    }
+}
+
+const VisualDelta* VisualAlgorithm::step()
+{
+    if (!started_) {
+        // Initialize the coroutine only once, the first resume runs it to its first `co_yield`
+        generator_ = algorithm_(input_data_);
+        visualization_ = Visual();
+        visualization_.setFont(font_);
+        started_ = true;
+    }
+
+    if (!generator_.coro || generator_.done()) {
+        return nullptr;
+    }
+
+    const VisualDelta* delta = generator_.next();
+    if (delta) {
+        visualization_.apply(*delta);
+    }
+    return delta;
+}
+
+void VisualAlgorithm::skipToHullVertex()
+{
+    const VisualDelta* delta = step();
+    while (delta && !delta->addsHullPoint())
+    {
+        delta = step();
+    }
+    std::cout << (delta ? "Skipped to next hull vertex: '" + delta->explanation + "'" : "Algorithm finished.") << std::endl;
+}
+
+void VisualAlgorithm::runAlgorithm()
+{
+    size_t steps = 0;
+    while (step())
+    {
+        ++steps;
+    }
+    std::cout << "Algorithm finished after " << steps << " remaining steps." << std::endl;
+}
+
+void VisualAlgorithm::reset()
+{
+    if (started_) {
+        // The destructor of AlgorithmGenerator will destroy the coroutine
+        generator_ = {}; // Reset the generator, destroying the old coroutine
+        visualization_ = Visual();
+        started_ = false;
+    }
+}
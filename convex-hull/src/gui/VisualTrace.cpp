@@ -0,0 +1,383 @@
+﻿#include "VisualTrace.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+constexpr std::size_t MIN_KEYFRAME_CHANGES = 1024;            ///< Changes between two keyframes at least (for small visuals)
+constexpr std::size_t TRACE_WRITE_BUFFER_SIZE = 1 << 20;       ///< Recorded steps are written in blocks of about 1 MiB
+constexpr std::streamoff TRACE_STEP_COUNT_OFFSET = sizeof(TRACE_FILE_MAGIC) + 4 + 1; ///< After magic, version, algorithm
+
+static inline void writeByte(std::string& out, std::uint8_t value)
+{
+    out.push_back(static_cast<char>(value));
+}
+
+static inline void writeVarint(std::string& out, std::uint64_t value)
+{
+    for (; value >= 0x80; value >>= 7)
+        writeByte(out, static_cast<std::uint8_t>(value | 0x80));
+    writeByte(out, static_cast<std::uint8_t>(value));
+}
+
+static inline void writeFloat(std::string& out, float value)
+{
+    std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    for (int i = 0; i < 4; ++i, bits >>= 8)
+        writeByte(out, static_cast<std::uint8_t>(bits & 0xFF));
+}
+
+static inline void writePosition(std::string& out, const sf::Vector2f& position)
+{
+    writeFloat(out, position.x);
+    writeFloat(out, position.y);
+}
+
+static inline void writeColor(std::string& out, const sf::Color& color)
+{
+    writeByte(out, color.r);
+    writeByte(out, color.g);
+    writeByte(out, color.b);
+    writeByte(out, color.a);
+}
+
+// Reads the data of a trace file, every read checks the end of the data
+class TraceReader
+{
+public:
+    TraceReader(const std::vector<char>& data, const std::string& filename)
+        : position_(data.data()), end_(data.data() + data.size()), filename_(filename) {}
+
+    std::uint8_t byte()
+    {
+        require(1);
+        return static_cast<std::uint8_t>(*position_++);
+    }
+    std::uint64_t varint()
+    {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            const std::uint8_t next = byte();
+            value |= static_cast<std::uint64_t>(next & 0x7F) << shift;
+            if (!(next & 0x80))
+                return value;
+        }
+        throw std::runtime_error("Error reading trace file (invalid number): " + filename_);
+    }
+    // Counts are checked against the remaining bytes (each element takes at least one byte), so a broken file can not
+    // make the reader allocate huge vectors
+    std::size_t count()
+    {
+        return count(varint());
+    }
+    std::size_t count(std::uint64_t value)
+    {
+        if (value > static_cast<std::uint64_t>(end_ - position_))
+            throw std::runtime_error("Error reading trace file (truncated): " + filename_);
+        return static_cast<std::size_t>(value);
+    }
+    // Index into the texts, which are read after the steps (so the index is checked by the caller)
+    std::uint32_t index()
+    {
+        const std::uint64_t value = varint();
+        if (value > UINT32_MAX)
+            throw std::runtime_error("Error reading trace file (invalid text index): " + filename_);
+        return static_cast<std::uint32_t>(value);
+    }
+    float real()
+    {
+        require(4);
+        std::uint32_t bits = 0;
+        for (int i = 0; i < 4; ++i)
+            bits |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(*position_++)) << (8 * i);
+        return std::bit_cast<float>(bits);
+    }
+    sf::Vector2f position()
+    {
+        const float x = real();
+        return {x, real()};
+    }
+    sf::Color color()
+    {
+        const std::uint8_t r = byte(), g = byte(), b = byte();
+        return {r, g, b, byte()};
+    }
+    std::string string()
+    {
+        const std::size_t length = count();
+        std::string text(position_, length);
+        position_ += length;
+        return text;
+    }
+    const char* bytes(std::size_t length)
+    {
+        require(length);
+        const char* start = position_;
+        position_ += length;
+        return start;
+    }
+    bool atEnd() const { return position_ == end_; }
+
+private:
+    void require(std::size_t length) const
+    {
+        if (static_cast<std::size_t>(end_ - position_) < length)
+            throw std::runtime_error("Error reading trace file (truncated): " + filename_);
+    }
+
+    const char* position_;
+    const char* end_;
+    const std::string& filename_;
+};
+
+std::size_t VisualTrace::record(Algorithm algorithm, const std::function<AlgorithmGenerator(INPUT_PARAMETER&)>& visualization,
+                                const INPUT_PARAMETER& points, const std::string& filename)
+{
+    std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+        throw std::runtime_error("Error opening file for writing: " + filename);
+
+    // Explanations and highlight texts repeat for (almost) every step, they are interned as they are seen and the
+    // texts are written once after the last step
+    std::unordered_map<std::string, std::uint64_t> textIndex;
+    std::vector<const std::string*> texts;
+    auto intern = [&](const std::string& text) {
+        auto [it, inserted] = textIndex.try_emplace(text, texts.size());
+        if (inserted)
+            texts.push_back(&it->first);
+        return it->second;
+    };
+
+    std::string buffer(TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC));
+    for (std::uint32_t version = TRACE_FILE_VERSION, i = 0; i < 4; ++i, version >>= 8)
+        writeByte(buffer, static_cast<std::uint8_t>(version & 0xFF));
+    writeByte(buffer, static_cast<std::uint8_t>(algorithm));
+    buffer.append(sizeof(std::uint64_t), '\0'); // Step count, known after the last step
+    writeVarint(buffer, points.size());
+    for (const auto& point : points)
+    {
+        writeFloat(buffer, point.x);
+        writeFloat(buffer, point.y);
+    }
+
+    auto flush = [&] {
+        output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!output)
+            throw std::runtime_error("Error writing to file: " + filename);
+        buffer.clear();
+    };
+
+    std::uint64_t steps = 0;
+    {
+        INPUT_PARAMETER input = points;
+        AlgorithmGenerator generator = visualization(input);
+        while (const VisualDelta* step = generator.next())
+        {
+            writeVarint(buffer, intern(step->explanation));
+            writeByte(buffer, step->finished);
+            writeVarint(buffer, step->changes.size());
+            for (const VisualChange& change : step->changes)
+            {
+                writeByte(buffer, static_cast<std::uint8_t>(change.type));
+                switch (change.type)
+                {
+                case VisualChangeType::ADD_HIGHLIGHT:
+                    writePosition(buffer, change.first);
+                    writeColor(buffer, change.color);
+                    writeVarint(buffer, intern(change.label));
+                    break;
+                case VisualChangeType::REMOVE_HIGHLIGHT:
+                    writePosition(buffer, change.first);
+                    break;
+                case VisualChangeType::ADD_INDICATOR_LINE:
+                    writePosition(buffer, change.first);
+                    writePosition(buffer, change.second);
+                    writeColor(buffer, change.color);
+                    break;
+                case VisualChangeType::REMOVE_INDICATOR_LINE:
+                    writePosition(buffer, change.first);
+                    writePosition(buffer, change.second);
+                    break;
+                case VisualChangeType::INSERT_HULL_POINT:
+                    writeVarint(buffer, change.index);
+                    [[fallthrough]];
+                case VisualChangeType::ADD_HULL_POINT:
+                    writePosition(buffer, change.first);
+                    writeColor(buffer, change.color);
+                    break;
+                case VisualChangeType::CLEAR_HIGHLIGHTS:
+                case VisualChangeType::CLEAR_INDICATOR_LINES:
+                case VisualChangeType::CLEAR_HULL_POINTS:
+                    break;
+                }
+            }
+            ++steps;
+            if (buffer.size() >= TRACE_WRITE_BUFFER_SIZE)
+                flush();
+        }
+    }
+
+    writeVarint(buffer, texts.size());
+    for (const std::string* text : texts)
+    {
+        writeVarint(buffer, text->size());
+        buffer += *text;
+    }
+    flush();
+
+    for (std::uint64_t count = steps, i = 0; i < 8; ++i, count >>= 8)
+        writeByte(buffer, static_cast<std::uint8_t>(count & 0xFF));
+    output.seekp(TRACE_STEP_COUNT_OFFSET);
+    flush();
+    return static_cast<std::size_t>(steps);
+}
+
+VisualTrace VisualTrace::load(const std::string& filename)
+{
+    std::ifstream input(filename, std::ios::binary);
+    if (!input.is_open())
+        throw std::runtime_error("Error opening file: " + filename);
+    const std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (input.bad())
+        throw std::runtime_error("Error reading from file: " + filename);
+
+    TraceReader reader(data, filename);
+    if (data.size() < sizeof(TRACE_FILE_MAGIC) ||
+        std::memcmp(reader.bytes(sizeof(TRACE_FILE_MAGIC)), TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC)) != 0)
+        throw std::runtime_error("Not a trace file: " + filename);
+    std::uint32_t version = 0;
+    for (int i = 0; i < 4; ++i)
+        version |= static_cast<std::uint32_t>(reader.byte()) << (8 * i);
+    if (version != TRACE_FILE_VERSION)
+        throw std::runtime_error("Unsupported trace file version " + std::to_string(version) + ": " + filename);
+
+    VisualTrace trace;
+    const std::uint8_t algorithm = reader.byte();
+    if (algorithm >= INVALID_ALGORITHM)
+        throw std::runtime_error("Invalid algorithm in trace file: " + filename);
+    trace.algorithm_ = static_cast<Algorithm>(algorithm);
+    std::uint64_t steps = 0;
+    for (int i = 0; i < 8; ++i)
+        steps |= static_cast<std::uint64_t>(reader.byte()) << (8 * i);
+
+    trace.points_.resize(reader.count());
+    for (auto& point : trace.points_)
+    {
+        const float x = reader.real();
+        point = ei::Vec2(x, reader.real());
+    }
+
+    // The texts follow the last step: explanations stay text indices, labels are set once the texts are read
+    std::vector<std::pair<VisualChange*, std::uint32_t>> labels;
+    trace.steps_.resize(reader.count(steps));
+    trace.explanations_.resize(trace.steps_.size());
+    for (std::size_t i = 0; i < trace.steps_.size(); ++i)
+    {
+        VisualDelta& step = trace.steps_[i];
+        trace.explanations_[i] = reader.index();
+        step.finished = reader.byte() != 0;
+        step.changes.resize(reader.count());
+        for (VisualChange& change : step.changes)
+        {
+            const std::uint8_t type = reader.byte();
+            if (type > static_cast<std::uint8_t>(VisualChangeType::CLEAR_HULL_POINTS))
+                throw std::runtime_error("Invalid change in trace file: " + filename);
+            change.type = static_cast<VisualChangeType>(type);
+            switch (change.type)
+            {
+            case VisualChangeType::ADD_HIGHLIGHT:
+                change.first = reader.position();
+                change.color = reader.color();
+                labels.emplace_back(&change, reader.index());
+                break;
+            case VisualChangeType::REMOVE_HIGHLIGHT:
+                change.first = reader.position();
+                break;
+            case VisualChangeType::ADD_INDICATOR_LINE:
+                change.first = reader.position();
+                change.second = reader.position();
+                change.color = reader.color();
+                break;
+            case VisualChangeType::REMOVE_INDICATOR_LINE:
+                change.first = reader.position();
+                change.second = reader.position();
+                break;
+            case VisualChangeType::INSERT_HULL_POINT:
+                change.index = static_cast<std::uint32_t>(reader.varint());
+                [[fallthrough]];
+            case VisualChangeType::ADD_HULL_POINT:
+                change.first = reader.position();
+                change.color = reader.color();
+                break;
+            case VisualChangeType::CLEAR_HIGHLIGHTS:
+            case VisualChangeType::CLEAR_INDICATOR_LINES:
+            case VisualChangeType::CLEAR_HULL_POINTS:
+                break;
+            }
+        }
+    }
+
+    trace.texts_.resize(reader.count());
+    for (auto& text : trace.texts_)
+    {
+        text = reader.string();
+    }
+    if (!reader.atEnd())
+        throw std::runtime_error("Unexpected data after the texts in trace file: " + filename);
+    const auto invalidIndex = [&](std::uint32_t index) { return index >= trace.texts_.size(); };
+    if (std::any_of(trace.explanations_.begin(), trace.explanations_.end(), invalidIndex))
+        throw std::runtime_error("Invalid text index in trace file: " + filename);
+    for (const auto& [change, index] : labels)
+    {
+        if (invalidIndex(index))
+            throw std::runtime_error("Invalid text index in trace file: " + filename);
+        change->label = trace.texts_[index];
+    }
+
+    trace.buildKeyframes();
+    return trace;
+}
+
+void VisualTrace::buildKeyframes()
+{
+    keyframeSteps_.clear();
+    keyframes_.clear();
+    Visual visual;
+    std::size_t changes = 0;
+    for (std::size_t i = 0; i < steps_.size(); ++i)
+    {
+        apply(i, visual);
+        changes += steps_[i].changes.size();
+        const std::size_t size = visual.highlights.size() + visual.indicator_lines.size() + visual.current_hull.size();
+        if (changes > std::max(size, MIN_KEYFRAME_CHANGES))
+        {
+            keyframeSteps_.push_back(i);
+            keyframes_.push_back(visual.snapshot());
+            changes = 0;
+        }
+    }
+}
+
+void VisualTrace::seek(std::size_t index, Visual& visual) const
+{
+    if (index >= steps_.size())
+        throw std::out_of_range("Step " + std::to_string(index) + " is not in the trace");
+
+    // Last keyframe at or before the step, otherwise start with the first step
+    std::size_t next = 0;
+    const auto keyframe = std::upper_bound(keyframeSteps_.begin(), keyframeSteps_.end(), index);
+    if (keyframe != keyframeSteps_.begin())
+    {
+        visual.apply(keyframes_[keyframe - keyframeSteps_.begin() - 1]);
+        next = *(keyframe - 1) + 1;
+    }
+    for (; next <= index; ++next)
+    {
+        apply(next, visual);
+    }
+}
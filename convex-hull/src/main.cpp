@@ -1,19 +1,27 @@
 ﻿#include <iostream>
 
+#include <algorithm>
 #include <exception>
-#include <fstream>
 #include <chrono>
+#include <iterator>
 #include <ei/2dtypes.hpp>
-#include <SFML/Graphics.hpp>
-#include <SFML/Window/Event.hpp>
 #include <cxxopts.hpp>
+#include <omp.h>
 
 #include "app.h"
-#include "TextWindow.h"
-#include "VisualAlgorithm.h"
+#include "ConvexHull.h"
 #include "JarvisMarch.h"
 #include "QuickHull.h"
+#include "QuickHull3D.h"
+#include "DivideAndConquer.h"
+#include "MonotoneChain.h"
+#include "AklToussaint.h"
+#include "ChansAlgorithm.h"
+#include "Predicates.h"
+#include "SimdKernels.h"
 #include "DataGenerator.h"
+#include "PointIO.h"
+#include "StreamHull.h"
 
 void PrintDuration(std::chrono::high_resolution_clock::time_point start, std::chrono::high_resolution_clock::time_point end) {
     auto duration = end - start;
@@ -72,9 +80,9 @@ Algorithm ParseAlgorithmOption(const cxxopts::ParseResult& result) {
         return INVALID_ALGORITHM;
     }
 
-    if (mode < 0 || mode > 2) {
+    if (mode < 0 || mode >= INVALID_ALGORITHM) {
         std::cerr << "Invalid algorithm mode: " << mode << std::endl
-                  << "Valid modes are: 0: QuickHull, 1: Jarvis March, 2: Divide & Conquer" << std::endl;
+                  << "Valid modes are: " << algorithmList() << std::endl;
         return INVALID_ALGORITHM;
     }
     return static_cast<Algorithm>(mode);
@@ -86,56 +94,67 @@ std::vector<ei::Vec2> LoadDataFromFile(const std::string& filename) {
     std::cout << "Loading data file..." << std::endl;
     auto start = std::chrono::high_resolution_clock::now();
 
-    std::ifstream data_file(filename);
-    if (!data_file.is_open()) {
-        std::cerr << "Error opening file: " << filename << std::endl;
-        return points;
+    // Text or binary format, detected from the file content
+    PointFileFormat format = TEXT_FORMAT;
+    try {
+        points = load_points(filename, &format);
     }
-
-    std::string line;
-    if (!std::getline(data_file, line)) {
-        std::cerr << "Error reading from file: " << filename << std::endl;
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        points.clear();
         return points;
     }
 
-    int num_points = 0;
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Loaded " << points.size() << " points from " << pointFileFormatToString(format)
+              << " file: " << filename << std::endl;
+    PrintDuration(start, end);
+
+    return points;
+}
+
+bool SaveDataToFile(const std::string& filename, const std::vector<ei::Vec2>& points) {
     try {
-        num_points = std::stoi(line);
+        save_points_binary(filename, points);
     }
     catch (const std::exception &e) {
-        std::cerr << "Error parsing number of points: " << e.what() << std::endl;
-        return points;
+        std::cerr << e.what() << std::endl;
+        return false;
     }
+    std::cout << "Saved " << points.size() << " points to binary file: " << filename << std::endl;
+    return true;
+}
 
-    for (int i = 0; i < num_points; i++) {
-        if (!std::getline(data_file, line)) {
-            std::cerr << "Error reading point data from file: " << filename << std::endl;
-            points.clear();
-            return points;
-        }
-        std::istringstream iss(line);
-        float x, y;
-        if (!(iss >> x >> y)) {
-            std::cerr << "Error parsing point data on line " << i + 2 << std::endl;
-            points.clear();
-            return points;
-        }
-        points.emplace_back(x, y);
+// Hulls a data file in chunks without loading it (--stream), prints the hull size and the throughput
+int StreamDataFile(Algorithm algorithm, const std::string& filename, std::size_t chunkBytes) {
+    std::cout << "Streaming " << filename << " with " << algorithmToString(algorithm) << " in chunks of "
+              << (chunkBytes >> 20) << " MiB..." << std::endl;
+    StreamHullStats stats;
+    std::vector<ei::Vec2> hull;
+    auto start = std::chrono::high_resolution_clock::now();
+    try {
+        hull = stream_hull(algorithm, filename, chunkBytes, &stats);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
     }
-    data_file.close();
-
     auto end = std::chrono::high_resolution_clock::now();
-    std::cout << "Loaded " << num_points << " points from file: " << filename << std::endl;
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double megabytes = static_cast<double>(stats.bytes) / 1e6;
+    std::cout << "Streamed " << stats.points << " points (" << formatFloat(static_cast<float>(megabytes), 1)
+              << " MB) in " << stats.chunks << " chunks, "
+              << formatFloat(static_cast<float>(seconds > 0.0 ? megabytes / seconds : 0.0), 1) << " MB/s" << std::endl;
+    std::cout << "Convex Hull Points: " << hull.size() << std::endl;
     PrintDuration(start, end);
-
-    return points;
+    return EXIT_SUCCESS;
 }
 
-std::vector<ei::Vec2> GenerateData(int test_case, int num_points) {
+std::vector<ei::Vec2> GenerateData(int test_case, int num_points, std::uint64_t seed) {
     std::cout << "Generating data for test case " << generatorToString(static_cast<Generator>(test_case))
-        << " with " << num_points << " points..." << std::endl;
+        << " with " << num_points << " points (seed " << seed << ")..." << std::endl;
     const auto start = std::chrono::high_resolution_clock::now();
-    std::vector<ei::Vec2> points = DataGenerator::GeneratePoints(static_cast<Generator>(test_case), num_points);
+    std::vector<ei::Vec2> points = DataGenerator::GeneratePoints(static_cast<Generator>(test_case), num_points, seed);
     const auto end = std::chrono::high_resolution_clock::now();
     std::cout << "Generated " << points.size() << " points." << std::endl;
     PrintDuration(start, end);
@@ -143,12 +162,133 @@ std::vector<ei::Vec2> GenerateData(int test_case, int num_points) {
     return points;
 }
 
+std::vector<ei::Vec2> CullPoints(const std::vector<ei::Vec2>& points) {
+    std::cout << "Culling interior points (Akl-Toussaint)..." << std::endl;
+    const auto start = std::chrono::high_resolution_clock::now();
+    std::vector<ei::Vec2> remaining = akl_toussaint_cull(points);
+    const auto end = std::chrono::high_resolution_clock::now();
+    const float ratio = points.empty() ? 0.0f : 100.0f * static_cast<float>(points.size() - remaining.size()) / static_cast<float>(points.size());
+    std::cout << "Culled " << points.size() - remaining.size() << " of " << points.size() << " points ("
+              << formatFloat(ratio, 2) << "%), " << remaining.size() << " remaining." << std::endl;
+    PrintDuration(start, end);
+
+    return remaining;
+}
+
+// --3d: the data options of the 2D mode, with 3D point files and generators. There is no 3D visualization
+int Run3D(const cxxopts::ParseResult& result, Algorithm algorithm) {
+    if (algorithm != QUICK_HULL) {
+        std::cerr << "3D hulls are computed by QuickHull only (-a " << QUICK_HULL << ")." << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (result["gui"].as<bool>() || result["cull"].as<bool>() || result["stream"].as<bool>() || result.count("record")) {
+        std::cerr << "Error: Option '3d' can not be combined with 'gui' (-g), 'cull' (-c), 'stream' or 'record'." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const int num_points = result["number"].as<int>();
+    if (result["benchmark"].as<bool>()) {
+        if (num_points <= 0) {
+            std::cerr << "Number of points must be positive." << std::endl;
+            return EXIT_FAILURE;
+        }
+        return benchmark_3d_main(num_points, result["seed"].as<std::uint64_t>());
+    }
+
+    const int test_case = result["test"].as<int>();
+    std::vector<ei::Vec3> points;
+    if (result.count("data_file") && test_case != -1) {
+        std::cerr << "Error: Options 'data_file' (-d) and 'test' (-t) are mutually exclusive. Please specify only one." << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (result.count("data_file")) {
+        const std::string filename = result["data_file"].as<std::string>();
+        std::cout << "Loading 3D data file..." << std::endl;
+        const auto start = std::chrono::high_resolution_clock::now();
+        try {
+            points = load_points_3d(filename);
+        }
+        catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "Loaded " << points.size() << " points from 3D file: " << filename << std::endl;
+        PrintDuration(start, end);
+    } else if (test_case != -1) {
+        if (num_points <= 0) {
+            std::cerr << "Number of points must be positive." << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (test_case < 0 || test_case > CLUSTERS) {
+            std::cerr << "Invalid test case specified: " << test_case << ". Valid test cases are 0 to " << CLUSTERS << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Generating 3D data for test case " << generatorToString(static_cast<Generator>(test_case))
+                  << " with " << num_points << " points (seed " << result["seed"].as<std::uint64_t>() << ")..." << std::endl;
+        const auto start = std::chrono::high_resolution_clock::now();
+        points = DataGenerator::GeneratePoints3D(static_cast<Generator>(test_case), num_points, result["seed"].as<std::uint64_t>());
+        const auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "Generated " << points.size() << " points." << std::endl;
+        PrintDuration(start, end);
+    } else {
+        std::cerr << "Error: You must specify either a data file (-d) or a test case (-t) in 3D mode." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (result.count("save")) {
+        try {
+            save_points_3d_binary(result["save"].as<std::string>(), points);
+        }
+        catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Saved " << points.size() << " points to binary 3D file: " << result["save"].as<std::string>() << std::endl;
+    }
+    return console_3d_main(points);
+}
+
+// The GUI is part of the convex_hull_gui library, which is only linked if configured with CONVEX_HULL_GUI
+int RunGui(Algorithm algorithm, std::vector<ei::Vec2>* points = nullptr) {
+#ifdef CONVEX_HULL_GUI
+    return gui_main(algorithm, points);
+#else
+    (void)algorithm;
+    (void)points;
+    std::cerr << "This build has no GUI (configured with CONVEX_HULL_GUI=OFF). Please use console mode." << std::endl;
+    return EXIT_FAILURE;
+#endif
+}
+
+// Recording and replaying traces need the visualizations of the convex_hull_gui library as well
+int RecordTrace(Algorithm algorithm, std::vector<ei::Vec2>& points, const std::string& trace_file) {
+#ifdef CONVEX_HULL_GUI
+    return record_trace_main(algorithm, points, trace_file);
+#else
+    (void)algorithm;
+    (void)points;
+    (void)trace_file;
+    std::cerr << "This build has no GUI (configured with CONVEX_HULL_GUI=OFF) and can not record traces." << std::endl;
+    return EXIT_FAILURE;
+#endif
+}
+
+int ReplayTrace(const std::string& trace_file) {
+#ifdef CONVEX_HULL_GUI
+    return replay_trace_main(trace_file);
+#else
+    (void)trace_file;
+    std::cerr << "This build has no GUI (configured with CONVEX_HULL_GUI=OFF) and can not replay traces." << std::endl;
+    return EXIT_FAILURE;
+#endif
+}
+
 int main(int argc, char *argv[]) {
     std::cout << "Program started." << std::endl;
 
     if (argc == 1) {
         // Just run the GUI if there's no arguments
-        return gui_main(QUICK_HULL);
+        return RunGui(QUICK_HULL);
     }
 
     // Configure CLI options
@@ -156,14 +296,33 @@ int main(int argc, char *argv[]) {
 
     options.add_options()
         ("h,help", "Print help")
-        ("g,gui", "Run with visualization using pre-loaded data (limited to less than 50 points)",
+        ("g,gui", "Run with visualization using pre-loaded data (limited to 1000000 points)",
+         cxxopts::value<bool>()->default_value("false"))
+        ("record", "Run the visualization of the algorithm on the loaded or generated points without a window and save every step to this trace file",
+         cxxopts::value<std::string>())
+        ("replay", "Open a trace file (--record) in the GUI to step forward and backward without running the algorithm",
+         cxxopts::value<std::string>())
+        ("d,data_file", "Path to a file containing points to load (text or binary format, detected automatically)", cxxopts::value<std::string>())
+        ("3d", "Hull 3D points: -t generates the 3D counterpart of the test case, -d and -s use binary 3D point files, -a 0 (QuickHull) only",
+         cxxopts::value<bool>()->default_value("false"))
+        ("stream", "Hull the data file in chunks without loading it completely (for files larger than memory)",
          cxxopts::value<bool>()->default_value("false"))
-        ("d,data_file", "Path to a file containing points to load", cxxopts::value<std::string>())
-        ("a,algorithm", "Algorithm to use as integer. 0: QuickHull, 1: Jarvis March, 2: Divide & Conquer",
+        ("chunk-size", "Chunk size of --stream in MiB", cxxopts::value<int>()->default_value(std::to_string(DEFAULT_STREAM_CHUNK_BYTES >> 20)))
+        ("s,save", "Save the loaded or generated points to this file in the binary format", cxxopts::value<std::string>())
+        ("a,algorithm", "Algorithm to use as integer. " + algorithmList(),
          cxxopts::value<int>()->default_value("0"))
-        ("t,test", "Perform the provided test case with generated data. 0: Random Points, 1: Straight Line, 2: Circle, 3: Square, 4: Large Dataset",
+        ("j,threads", "Number of threads for parallel algorithms (default: all cores)", cxxopts::value<int>()->default_value("0"))
+        ("t,test", "Perform the provided test case with generated data. 0: Random Points, 1: Straight Line, 2: Circle, 3: Square, 4: Large Dataset, "
+                   "5: Gaussian Cluster, 6: Annulus, 7: Clusters",
          cxxopts::value<int>()->default_value("-1"))
-        ("n,number", "Number of points to generate for test case", cxxopts::value<int>()->default_value("100"));
+        ("n,number", "Number of points to generate for test case", cxxopts::value<int>()->default_value("100"))
+        ("seed", "Seed of the generated test data (the same seed generates the same points on any number of threads)",
+         cxxopts::value<std::uint64_t>()->default_value(std::to_string(DataGenerator::DEFAULT_SEED)))
+        ("b,benchmark", "Run all algorithms on all test cases (0 to 3) and on polygons (--hull-sizes) with the given number of points (-n)",
+         cxxopts::value<bool>()->default_value("false"))
+        ("hull-sizes", "Hull sizes of the polygons used by --benchmark", cxxopts::value<std::vector<int>>()->default_value("8,64,512,4096"))
+        ("c,cull", "Remove interior points (Akl-Toussaint octagon) before running the algorithm (console and benchmark mode)",
+         cxxopts::value<bool>()->default_value("false"));
 
     options.parse_positional("data_file");
     options.positional_help("data_file");
@@ -192,6 +351,41 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
+    int threads = result["threads"].as<int>();
+    if (threads < 0) {
+        std::cerr << "Number of threads must not be negative." << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (threads > 0) {
+        omp_set_num_threads(threads);
+    }
+
+    if (result.count("replay")) {
+        if (result.count("record")) {
+            std::cerr << "Error: Options 'record' and 'replay' are mutually exclusive." << std::endl;
+            return EXIT_FAILURE;
+        }
+        return ReplayTrace(result["replay"].as<std::string>());
+    }
+
+    if (result["3d"].as<bool>()) {
+        return Run3D(result, algorithm);
+    }
+
+    if (result["benchmark"].as<bool>()) {
+        int num_points = result["number"].as<int>();
+        if (num_points <= 0) {
+            std::cerr << "Number of points must be positive." << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::vector<int> hull_sizes = result["hull-sizes"].as<std::vector<int>>();
+        if (std::any_of(hull_sizes.begin(), hull_sizes.end(), [](int size) { return size < 3; })) {
+            std::cerr << "Hull sizes must be at least 3." << std::endl;
+            return EXIT_FAILURE;
+        }
+        return benchmark_main(num_points, result["cull"].as<bool>(), hull_sizes, result["seed"].as<std::uint64_t>());
+    }
+
     // Check mutual exclusivity of data_file and test options
     bool data_file_provided = result.count("data_file") > 0;
     int test_case = result["test"].as<int>();
@@ -202,6 +396,23 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
+    if (result["stream"].as<bool>()) {
+        if (!data_file_provided) {
+            std::cerr << "Error: Option 'stream' needs a data file (-d)." << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (result["gui"].as<bool>() || result["cull"].as<bool>() || result.count("save") || result.count("record")) {
+            std::cerr << "Error: Option 'stream' can not be combined with 'gui' (-g), 'cull' (-c), 'save' (-s) or 'record'." << std::endl;
+            return EXIT_FAILURE;
+        }
+        const int chunk_size = result["chunk-size"].as<int>();
+        if (chunk_size <= 0) {
+            std::cerr << "Chunk size must be positive." << std::endl;
+            return EXIT_FAILURE;
+        }
+        return StreamDataFile(algorithm, result["data_file"].as<std::string>(), static_cast<std::size_t>(chunk_size) << 20);
+    }
+
     std::vector<ei::Vec2> points;
 
     if (data_file_provided) {
@@ -216,30 +427,44 @@ int main(int argc, char *argv[]) {
             return EXIT_FAILURE;
         }
 
-        if (test_case < 0 || test_case > 4) {
-            std::cerr << "Invalid test case specified: " << test_case << ". Valid test cases are 0 to 4." << std::endl;
+        if (test_case < 0 || test_case > CLUSTERS) {
+            std::cerr << "Invalid test case specified: " << test_case << ". Valid test cases are 0 to " << CLUSTERS << "." << std::endl;
             return EXIT_FAILURE;
         }
-        points = GenerateData(test_case, num_points);
+        points = GenerateData(test_case, num_points, result["seed"].as<std::uint64_t>());
     } else {
         // Neither data_file nor test case is provided
         if (result["gui"].as<bool>()) {
             // Run GUI with default or empty data and specified algorithm
-            return gui_main(algorithm);
+            return RunGui(algorithm);
         }
         std::cerr << "Error: You must specify either a data file (-d), a test case (-t), or run the GUI (-g)." << std::endl;
         std::cerr << options.help() << std::endl;
         return EXIT_FAILURE;
     }
 
+    if (result.count("save") && !SaveDataToFile(result["save"].as<std::string>(), points)) {
+        return EXIT_FAILURE;
+    }
+
     // Run program
+    if (result.count("record")) {
+        if (result["gui"].as<bool>() || result["cull"].as<bool>()) {
+            std::cerr << "Error: Option 'record' can not be combined with 'gui' (-g) or 'cull' (-c)." << std::endl;
+            return EXIT_FAILURE;
+        }
+        return RecordTrace(algorithm, points, result["record"].as<std::string>());
+    }
     if (result["gui"].as<bool>()) {
         if (points.size() > VISUALIZATION_POINTS_LIMIT) {
             std::cerr << "Too many points for visualization (Max: " << VISUALIZATION_POINTS_LIMIT
                       << "). Please use console mode." << std::endl;
             return EXIT_FAILURE;
         }
-        return gui_main(algorithm, &points);
+        return RunGui(algorithm, &points);
+    }
+    if (result["cull"].as<bool>()) {
+        points = CullPoints(points);
     }
     auto exit_code =  console_main(algorithm, points);
     points.clear();
@@ -249,22 +474,17 @@ int main(int argc, char *argv[]) {
 int console_main(Algorithm algorithm, std::vector<ei::Vec2>& loadedPoints)
 {
     std::cout << "Running " << algorithmToString(algorithm) << " in console mode..." << std::endl;
+    if (algorithm == JARVIS_MARCH || algorithm == QUICK_HULL_SIMD) {
+        std::cout << "Using " << simd_kernel_name() << " kernels" << std::endl;
+    }
     std::vector<ei::Vec2> hull;
     auto start = std::chrono::high_resolution_clock::now();
-    switch (algorithm)
-    {
-        case QUICK_HULL:
-            hull = quick_hull_performance(loadedPoints);
-            break;
-        case JARVIS_MARCH:
-            hull = jarvis_march_performance(loadedPoints);
-            break;
-        case DIVIDE_AND_CONQUER:
-            // divideAndConquerAlgorithm(loadedPoints);
-            break;
-        default:
-            std::cerr << "Invalid algorithm mode specified." << std::endl;
-            return EXIT_FAILURE;
+    try {
+        hull = computeHull(algorithm, loadedPoints);
+    }
+    catch (const std::invalid_argument &e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
     }
     auto end = std::chrono::high_resolution_clock::now();
     std::cout << "Convex Hull Points: " << hull.size() << std::endl;
@@ -272,116 +492,164 @@ int console_main(Algorithm algorithm, std::vector<ei::Vec2>& loadedPoints)
     return EXIT_SUCCESS;
 }
 
-int gui_main(Algorithm algorithm, std::vector<ei::Vec2>* loadedPoints)
+int console_3d_main(const std::vector<ei::Vec3>& loadedPoints)
 {
-    sf::RenderWindow window(sf::VideoMode(WINDOW_DEFAULT_WIDTH, WINDOW_DEFAULT_HEIGHT), "APRG - Convex Hull");
-    // Center position (for resetting shape positions)
-    sf::Vector2f windowCenter = {WINDOW_DEFAULT_WIDTH / 2.f, WINDOW_DEFAULT_HEIGHT / 2.f};
-
-    // Load a font for text
-    sf::Font font;
-    // Font file path is relative to binary output. CMakelists.txt copies the font file to the binary directory.
-    if (!font.loadFromFile("../resources/FiraCodeNerdFontMono-Retina.ttf"))
-    {
-        std::cerr << "Error loading font\n";
+    std::cout << "Running QuickHull 3D in console mode..." << std::endl;
+    std::vector<std::uint32_t> triangles;
+    auto start = std::chrono::high_resolution_clock::now();
+    try {
+        triangles = quick_hull_3d(loadedPoints);
+    }
+    catch (const std::invalid_argument &e) {
+        std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
     }
+    auto end = std::chrono::high_resolution_clock::now();
+    if (triangles.empty()) {
+        std::cout << "All points are coplanar, there is no 3D hull." << std::endl;
+    } else {
+        std::vector<std::uint32_t> vertices(triangles);
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        std::cout << "Convex Hull Faces: " << triangles.size() / 3 << ", Vertices: " << vertices.size() << std::endl;
+    }
+    PrintDuration(start, end);
+    return EXIT_SUCCESS;
+}
 
-    sf::VertexArray drawableDots;
-    std::vector<ei::Vec2> points;
+// Nanoseconds per orientation test of a walk over the points, the sum of the results is returned in checksum.
+// Like in the hull algorithms every step depends on the previous result (left turn: skip a point), so the test
+// cannot be vectorized and its latency counts
+template <typename Predicate>
+static double timePredicate(const std::vector<ei::Vec2>& points, Predicate predicate, long long& checksum)
+{
+    constexpr int REPEATS = 10;
+    checksum = 0;
+    long long tests = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int repeat = 0; repeat < REPEATS; ++repeat) {
+        for (size_t i = 0; i + 2 < points.size(); ++tests) {
+            const int orientation = predicate(points[i], points[i + 1], points[i + 2]);
+            checksum += orientation;
+            i += orientation > 0 ? 2 : 1;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(tests);
+}
 
-    // Create algorithm holder for step visualization
-    VisualAlgorithm alg_holder;
-    switch (algorithm)
-    {
-        case QUICK_HULL:
-            alg_holder = VisualAlgorithm(quick_hull_visualization);
-            break;
-        case JARVIS_MARCH:
-            alg_holder = VisualAlgorithm(jarvis_march_visualization);
-            break;
-        case DIVIDE_AND_CONQUER:
-            // alg_holder = VisualAlgorithm(divideAndConquerAlgorithm);
-            break;
-    }
-    alg_holder.setFont(font);
-
-    // Create TextWindow (for information fields)
-    TextWindow textWindow(font);
-
-    // Handle pre-loaded points
-    if(loadedPoints)
-    {
-        points = *loadedPoints;
-        for (const auto &point : points)
-        {
-            auto dot = sf::Vertex(sf::Vector2f(point.x, point.y), sf::Color::White);
-            drawableDots.append(dot);
-            auto index = textWindow.addTextField(sf::Vector2f(point.x, point.y), 0, 30);
-            textWindow.setText(index, "X: " + std::to_string(point.x) + "\nY: " + std::to_string(point.y));
+// Plain float cross product against orient2d: random points only take the fast path, points on a line
+// (rounded to float) take the exact path
+static void benchmarkPredicates(int numPoints, std::uint64_t seed)
+{
+    auto floatCross = [](const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c) {
+        const float cross = (a.x - c.x) * (b.y - c.y) - (a.y - c.y) * (b.x - c.x);
+        return (cross > 0.0f) - (cross < 0.0f);
+    };
+    auto robust = [](const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c) { return orient2d(a, b, c); };
+
+    std::vector<ei::Vec2> collinear(std::max(numPoints, 3));
+    for (size_t i = 0; i < collinear.size(); ++i) {
+        const float t = static_cast<float>(i) / static_cast<float>(collinear.size() - 1);
+        collinear[i] = ei::Vec2(100.0f + t * 537.3f, 50.0f + t * 311.7f);
+    }
+    const std::vector<std::pair<std::string, std::vector<ei::Vec2>>> cases = {
+        {generatorToString(RANDOM_POINTS), DataGenerator::GeneratePoints(RANDOM_POINTS, std::max(numPoints, 3), seed)},
+        {"Collinear", collinear}};
+
+    std::cout << std::endl << "Orientation predicate [ns per test]:" << std::endl;
+    std::cout << std::left << std::setw(18) << "Test case" << std::right << std::setw(14) << "Float cross"
+              << std::setw(14) << "orient2d" << std::setw(14) << "Overhead" << std::endl;
+    for (const auto& [name, points] : cases) {
+        long long floatChecksum, robustChecksum;
+        const double floatTime = timePredicate(points, floatCross, floatChecksum);
+        const double robustTime = timePredicate(points, robust, robustChecksum);
+        // NOTE: The checksums keep the loops from being optimized away, they only match if float was exact
+        std::cout << std::left << std::setw(18) << name << std::right
+                  << std::setw(14) << formatFloat(static_cast<float>(floatTime), 3)
+                  << std::setw(14) << formatFloat(static_cast<float>(robustTime), 3)
+                  << std::setw(13) << formatFloat(static_cast<float>((robustTime / floatTime - 1.0) * 100.0), 1) << "%"
+                  << (floatChecksum == robustChecksum ? "" : "  (float results differ)") << std::endl;
+    }
+}
+
+int benchmark_main(int numPoints, bool cull, const std::vector<int>& hullSizes, std::uint64_t seed)
+{
+    // Test case 4 (large dataset) is covered by -n
+    constexpr Generator TEST_CASES[] = {RANDOM_POINTS, STRAIGHT_LINE, CIRCLE, SQUARE, GAUSSIAN_CLUSTER, ANNULUS, CLUSTERS};
+    constexpr int TEST_CASE_COUNT = static_cast<int>(std::size(TEST_CASES));
+    constexpr double JARVIS_WORK_LIMIT = 1e10; // Jarvis March is O(N*h), skipped above this number of steps
+    std::vector<std::vector<std::string>> rows;
+
+    // Test cases, followed by polygons with the given number of hull points (for the crossover by h)
+    const int datasets = TEST_CASE_COUNT + static_cast<int>(hullSizes.size());
+    for (int dataset = 0; dataset < datasets; ++dataset) {
+        std::string name;
+        std::vector<ei::Vec2> points;
+        double expectedHull = 0.0;
+        if (dataset < TEST_CASE_COUNT) {
+            const Generator generator = TEST_CASES[dataset];
+            name = generatorToString(generator);
+            points = GenerateData(generator, numPoints, seed);
+            expectedHull = generator == CIRCLE ? numPoints : 0.0; // Every point of the circle is a hull point
+        } else {
+            const int hullSize = hullSizes[dataset - TEST_CASE_COUNT];
+            name = "Polygon h=" + std::to_string(hullSize);
+            points = DataGenerator::GeneratePolygon(numPoints, hullSize, seed);
+            expectedHull = hullSize;
+        }
+        if (cull) {
+            points = CullPoints(points);
         }
-        alg_holder.setInput(points);
-    }
-
-    // Main loop
-    while (window.isOpen())
-    {
-        // Handle events
-        sf::Event event{};
-        while (window.pollEvent(event))
-        {
-            // Close window : exit
-            if (event.type == sf::Event::Closed)
-                window.close();
-
-            if (event.type == sf::Event::MouseButtonPressed)
-            {
-                if (alg_holder.IsStarted())
-                {
-                    std::cout << "Cannot add points after algorithm calculation started. Please complete calculation." << std::endl;
-                    continue;
-                }
-                // Get mouse position
-                sf::Vector2i mousePosWindow = sf::Mouse::getPosition(window);
-                sf::Vector2f mousePos = window.mapPixelToCoords(mousePosWindow);
-                auto dot = sf::Vertex(mousePos, sf::Color::White);
-                drawableDots.append(dot);
-                points.emplace_back(mousePos.x, mousePos.y);
-                auto index = textWindow.addTextField(mousePos, 0, 30);
-                textWindow.setText(index, "X: " + formatFloat(mousePos.x, 2) + "\nY: " + formatFloat(mousePos.y, 2));
-                std::cout << "Added point at: (" << mousePos.x << "," << mousePos.y << ")" << std::endl;
-                alg_holder.setInput(points);
-            }
 
-            if (event.type == sf::Event::KeyPressed)
-            {
-                switch (event.key.code)
-                {
-                case sf::Keyboard::Enter:
-                    alg_holder.runAlgorithm(window);
-                    break;
-                case sf::Keyboard::Space:
-                    alg_holder.visualStep();
-                    break;
-                case sf::Keyboard::R:
-                    std::cout << "Resetting algorithm" << std::endl;
-                    alg_holder.reset();
-                    break;
-                default:
-                    std::cout << "Key: " << event.key.code << " not used/supported" << std::endl;
-                    break;
-                }
+        for (int algorithm = 0; algorithm < INVALID_ALGORITHM; ++algorithm) {
+            if (algorithm == JARVIS_MARCH && static_cast<double>(numPoints) * expectedHull > JARVIS_WORK_LIMIT) {
+                rows.push_back({name, algorithmToString(JARVIS_MARCH), "-", "skipped"});
+                continue;
             }
+            // NOTE: Jarvis March reorders its input, every algorithm gets a fresh copy
+            std::vector<ei::Vec2> input(points);
+            auto start = std::chrono::high_resolution_clock::now();
+            std::vector<ei::Vec2> hull = computeHull(static_cast<Algorithm>(algorithm), input);
+            auto end = std::chrono::high_resolution_clock::now();
+            double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+            rows.push_back({name, algorithmToString(static_cast<Algorithm>(algorithm)),
+                            std::to_string(hull.size()), formatFloat(static_cast<float>(milliseconds), 3)});
         }
+    }
 
-        // Clear the window with a black color
-        window.clear(sf::Color::Black);
+    std::cout << std::endl << "Benchmark with " << numPoints << " points" << (cull ? " (culled, see above)" : "")
+              << ", " << simd_kernel_name() << " kernels:" << std::endl;
+    std::cout << std::left << std::setw(18) << "Test case" << std::setw(24) << "Algorithm"
+              << std::right << std::setw(12) << "Hull points" << std::setw(16) << "Time [ms]" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(18) << row[0] << std::setw(24) << row[1]
+                  << std::right << std::setw(12) << row[2] << std::setw(16) << row[3] << std::endl;
+    }
+    benchmarkPredicates(numPoints, seed);
+    return EXIT_SUCCESS;
+}
 
-        window.draw(drawableDots);
-        textWindow.draw(window);
-        alg_holder.draw(window);
+int benchmark_3d_main(int numPoints, std::uint64_t seed)
+{
+    constexpr Generator TEST_CASES[] = {RANDOM_POINTS, STRAIGHT_LINE, CIRCLE, SQUARE, GAUSSIAN_CLUSTER, ANNULUS, CLUSTERS};
+    std::vector<std::vector<std::string>> rows;
+    for (Generator generator : TEST_CASES) {
+        const std::vector<ei::Vec3> points = DataGenerator::GeneratePoints3D(generator, numPoints, seed);
+        auto start = std::chrono::high_resolution_clock::now();
+        const std::vector<std::uint32_t> triangles = quick_hull_3d(points);
+        auto end = std::chrono::high_resolution_clock::now();
+        double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        rows.push_back({generatorToString(generator), std::to_string(triangles.size() / 3),
+                        formatFloat(static_cast<float>(milliseconds), 3)});
+    }
 
-        window.display();
+    std::cout << std::endl << "QuickHull 3D benchmark with " << numPoints << " points:" << std::endl;
+    std::cout << std::left << std::setw(18) << "Test case" << std::right << std::setw(12) << "Hull faces"
+              << std::setw(16) << "Time [ms]" << std::endl;
+    for (const auto& row : rows) {
+        std::cout << std::left << std::setw(18) << row[0] << std::right << std::setw(12) << row[1]
+                  << std::setw(16) << row[2] << std::endl;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
@@ -41,11 +41,20 @@ $TestCases = @{
     1 = "line"
     2 = "circle"
     3 = "square"
+    5 = "gaussian-cluster"
+    6 = "annulus"
+    7 = "clusters"
 }
 
 $Algorithms = @{
     0 = "quick-hull"
     1 = "jarvis-march"
+    2 = "divide-and-conquer"
+    3 = "quick-hull-inplace"
+    4 = "quick-hull-parallel"
+    5 = "monotone-chain"
+    6 = "chans-algorithm"
+    7 = "quick-hull-simd"
 }
 
 # Configuration: Adjust the number of data points per test case
@@ -55,6 +64,9 @@ $DataPoints = @{
     1 = 10, 50, 10000, 50000, 100000, 1000000             # Data points for test case 1 ("line")
     2 = 10, 50, 10000, 50000, 100000     # Data points for test case 2 ("circle")
     3 = 10, 50, 10000, 50000, 100000, 1000000         # Data points for test case 3 ("square")
+    5 = 10, 50, 10000, 100000, 1000000, 10000000      # Data points for test case 5 ("gaussian-cluster")
+    6 = 10, 50, 10000, 100000, 1000000                # Data points for test case 6 ("annulus")
+    7 = 10, 50, 10000, 100000, 1000000, 10000000      # Data points for test case 7 ("clusters")
 }
 
 # Function to escape arguments if needed
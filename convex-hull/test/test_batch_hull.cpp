@@ -0,0 +1,143 @@
+﻿#include "gtest/gtest.h"
+#include "BatchHull.h"
+#include "ConvexHull.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Point sets in CSR layout as taken by batch_hull_indices
+struct PointSets {
+    std::vector<std::uint32_t> offsets{0};
+    std::vector<float> xs;
+    std::vector<float> ys;
+
+    void add(const std::vector<std::pair<float, float>>& points)
+    {
+        for (const auto& [x, y] : points) {
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+        offsets.push_back(static_cast<std::uint32_t>(xs.size()));
+    }
+};
+
+static std::vector<std::pair<float, float>> randomPoints(std::size_t count, std::mt19937& gen, int range)
+{
+    // Integer coordinates, so small ranges give repeated and collinear points
+    std::uniform_int_distribution<int> coordinate(-range, range);
+    std::vector<std::pair<float, float>> points;
+    for (std::size_t i = 0; i < count; ++i)
+        points.emplace_back(float(coordinate(gen)), float(coordinate(gen)));
+    return points;
+}
+
+// Runs batch_hull_indices and compares every set with hull_indices on the same slice
+static void expectMatchesHullIndices(const PointSets& sets)
+{
+    std::vector<std::uint32_t> hullOffsets(sets.offsets.size());
+    std::vector<std::uint32_t> hullIndices(sets.xs.size());
+    const std::size_t total = batch_hull_indices(sets.offsets, sets.xs, sets.ys, hullOffsets, hullIndices);
+    ASSERT_EQ(hullOffsets.front(), 0u);
+    ASSERT_EQ(total, hullOffsets.back());
+
+    for (std::size_t set = 0; set + 1 < sets.offsets.size(); ++set) {
+        const std::uint32_t first = sets.offsets[set], size = sets.offsets[set + 1] - first;
+        std::vector<std::uint32_t> out(size);
+        const std::size_t count = hull_indices(std::span(sets.xs).subspan(first, size),
+                                               std::span(sets.ys).subspan(first, size), out);
+        // hull_indices keeps the clockwise order of QuickHull, the batch hulls are counterclockwise
+        std::vector<std::uint32_t> expected(out.begin(), out.begin() + count);
+        if (count > 2)
+            std::reverse(expected.begin() + 1, expected.end());
+        for (std::uint32_t& index : expected)
+            index += first;
+        const std::vector<std::uint32_t> actual(hullIndices.begin() + hullOffsets[set],
+                                                hullIndices.begin() + hullOffsets[set + 1]);
+        EXPECT_EQ(actual, expected) << "set " << set << " with " << size << " points";
+    }
+}
+
+// Test-Suite 1: Batch Hulls against hull_indices
+
+TEST(BatchHullTest, DegenerateSetsMatchHullIndices)
+{
+    PointSets sets;
+    sets.add({});
+    sets.add({{1.0f, 2.0f}});
+    sets.add({{1.0f, 2.0f}, {3.0f, -1.0f}});
+    sets.add({{3.0f, -1.0f}, {1.0f, 2.0f}});
+    sets.add({{5.0f, 5.0f}, {5.0f, 5.0f}});
+    sets.add({{5.0f, 5.0f}, {5.0f, 5.0f}, {5.0f, 5.0f}, {5.0f, 5.0f}});
+    sets.add({});
+    // All collinear: diagonal, horizontal and vertical, in mixed order
+    sets.add({{2.0f, 2.0f}, {0.0f, 0.0f}, {4.0f, 4.0f}, {1.0f, 1.0f}, {3.0f, 3.0f}});
+    sets.add({{3.0f, 7.0f}, {-1.0f, 7.0f}, {9.0f, 7.0f}, {3.0f, 7.0f}});
+    sets.add({{0.0f, 1.0f}, {0.0f, -4.0f}, {0.0f, 8.0f}});
+    expectMatchesHullIndices(sets);
+}
+
+TEST(BatchHullTest, RandomSetsMatchHullIndices)
+{
+    // Sizes on both sides of the small-set kernel limit (256 points), dense and sparse coordinates
+    std::mt19937 gen(17);
+    PointSets sets;
+    for (std::size_t size : {3, 4, 7, 16, 100, 255, 256, 257, 300, 1000, 5000, 40000}) {
+        sets.add(randomPoints(size, gen, 1000));
+        sets.add(randomPoints(size, gen, 4));
+    }
+    std::uniform_int_distribution<std::size_t> size(0, 600);
+    for (int i = 0; i < 500; ++i)
+        sets.add(randomPoints(size(gen), gen, i % 2 ? 10 : 10000));
+    expectMatchesHullIndices(sets);
+}
+
+TEST(BatchHullTest, RepeatedHullPointHasSmallestIndex)
+{
+    // (4, 0) occurs at the set indices 1, 4 and 6, (0, 0) at 0 and 5; the second set starts behind the first
+    PointSets sets;
+    sets.add({{9.0f, 9.0f}});
+    sets.add({{0.0f, 0.0f}, {4.0f, 0.0f}, {2.0f, 1.0f}, {2.0f, 5.0f}, {4.0f, 0.0f}, {0.0f, 0.0f}, {4.0f, 0.0f}});
+    std::vector<std::uint32_t> hullOffsets(3), hullIndices(8);
+    ASSERT_EQ(batch_hull_indices(sets.offsets, sets.xs, sets.ys, hullOffsets, hullIndices), 4u);
+    EXPECT_EQ(std::vector<std::uint32_t>(hullIndices.begin() + hullOffsets[1], hullIndices.begin() + hullOffsets[2]),
+              std::vector<std::uint32_t>({1, 2, 4}));
+
+    // The same in a set with more than 256 points, where the large-set path is taken
+    std::mt19937 gen(23);
+    PointSets large;
+    auto points = randomPoints(1000, gen, 100);
+    points[10] = {-200.0f, 0.0f};
+    points[500] = {-200.0f, 0.0f};
+    points[999] = {-200.0f, 0.0f};
+    large.add(points);
+    std::vector<std::uint32_t> largeOffsets(2), largeIndices(points.size());
+    ASSERT_GT(batch_hull_indices(large.offsets, large.xs, large.ys, largeOffsets, largeIndices), 0u);
+    EXPECT_EQ(largeIndices[0], 10u);
+}
+
+// Test-Suite 2: Invalid Arguments
+
+TEST(BatchHullTest, InvalidArgumentsThrow)
+{
+    PointSets sets;
+    sets.add({{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}});
+    sets.add({{2.0f, 2.0f}});
+    std::vector<std::uint32_t> hullOffsets(3), hullIndices(4);
+    const std::vector<std::uint32_t> noOffsets;
+    const std::vector<float> shortYs(sets.ys.begin(), sets.ys.end() - 1);
+    const std::vector<std::uint32_t> beyondEnd{0, 3, 5};
+    const std::vector<std::uint32_t> descending{0, 3, 2, 4};
+    std::vector<std::uint32_t> fewHullOffsets(2), fewHullIndices(3), descendingHullOffsets(4);
+
+    EXPECT_THROW(batch_hull_indices(noOffsets, sets.xs, sets.ys, hullOffsets, hullIndices), std::invalid_argument);
+    EXPECT_THROW(batch_hull_indices(sets.offsets, sets.xs, shortYs, hullOffsets, hullIndices), std::invalid_argument);
+    EXPECT_THROW(batch_hull_indices(beyondEnd, sets.xs, sets.ys, hullOffsets, hullIndices), std::invalid_argument);
+    EXPECT_THROW(batch_hull_indices(descending, sets.xs, sets.ys, descendingHullOffsets, hullIndices),
+                 std::invalid_argument);
+    EXPECT_THROW(batch_hull_indices(sets.offsets, sets.xs, sets.ys, fewHullOffsets, hullIndices), std::invalid_argument);
+    EXPECT_THROW(batch_hull_indices(sets.offsets, sets.xs, sets.ys, hullOffsets, fewHullIndices), std::invalid_argument);
+
+    // The valid call succeeds
+    EXPECT_EQ(batch_hull_indices(sets.offsets, sets.xs, sets.ys, hullOffsets, hullIndices), 4u);
+}
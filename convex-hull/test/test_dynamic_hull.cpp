@@ -0,0 +1,196 @@
+﻿#include "gtest/gtest.h"
+#include "DynamicHull.h"
+#include "MonotoneChain.h"
+#include "Predicates.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Hull of the point set as computed from scratch (monotone_chain_performance returns fewer than three points as given)
+static std::vector<ei::Vec2> referenceHull(std::vector<ei::Vec2> points)
+{
+    std::sort(points.begin(), points.end(), [](const ei::Vec2& a, const ei::Vec2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    return monotone_chain_performance(points);
+}
+
+static double dot(const ei::Vec2& a, const ei::Vec2& b)
+{
+    return double(a.x) * b.x + double(a.y) * b.y;
+}
+
+// Test-Suite 1: Insert and Erase
+
+TEST(DynamicHullTest, RandomInsertEraseMatchesMonotoneChain)
+{
+    // Small integer grid, so repeated and collinear points are frequent
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> coordinate(-20, 20);
+    std::uniform_int_distribution<int> operation(0, 9);
+
+    DynamicHull dynamic;
+    std::vector<ei::Vec2> points;
+    for (int i = 0; i < 20000; ++i) {
+        // Erase more often than insert once the set has grown, so the hull shrinks down to a few points again
+        const int eraseWeight = points.size() > 300 ? 6 : 3;
+        if (points.empty() || operation(gen) >= eraseWeight) {
+            const ei::Vec2 point(float(coordinate(gen)), float(coordinate(gen)));
+            dynamic.insert(point);
+            points.push_back(point);
+        } else if (operation(gen) == 0) {
+            // Point outside of the grid, never part of the set
+            EXPECT_FALSE(dynamic.erase(ei::Vec2(100.0f, float(coordinate(gen)))));
+        } else {
+            const std::size_t index = std::uniform_int_distribution<std::size_t>(0, points.size() - 1)(gen);
+            ASSERT_TRUE(dynamic.erase(points[index]));
+            points[index] = points.back();
+            points.pop_back();
+        }
+
+        ASSERT_EQ(dynamic.size(), points.size());
+        const std::vector<ei::Vec2> expected = referenceHull(points);
+        ASSERT_EQ(dynamic.hull(), expected) << "after operation " << i;
+        ASSERT_EQ(dynamic.hullSize(), expected.size());
+    }
+}
+
+TEST(DynamicHullTest, ConstructorMatchesMonotoneChain)
+{
+    std::mt19937 gen(5);
+    std::normal_distribution<float> coordinate(0.0f, 100.0f);
+    std::vector<ei::Vec2> points;
+    for (int i = 0; i < 10000; ++i)
+        points.emplace_back(coordinate(gen), coordinate(gen));
+    EXPECT_EQ(DynamicHull(points).hull(), referenceHull(points));
+}
+
+TEST(DynamicHullTest, ErasingRepeatedPoints)
+{
+    const ei::Vec2 repeated(4.0f, 4.0f);
+    DynamicHull dynamic({ei::Vec2(0.0f, 0.0f), ei::Vec2(4.0f, 0.0f), repeated, ei::Vec2(0.0f, 4.0f), ei::Vec2(2.0f, 3.0f)});
+    dynamic.insert(repeated);
+    dynamic.insert(repeated);
+    ASSERT_EQ(dynamic.size(), 7u);
+    ASSERT_EQ(dynamic.hullSize(), 4u);
+
+    // The vertex stays on the hull until its last occurrence is erased
+    EXPECT_TRUE(dynamic.erase(repeated));
+    EXPECT_TRUE(dynamic.erase(repeated));
+    EXPECT_EQ(dynamic.size(), 5u);
+    EXPECT_EQ(dynamic.hull(), std::vector<ei::Vec2>({{0.0f, 0.0f}, {4.0f, 0.0f}, {4.0f, 4.0f}, {0.0f, 4.0f}}));
+
+    // The inner point replaces it
+    EXPECT_TRUE(dynamic.erase(repeated));
+    EXPECT_EQ(dynamic.size(), 4u);
+    EXPECT_EQ(dynamic.hull(), std::vector<ei::Vec2>({{0.0f, 0.0f}, {4.0f, 0.0f}, {2.0f, 3.0f}, {0.0f, 4.0f}}));
+    EXPECT_FALSE(dynamic.erase(repeated));
+    EXPECT_EQ(dynamic.size(), 4u);
+
+    // Down to a repeated single point and back to the empty set
+    DynamicHull single;
+    single.insert(repeated);
+    single.insert(repeated);
+    EXPECT_TRUE(single.erase(repeated));
+    EXPECT_EQ(single.hull(), std::vector<ei::Vec2>({repeated}));
+    EXPECT_TRUE(single.erase(repeated));
+    EXPECT_TRUE(single.empty());
+    EXPECT_TRUE(single.hull().empty());
+    EXPECT_FALSE(single.erase(repeated));
+}
+
+// Test-Suite 2: Queries
+
+TEST(DynamicHullTest, Contains)
+{
+    const DynamicHull square({ei::Vec2(0.0f, 0.0f), ei::Vec2(4.0f, 0.0f), ei::Vec2(4.0f, 4.0f), ei::Vec2(0.0f, 4.0f)});
+    EXPECT_TRUE(square.contains(ei::Vec2(2.0f, 2.0f)));
+    EXPECT_TRUE(square.contains(ei::Vec2(2.0f, 0.0f)));   // On an edge of the lower chain
+    EXPECT_TRUE(square.contains(ei::Vec2(2.0f, 4.0f)));   // On an edge of the upper chain
+    EXPECT_TRUE(square.contains(ei::Vec2(0.0f, 2.0f)));   // On the vertical edge at the leftmost point
+    EXPECT_TRUE(square.contains(ei::Vec2(4.0f, 4.0f)));
+    EXPECT_FALSE(square.contains(ei::Vec2(2.0f, std::nextafter(0.0f, -1.0f))));
+    EXPECT_FALSE(square.contains(ei::Vec2(4.5f, 2.0f)));
+    EXPECT_FALSE(square.contains(ei::Vec2(-0.5f, 2.0f)));
+    EXPECT_FALSE(square.contains(ei::Vec2(2.0f, 5.0f)));
+
+    const DynamicHull segment({ei::Vec2(0.0f, 0.0f), ei::Vec2(2.0f, 2.0f)});
+    EXPECT_TRUE(segment.contains(ei::Vec2(1.0f, 1.0f)));
+    EXPECT_FALSE(segment.contains(ei::Vec2(1.0f, std::nextafter(1.0f, 2.0f))));
+    EXPECT_FALSE(segment.contains(ei::Vec2(3.0f, 3.0f)));
+
+    EXPECT_FALSE(DynamicHull().contains(ei::Vec2(0.0f, 0.0f)));
+}
+
+TEST(DynamicHullTest, RandomQueriesMatchBruteForce)
+{
+    std::mt19937 gen(9);
+    std::uniform_int_distribution<int> coordinate(-50, 50);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+    std::vector<ei::Vec2> points;
+    for (int i = 0; i < 200; ++i)
+        points.emplace_back(float(coordinate(gen)), float(coordinate(gen)));
+    const DynamicHull dynamic(points);
+    const std::vector<ei::Vec2> hull = dynamic.hull();
+
+    for (int i = 0; i < 2000; ++i) {
+        const ei::Vec2 query(float(coordinate(gen)) * 1.5f, float(coordinate(gen)) * 1.5f);
+
+        // Inside if it is on the inner side of (or on) every edge
+        bool inside = true;
+        for (std::size_t j = 0; j < hull.size(); ++j)
+            inside = inside && orient2d(hull[j], hull[(j + 1) % hull.size()], query) >= 0;
+        ASSERT_EQ(dynamic.contains(query), inside) << query.x << ", " << query.y;
+
+        // The whole hull lies right of the line to the first and left of the line to the last tangent point
+        const auto tangents = dynamic.tangents(query);
+        ASSERT_EQ(tangents.has_value(), !inside);
+        if (tangents) {
+            const auto& [first, last] = *tangents;
+            ASSERT_NE(std::find(hull.begin(), hull.end(), first), hull.end());
+            ASSERT_NE(std::find(hull.begin(), hull.end(), last), hull.end());
+            for (const ei::Vec2& vertex : hull) {
+                ASSERT_LE(orient2d(query, first, vertex), 0);
+                ASSERT_GE(orient2d(query, last, vertex), 0);
+            }
+        }
+
+        // Extreme vertex has the largest dot product of all points
+        const ei::Vec2 direction(std::cos(angle(gen)), std::sin(angle(gen)));
+        const auto extreme = dynamic.extremePoint(direction);
+        ASSERT_TRUE(extreme.has_value());
+        ASSERT_NE(std::find(hull.begin(), hull.end(), *extreme), hull.end());
+        for (const ei::Vec2& point : points)
+            ASSERT_LE(dot(direction, point), dot(direction, *extreme) + 1e-9);
+    }
+}
+
+TEST(DynamicHullTest, ExtremePointAndTangentsOfSquare)
+{
+    const DynamicHull square({ei::Vec2(0.0f, 0.0f), ei::Vec2(4.0f, 0.0f), ei::Vec2(4.0f, 4.0f), ei::Vec2(0.0f, 4.0f)});
+    EXPECT_EQ(square.extremePoint(ei::Vec2(1.0f, 1.0f)), ei::Vec2(4.0f, 4.0f));
+    EXPECT_EQ(square.extremePoint(ei::Vec2(-1.0f, 1.0f)), ei::Vec2(0.0f, 4.0f));
+    EXPECT_EQ(square.extremePoint(ei::Vec2(-1.0f, -1.0f)), ei::Vec2(0.0f, 0.0f));
+    EXPECT_EQ(square.extremePoint(ei::Vec2(1.0f, -1.0f)), ei::Vec2(4.0f, 0.0f));
+    EXPECT_THROW(square.extremePoint(ei::Vec2(0.0f, 0.0f)), std::invalid_argument);
+    EXPECT_FALSE(DynamicHull().extremePoint(ei::Vec2(1.0f, 0.0f)).has_value());
+
+    // Below the square only the bottom edge is visible, right of it the right edge
+    using Tangents = std::pair<ei::Vec2, ei::Vec2>;
+    EXPECT_EQ(square.tangents(ei::Vec2(2.0f, -5.0f)), Tangents({0.0f, 0.0f}, {4.0f, 0.0f}));
+    EXPECT_EQ(square.tangents(ei::Vec2(9.0f, 2.0f)), Tangents({4.0f, 0.0f}, {4.0f, 4.0f}));
+    // Diagonally above right two edges are visible, one of each chain
+    EXPECT_EQ(square.tangents(ei::Vec2(6.0f, 6.0f)), Tangents({4.0f, 0.0f}, {0.0f, 4.0f}));
+    // Points on the boundary and inside see no edge
+    EXPECT_FALSE(square.tangents(ei::Vec2(4.0f, 2.0f)).has_value());
+    EXPECT_FALSE(square.tangents(ei::Vec2(1.0f, 1.0f)).has_value());
+    EXPECT_FALSE(DynamicHull().tangents(ei::Vec2(1.0f, 1.0f)).has_value());
+
+    // In line with a segment, both tangent points are its nearer end
+    const DynamicHull segment({ei::Vec2(0.0f, 0.0f), ei::Vec2(2.0f, 2.0f)});
+    EXPECT_EQ(segment.tangents(ei::Vec2(5.0f, 5.0f)), Tangents({2.0f, 2.0f}, {2.0f, 2.0f}));
+    EXPECT_EQ(segment.tangents(ei::Vec2(-1.0f, -1.0f)), Tangents({0.0f, 0.0f}, {0.0f, 0.0f}));
+}
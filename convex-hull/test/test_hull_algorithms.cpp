@@ -0,0 +1,196 @@
+﻿#include "gtest/gtest.h"
+#include "AklToussaint.h"
+#include "ChansAlgorithm.h"
+#include "DataGenerator.h"
+#include "DivideAndConquer.h"
+#include "MonotoneChain.h"
+#include "Predicates.h"
+#include "QuickHull.h"
+#include "RadixSort.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using HullFunction = std::vector<ei::Vec2> (*)(const std::vector<ei::Vec2>&);
+
+struct HullAlgorithm {
+    const char* name;
+    HullFunction hull;
+    bool clockwise;  ///< The QuickHull engines return the hull clockwise, all others counterclockwise
+};
+
+static const HullAlgorithm ALGORITHMS[] = {
+    {"quick_hull_performance", quick_hull_performance, true},
+    {"quick_hull_inplace", quick_hull_inplace, true},
+    {"quick_hull_parallel", quick_hull_parallel, true},
+    {"quick_hull_simd", quick_hull_simd, true},
+    {"divide_and_conquer_performance", divide_and_conquer_performance, false},
+    {"monotone_chain_performance", monotone_chain_performance, false},
+    {"chans_algorithm_performance", chans_algorithm_performance, false},
+};
+
+static bool lexicographicLess(const ei::Vec2& a, const ei::Vec2& b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+/**
+ * Textbook monotone chain (std::sort, exact orient2d) as reference: counterclockwise hull without collinear points,
+ * starting at the lexicographically smallest point.
+ */
+static std::vector<ei::Vec2> referenceHull(std::vector<ei::Vec2> points)
+{
+    std::sort(points.begin(), points.end(), lexicographicLess);
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.size() < 3)
+        return points;
+
+    std::vector<ei::Vec2> hull(2 * points.size());
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        while (size >= 2 && orient2d(hull[size - 2], hull[size - 1], points[i]) <= 0)
+            --size;
+        hull[size++] = points[i];
+    }
+    for (std::size_t i = points.size() - 1, lower = size + 1; i-- > 0;) {
+        while (size >= lower && orient2d(hull[size - 2], hull[size - 1], points[i]) <= 0)
+            --size;
+        hull[size++] = points[i];
+    }
+    hull.resize(size - 1);
+    return hull;
+}
+
+// Compares every algorithm (and the Akl-Toussaint culled input) with the reference hull, including the point order
+static void expectMatchesReference(const std::vector<ei::Vec2>& points, const std::string& input)
+{
+    const std::vector<ei::Vec2> expected = referenceHull(points);
+    std::vector<ei::Vec2> clockwise = expected;
+    if (clockwise.size() > 2)
+        std::reverse(clockwise.begin() + 1, clockwise.end());
+
+    for (const HullAlgorithm& algorithm : ALGORITHMS)
+        EXPECT_EQ(algorithm.hull(points), algorithm.clockwise ? clockwise : expected)
+            << algorithm.name << " on " << input << " with " << points.size() << " points";
+
+    // The culled points keep every hull point
+    const std::vector<ei::Vec2> culled = akl_toussaint_cull(points);
+    EXPECT_LE(culled.size(), points.size());
+    EXPECT_EQ(referenceHull(culled), expected) << "akl_toussaint_cull on " << input << " with " << points.size()
+                                               << " points";
+}
+
+// Test-Suite 1: Hull Algorithms against the Reference Hull
+
+TEST(HullAlgorithmsTest, GeneratedPoints)
+{
+    const Generator generators[] = {RANDOM_POINTS, STRAIGHT_LINE, CIRCLE, SQUARE, GAUSSIAN_CLUSTER, ANNULUS, CLUSTERS};
+    for (const Generator generator : generators) {
+        for (const std::size_t size : {3, 4, 10, 257, 5000, 100000}) {
+            for (const std::uint64_t seed : {1, 2}) {
+                expectMatchesReference(DataGenerator::GeneratePoints(generator, size, seed),
+                                       generatorToString(generator));
+            }
+        }
+    }
+}
+
+TEST(HullAlgorithmsTest, RandomPoints)
+{
+    std::mt19937 gen(71);
+    std::normal_distribution<float> normal(0.0f, 1e3f);
+    std::uniform_real_distribution<float> tiny(-1e-30f, 1e-30f);
+    for (const std::size_t size : {3, 5, 100, 3000, 60000}) {
+        std::vector<ei::Vec2> gaussian, small;
+        for (std::size_t i = 0; i < size; ++i) {
+            gaussian.emplace_back(normal(gen), normal(gen));
+            small.emplace_back(tiny(gen), tiny(gen));
+        }
+        expectMatchesReference(gaussian, "gaussian");
+        expectMatchesReference(small, "tiny coordinates");
+    }
+}
+
+TEST(HullAlgorithmsTest, CollinearPoints)
+{
+    std::mt19937 gen(73);
+    std::uniform_int_distribution<int> step(-5000, 5000);
+    for (const std::size_t size : {3, 4, 50, 20000}) {
+        std::vector<ei::Vec2> diagonal, horizontal, vertical, square;
+        for (std::size_t i = 0; i < size; ++i) {
+            const float s = static_cast<float>(step(gen));
+            diagonal.emplace_back(3.0f * s + 1.0f, -2.0f * s + 7.0f);
+            horizontal.emplace_back(s, 4.0f);
+            vertical.emplace_back(-4.0f, s);
+            // Points on the sides of a square only
+            const float t = static_cast<float>(i % 4);
+            square.push_back(i % 2 ? ei::Vec2(s, t < 2 ? -5000.0f : 5000.0f) : ei::Vec2(t < 2 ? -5000.0f : 5000.0f, s));
+        }
+        expectMatchesReference(diagonal, "diagonal line");
+        expectMatchesReference(horizontal, "horizontal line");
+        expectMatchesReference(vertical, "vertical line");
+        expectMatchesReference(square, "square sides");
+    }
+}
+
+TEST(HullAlgorithmsTest, DuplicateHeavyPoints)
+{
+    std::mt19937 gen(79);
+    for (const int range : {1, 3, 20}) {
+        std::uniform_int_distribution<int> coordinate(-range, range);
+        for (const std::size_t size : {3, 10, 1000, 50000}) {
+            std::vector<ei::Vec2> grid;
+            for (std::size_t i = 0; i < size; ++i)
+                grid.emplace_back(static_cast<float>(coordinate(gen)), static_cast<float>(coordinate(gen)));
+            expectMatchesReference(grid, "grid of range " + std::to_string(range));
+        }
+    }
+
+    // A few distinct points, each repeated many times
+    std::vector<ei::Vec2> repeated;
+    for (int i = 0; i < 1000; ++i)
+        repeated.push_back(i % 3 == 0 ? ei::Vec2(0.0f, 0.0f) : (i % 3 == 1 ? ei::Vec2(5.0f, 1.0f) : ei::Vec2(2.0f, 6.0f)));
+    expectMatchesReference(repeated, "three repeated points");
+    std::vector<ei::Vec2> pairs(3000, ei::Vec2(1.0f, 1.0f));
+    std::fill(pairs.begin() + 1500, pairs.end(), ei::Vec2(-2.0f, 3.0f));
+    expectMatchesReference(pairs, "two repeated points");
+}
+
+// Test-Suite 2: Radix Sort
+
+TEST(HullAlgorithmsTest, RadixSortMatchesStdSort)
+{
+    const float special[] = {0.0f, -0.0f, 1.0f, -1.0f, std::numeric_limits<float>::infinity(),
+                             -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::denorm_min(),
+                             -std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    for (const float value : special)
+        EXPECT_EQ(std::bit_cast<std::uint32_t>(sortableToFloat(floatToSortable(value))), std::bit_cast<std::uint32_t>(value));
+
+    std::mt19937 gen(83);
+    std::normal_distribution<float> normal(0.0f, 100.0f);
+    std::uniform_int_distribution<int> pick(0, std::size(special) - 1);
+    for (const std::size_t size : {0, 1, 2, 100, 70000}) {
+        std::vector<ei::Vec2> points;
+        for (std::size_t i = 0; i < size; ++i) {
+            if (i % 5 == 0)
+                points.emplace_back(special[pick(gen)], special[pick(gen)]);
+            else
+                points.emplace_back(normal(gen), std::round(normal(gen)));
+        }
+        // Key order: -0 before +0
+        std::vector<ei::Vec2> expected = points;
+        std::stable_sort(expected.begin(), expected.end(), [](const ei::Vec2& a, const ei::Vec2& b) {
+            const std::uint32_t ax = floatToSortable(a.x), bx = floatToSortable(b.x);
+            return ax < bx || (ax == bx && floatToSortable(a.y) < floatToSortable(b.y));
+        });
+        radix_sort_points(points);
+        ASSERT_EQ(points.size(), expected.size());
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            EXPECT_EQ(std::bit_cast<std::uint32_t>(points[i].x), std::bit_cast<std::uint32_t>(expected[i].x)) << i;
+            EXPECT_EQ(std::bit_cast<std::uint32_t>(points[i].y), std::bit_cast<std::uint32_t>(expected[i].y)) << i;
+        }
+    }
+}
@@ -0,0 +1,126 @@
+﻿#include "gtest/gtest.h"
+#include "MonotoneChain.h"
+#include "QuickHull.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Runs quick_hull_indices on the points and returns the hull indices
+static std::vector<std::uint32_t> indicesOf(const std::vector<ei::Vec2>& points)
+{
+    std::vector<float> xs, ys;
+    for (const ei::Vec2& point : points) {
+        xs.push_back(point.x);
+        ys.push_back(point.y);
+    }
+    std::vector<std::uint32_t> out(points.size());
+    const std::size_t count = quick_hull_indices(xs, ys, out);
+    out.resize(count);
+    return out;
+}
+
+// Counterclockwise hull of monotone_chain_performance (which returns fewer than three points as given)
+static std::vector<ei::Vec2> referenceHull(std::vector<ei::Vec2> points)
+{
+    std::sort(points.begin(), points.end(), [](const ei::Vec2& a, const ei::Vec2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    return monotone_chain_performance(points);
+}
+
+// Checks the indices against monotone chain: same hull in clockwise order (like quick_hull_inplace), every index
+// is the first occurrence of its point
+static void expectMatchesMonotoneChain(const std::vector<ei::Vec2>& points)
+{
+    const std::vector<std::uint32_t> indices = indicesOf(points);
+    std::vector<ei::Vec2> hull;
+    for (const std::uint32_t index : indices) {
+        ASSERT_LT(index, points.size());
+        EXPECT_EQ(std::find(points.begin(), points.end(), points[index]) - points.begin(), index);
+        hull.push_back(points[index]);
+    }
+
+    std::vector<ei::Vec2> expected = referenceHull(points);
+    if (expected.size() > 2)
+        std::reverse(expected.begin() + 1, expected.end());
+    EXPECT_EQ(hull, expected) << points.size() << " points";
+    // quick_hull_inplace returns fewer than three points as given
+    if (points.size() >= 3)
+        EXPECT_EQ(hull, quick_hull_inplace(points));
+}
+
+// Test-Suite 1: Hull Indices against Monotone Chain
+
+TEST(HullIndicesTest, FewerThanThreePoints)
+{
+    EXPECT_TRUE(indicesOf({}).empty());
+    EXPECT_EQ(indicesOf({{3.0f, 4.0f}}), std::vector<std::uint32_t>({0}));
+    EXPECT_EQ(indicesOf({{3.0f, 4.0f}, {3.0f, 4.0f}}), std::vector<std::uint32_t>({0}));
+    EXPECT_EQ(indicesOf({{3.0f, 4.0f}, {1.0f, 9.0f}}), std::vector<std::uint32_t>({1, 0}));
+    expectMatchesMonotoneChain({{3.0f, 4.0f}, {1.0f, 9.0f}});
+}
+
+TEST(HullIndicesTest, CollinearPoints)
+{
+    // Only the end points are hull points, in any direction of the line
+    EXPECT_EQ(indicesOf({{2.0f, 2.0f}, {0.0f, 0.0f}, {4.0f, 4.0f}, {1.0f, 1.0f}, {3.0f, 3.0f}}),
+              std::vector<std::uint32_t>({1, 2}));
+    EXPECT_EQ(indicesOf({{0.0f, 5.0f}, {0.0f, -3.0f}, {0.0f, 1.0f}}), std::vector<std::uint32_t>({1, 0}));
+
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<float> t(0.0f, 1.0f);
+    std::vector<ei::Vec2> line;
+    for (int i = 0; i < 5000; ++i) {
+        const float s = std::round(t(gen) * 1000.0f);
+        line.emplace_back(s * 3.0f - 7.0f, s * -2.0f + 11.0f);
+    }
+    expectMatchesMonotoneChain(line);
+}
+
+TEST(HullIndicesTest, DuplicatesGetTheirFirstIndex)
+{
+    // Square with every corner repeated, the corners occur first at 2, 3, 4 and 6
+    const std::vector<ei::Vec2> points = {{1.0f, 1.0f}, {2.0f, 1.0f}, {0.0f, 0.0f}, {4.0f, 0.0f}, {4.0f, 4.0f},
+                                          {4.0f, 0.0f}, {0.0f, 4.0f}, {0.0f, 0.0f}, {4.0f, 4.0f}, {0.0f, 4.0f}};
+    EXPECT_EQ(indicesOf(points), std::vector<std::uint32_t>({2, 6, 4, 3}));
+
+    std::mt19937 gen(8);
+    std::uniform_int_distribution<int> coordinate(-3, 3);
+    for (int size : {3, 10, 100, 10000}) {
+        std::vector<ei::Vec2> grid;
+        for (int i = 0; i < size; ++i)
+            grid.emplace_back(float(coordinate(gen)), float(coordinate(gen)));
+        expectMatchesMonotoneChain(grid);
+    }
+}
+
+TEST(HullIndicesTest, RandomPointsMatchMonotoneChain)
+{
+    std::mt19937 gen(12);
+    std::normal_distribution<float> normal(0.0f, 100.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    for (int size : {3, 4, 5, 50, 1000, 100000}) {
+        std::vector<ei::Vec2> gaussian, circle;
+        for (int i = 0; i < size; ++i) {
+            gaussian.emplace_back(normal(gen), normal(gen));
+            const float a = angle(gen);
+            circle.emplace_back(1000.0f * std::cos(a), 1000.0f * std::sin(a));
+        }
+        expectMatchesMonotoneChain(gaussian);
+        expectMatchesMonotoneChain(circle);
+    }
+}
+
+// Test-Suite 2: Invalid Arguments
+
+TEST(HullIndicesTest, InvalidArgumentsThrow)
+{
+    const std::vector<float> xs{0.0f, 1.0f, 0.0f}, ys{0.0f, 0.0f, 1.0f}, shortYs{0.0f, 0.0f};
+    std::vector<std::uint32_t> out(3), shortOut(2);
+    EXPECT_THROW(quick_hull_indices(xs, shortYs, out), std::invalid_argument);
+    EXPECT_THROW(quick_hull_indices(xs, ys, shortOut), std::invalid_argument);
+    EXPECT_EQ(quick_hull_indices(xs, ys, out), 3u);
+}
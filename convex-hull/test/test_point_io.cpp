@@ -0,0 +1,203 @@
+﻿#include "gtest/gtest.h"
+#include "PointIO.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Test files in the temporary directory, removed after every test
+class PointIOTest : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        for (const std::string& file : files)
+            std::filesystem::remove(file);
+    }
+
+    std::string path(const std::string& name)
+    {
+        files.push_back((std::filesystem::temp_directory_path() / ("convex_hull_test_" + name)).string());
+        return files.back();
+    }
+
+    std::string writeFile(const std::string& name, const std::string& bytes)
+    {
+        const std::string filename = path(name);
+        std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+        output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        return filename;
+    }
+
+    std::vector<std::string> files;
+};
+
+static std::vector<ei::Vec2> randomPoints(std::size_t count, std::uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> coordinate(0.0f, 1000.0f);
+    std::vector<ei::Vec2> points;
+    for (std::size_t i = 0; i < count; ++i)
+        points.emplace_back(coordinate(gen), coordinate(gen));
+    return points;
+}
+
+// Text point file with the shortest representation that reads back to the same float
+static std::string textFile(const std::vector<ei::Vec2>& points)
+{
+    std::string text = std::to_string(points.size()) + "\n";
+    char buffer[32];
+    for (const ei::Vec2& point : points) {
+        text.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), point.x).ptr);
+        text += ' ';
+        text.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), point.y).ptr);
+        text += '\n';
+    }
+    return text;
+}
+
+// Binary header as described in PointIO.h
+static std::string binaryHeader(const char* magic, std::uint32_t scalarBytes, std::uint64_t count)
+{
+    std::string header(magic, 4);
+    for (int i = 0; i < 4; ++i)
+        header += static_cast<char>((scalarBytes >> (8 * i)) & 0xFF);
+    for (int i = 0; i < 8; ++i)
+        header += static_cast<char>((count >> (8 * i)) & 0xFF);
+    return header;
+}
+
+template<typename T>
+static void appendLittle(std::string& bytes, T value)
+{
+    char raw[sizeof(T)];
+    std::memcpy(raw, &value, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big)
+        std::reverse(raw, raw + sizeof(T));
+    bytes.append(raw, sizeof(T));
+}
+
+// Expects a std::runtime_error whose message contains the text
+static void expectRuntimeError(const std::string& filename, const std::string& text)
+{
+    try {
+        load_points(filename);
+        ADD_FAILURE() << "No exception for " << filename;
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find(text), std::string::npos) << e.what();
+    }
+}
+
+// Test-Suite 1: Round Trips
+
+TEST_F(PointIOTest, BinaryRoundTrip)
+{
+    for (std::size_t count : {0, 1, 1000, 300000}) {
+        const std::vector<ei::Vec2> points = randomPoints(count, 1);
+        const std::string filename = path("round_trip.bin");
+        save_points_binary(filename, points);
+        PointFileFormat format = TEXT_FORMAT;
+        EXPECT_EQ(load_points(filename, &format), points);
+        EXPECT_EQ(format, BINARY_FORMAT);
+    }
+}
+
+TEST_F(PointIOTest, TextRoundTripMatchesBinary)
+{
+    // Large enough to be parsed in several parallel chunks
+    const std::vector<ei::Vec2> points = randomPoints(200000, 2);
+    const std::string text = writeFile("round_trip.txt", textFile(points));
+    const std::string binary = path("round_trip.bin");
+    save_points_binary(binary, points);
+
+    PointFileFormat format = BINARY_FORMAT;
+    EXPECT_EQ(load_points(text, &format), points);
+    EXPECT_EQ(format, TEXT_FORMAT);
+    EXPECT_EQ(load_points(text), load_points(binary));
+}
+
+TEST_F(PointIOTest, TextVariants)
+{
+    // Blanks, a plus sign, CRLF line ends and a missing line end after the last point
+    const std::string filename = writeFile("variants.txt", " 3\r\n1.5 -2\r\n\t+3e2   4.25 \r\n-0 7");
+    EXPECT_EQ(load_points(filename), std::vector<ei::Vec2>({{1.5f, -2.0f}, {300.0f, 4.25f}, {-0.0f, 7.0f}}));
+}
+
+TEST_F(PointIOTest, BinaryDoubleCoordinatesAreNarrowed)
+{
+    std::string bytes = binaryHeader(POINT_FILE_MAGIC, 8, 2);
+    for (double value : {0.1, -2.5, 1e10, 3.0})
+        appendLittle(bytes, value);
+    EXPECT_EQ(load_points(writeFile("double.bin", bytes)),
+              std::vector<ei::Vec2>({{0.1f, -2.5f}, {1e10f, 3.0f}}));
+}
+
+TEST_F(PointIOTest, Binary3DRoundTrip)
+{
+    const std::vector<ei::Vec3> points = {{1.0f, 2.0f, 3.0f}, {-4.0f, 5.5f, 1e-3f}};
+    const std::string filename = path("round_trip_3d.bin");
+    save_points_3d_binary(filename, points);
+    const std::vector<ei::Vec3> loaded = load_points_3d(filename);
+    ASSERT_EQ(loaded.size(), points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(loaded[i].x, points[i].x);
+        EXPECT_EQ(loaded[i].y, points[i].y);
+        EXPECT_EQ(loaded[i].z, points[i].z);
+    }
+    // A 3D file is not loaded as 2D points
+    expectRuntimeError(filename, "3D");
+}
+
+// Test-Suite 2: Error Paths
+
+TEST_F(PointIOTest, MissingAndEmptyFiles)
+{
+    expectRuntimeError(path("missing.txt"), "Error opening file");
+    expectRuntimeError(writeFile("empty.txt", ""), "Error reading from file");
+}
+
+TEST_F(PointIOTest, BinaryErrors)
+{
+    // Header cut off after the magic
+    expectRuntimeError(writeFile("short_header.bin", std::string(POINT_FILE_MAGIC, 4) + "ab"), "header");
+    // Unsupported coordinate size
+    expectRuntimeError(writeFile("bad_scalar.bin", binaryHeader(POINT_FILE_MAGIC, 3, 0)), "Unsupported coordinate size");
+
+    // Header announces more points than the file holds
+    std::string truncated = binaryHeader(POINT_FILE_MAGIC, 4, 3);
+    for (float value : {1.0f, 2.0f, 3.0f, 4.0f, 5.0f})
+        appendLittle(truncated, value);
+    expectRuntimeError(writeFile("truncated.bin", truncated), "truncated");
+    // Absurd counts are rejected before allocating
+    expectRuntimeError(writeFile("huge_count.bin", binaryHeader(POINT_FILE_MAGIC, 4, UINT64_MAX)), "truncated");
+
+    std::string truncated3D = binaryHeader(POINT_FILE_3D_MAGIC, 4, 2);
+    appendLittle(truncated3D, 1.0f);
+    EXPECT_THROW(load_points_3d(writeFile("truncated_3d.bin", truncated3D)), std::runtime_error);
+}
+
+TEST_F(PointIOTest, TextErrors)
+{
+    expectRuntimeError(writeFile("bad_count.txt", "abc\n1 2\n"), "number of points");
+    expectRuntimeError(writeFile("negative_count.txt", "-5\n1 2\n"), "number of points");
+    // Fewer lines than announced
+    expectRuntimeError(writeFile("few_lines.txt", "3\n1 2\n3 4\n"), "Error reading point data");
+    // Malformed lines name their line number (the count is line 1)
+    expectRuntimeError(writeFile("bad_line.txt", "3\n1 2\n3 x\n5 6\n"), "line 3");
+    expectRuntimeError(writeFile("one_coordinate.txt", "2\n1 2\n3\n"), "line 3");
+
+    // The first malformed line of a file parsed in parallel chunks
+    std::vector<ei::Vec2> points = randomPoints(100000, 3);
+    std::string text = textFile(points);
+    std::size_t line = 0, position = 0;
+    for (; line < 70000; ++line)
+        position = text.find('\n', position) + 1;
+    text.insert(position, "?");
+    expectRuntimeError(writeFile("bad_chunk_line.txt", text), "line " + std::to_string(line + 1));
+}
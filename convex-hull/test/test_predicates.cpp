@@ -0,0 +1,214 @@
+﻿#include "gtest/gtest.h"
+#include "Predicates.h"
+#include "ChansAlgorithm.h"
+#include "MonotoneChain.h"
+#include "QuickHull.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include <vector>
+#ifdef CONVEX_HULL_GMP
+#include <gmpxx.h>
+#endif
+
+// Test-Suite 1: Robust Orientation Predicate
+
+#ifdef CONVEX_HULL_GMP
+// Reference sign with rational arithmetic (every float is exactly representable as mpq_class)
+static int referenceOrient2d(const ei::Vec2& a, const ei::Vec2& b, const ei::Vec2& c)
+{
+    const mpq_class determinant = (mpq_class(a.x) - c.x) * (mpq_class(b.y) - c.y) -
+                                  (mpq_class(a.y) - c.y) * (mpq_class(b.x) - c.x);
+    return sgn(determinant);
+}
+#endif
+
+// Triples a, b, c where c lies on the line ab rounded to float and moved by a few ulps (or not at all), the
+// magnitude of the coordinates ranges from 2^-60 to 2^60
+static std::vector<std::array<ei::Vec2, 3>> nearlyCollinearTriples(std::size_t count, std::uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> exponent(-60, 60);
+    std::uniform_int_distribution<int> ulps(-3, 3);
+
+    const auto nudge = [&](float value) {
+        for (int steps = ulps(gen); steps != 0; steps += steps > 0 ? -1 : 1)
+            value = std::nextafter(value, steps > 0 ? INFINITY : -INFINITY);
+        return value;
+    };
+
+    std::vector<std::array<ei::Vec2, 3>> triples;
+    triples.reserve(count);
+    while (triples.size() < count) {
+        const float scale = std::ldexp(1.0f, exponent(gen));
+        // Every fourth triple on a small integer grid, where c = a + t (b - a) is exact for an integral t
+        const bool grid = triples.size() % 4 == 0;
+        const auto coordinate = [&] { return (grid ? std::round(unit(gen) * 1000.0f) : unit(gen)) * scale; };
+        const ei::Vec2 a(coordinate(), coordinate());
+        const ei::Vec2 b(coordinate(), coordinate());
+        const float t = grid ? std::round(unit(gen) * 2.0f) : unit(gen) * 2.0f;
+        const ei::Vec2 c(nudge(a.x + t * (b.x - a.x)), nudge(a.y + t * (b.y - a.y)));
+        triples.push_back({a, b, c});
+    }
+    return triples;
+}
+
+// Static bound of the bounding box of a, b and c, as computed by the algorithms
+static float staticBound(const std::array<ei::Vec2, 3>& triple)
+{
+    float minX = triple[0].x, maxX = triple[0].x, minY = triple[0].y, maxY = triple[0].y;
+    for (const ei::Vec2& p : triple) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    return orient2dStaticBound(static_cast<double>(maxX) - minX, static_cast<double>(maxY) - minY);
+}
+
+TEST(PredicatesTest, NearlyCollinearTriplesMatchRationalReference)
+{
+#ifndef CONVEX_HULL_GMP
+    GTEST_SKIP() << "GMP not found, no exact reference";
+#else
+    std::size_t collinear = 0;
+    for (const auto& [a, b, c] : nearlyCollinearTriples(200000, 42)) {
+        const int expected = referenceOrient2d(a, b, c);
+        collinear += expected == 0;
+        ASSERT_EQ(orient2d_exact(a, b, c), expected);
+        ASSERT_EQ(orient2d(a, b, c), expected);
+        ASSERT_EQ(orient2dFloatFiltered(a, b, c), expected);
+        ASSERT_EQ(orient2d(a, b, c, staticBound({a, b, c})), expected);
+        // Permuting the points changes the sign with the parity of the permutation
+        ASSERT_EQ(orient2d(b, c, a), expected);
+        ASSERT_EQ(orient2d(b, a, c), -expected);
+    }
+    // The triples have to exercise the exactly collinear case as well
+    EXPECT_GT(collinear, 0u);
+#endif
+}
+
+TEST(PredicatesTest, ShewchukGridMatchesRationalReference)
+{
+#ifndef CONVEX_HULL_GMP
+    GTEST_SKIP() << "GMP not found, no exact reference";
+#else
+    // a on a 256 x 256 grid of neighboring floats around (0.5, 0.5), b and c on the diagonal (Shewchuk's example,
+    // where the float and the double cross product produce wrong signs)
+    const ei::Vec2 b(12.0f, 12.0f), c(24.0f, 24.0f);
+    const float bound = staticBound({ei::Vec2(0.5f, 0.5f), b, c});
+    float x = 0.5f;
+    for (int i = 0; i < 256; ++i, x = std::nextafter(x, 1.0f)) {
+        float y = 0.5f;
+        for (int j = 0; j < 256; ++j, y = std::nextafter(y, 1.0f)) {
+            const ei::Vec2 a(x, y);
+            const int expected = referenceOrient2d(a, b, c);
+            ASSERT_EQ(orient2d(a, b, c), expected);
+            ASSERT_EQ(orient2dFloatFiltered(a, b, c), expected);
+            ASSERT_EQ(orient2d(a, b, c, bound), expected);
+        }
+    }
+#endif
+}
+
+TEST(PredicatesTest, NonFiniteCoordinatesAreNotDecidedByTheFilters)
+{
+    // NaN fails every comparison of the filters, the result has to be the one of orient2d
+    const ei::Vec2 a(0.0f, 0.0f), b(1.0f, NAN), c(2.0f, 2.0f);
+    EXPECT_EQ(orient2dFloatFiltered(a, b, c), orient2d(a, b, c));
+    EXPECT_EQ(orient2d(a, b, c, 1.0f), orient2d(a, b, c));
+    EXPECT_EQ(orient2dStaticBound(INFINITY, 1.0), INFINITY);
+    EXPECT_EQ(orient2dStaticBound(NAN, 1.0), INFINITY);
+}
+
+// Test-Suite 2: Algorithms on Nearly Collinear Input
+
+static std::vector<ei::Vec2> sortedVertices(std::vector<ei::Vec2> hull)
+{
+    std::sort(hull.begin(), hull.end(), [](const ei::Vec2& p, const ei::Vec2& q) {
+        return p.x < q.x || (p.x == q.x && p.y < q.y);
+    });
+    return hull;
+}
+
+// Points on a line (rounded to float), the same line moved by one ulp and a dense circle
+static std::vector<std::vector<ei::Vec2>> nearlyDegenerateInputs()
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> t(0.0f, 1.0f);
+    const ei::Vec2 A(123.456f, 77.7f), B(9876.5f, 3456.25f);
+
+    std::vector<std::vector<ei::Vec2>> inputs(3);
+    for (int i = 0; i < 20000; ++i) {
+        const float s = t(gen);
+        const ei::Vec2 p(A.x + s * (B.x - A.x), A.y + s * (B.y - A.y));
+        inputs[0].push_back(p);
+        inputs[1].emplace_back(p.x, std::nextafter(p.y, gen() % 2 ? INFINITY : -INFINITY));
+        const float angle = t(gen) * 6.2831853f;
+        inputs[2].emplace_back(5000.0f + 3000.0f * std::cos(angle), 5000.0f + 3000.0f * std::sin(angle));
+    }
+    return inputs;
+}
+
+TEST(PredicatesTest, FilteredAlgorithmsMatchMonotoneChain)
+{
+    for (const std::vector<ei::Vec2>& points : nearlyDegenerateInputs()) {
+        const std::vector<ei::Vec2> expected = sortedVertices(monotone_chain_performance(points));
+        EXPECT_EQ(sortedVertices(quick_hull_inplace(points)), expected);
+        EXPECT_EQ(sortedVertices(quick_hull_parallel(points)), expected);
+        EXPECT_EQ(sortedVertices(quick_hull_performance(points)), expected);
+        EXPECT_EQ(sortedVertices(chans_algorithm_performance(points)), expected);
+    }
+}
+
+// Points whose float cross products with the line underflow to 0 although the exact value is not 0
+static std::vector<ei::Vec2> underflowingPoints(std::size_t count, std::uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<ei::Vec2> points;
+    for (std::size_t i = 0; i < count; ++i)
+        points.emplace_back(unit(gen) * 1e-30f, unit(gen) * 1e-20f);
+    return points;
+}
+
+TEST(PredicatesTest, SimdKernelsDecideUnderflowingProductsExactly)
+{
+    // (B - A) x (P - A) = 1e-30 * 1e-20 is below the smallest float, the kernels have to ask orient2d
+    const ei::Vec2 A(0.0f, 0.0f), B(1e-30f, 0.0f);
+    std::vector<ei::Vec2> points = underflowingPoints(67, 1);
+    points[5] = ei::Vec2(5e-31f, 1e-20f);
+    points[6] = ei::Vec2(5e-31f, -1e-20f);
+    points[7] = ei::Vec2(5e-31f, 0.0f);
+    std::vector<float> xs, ys;
+    for (const ei::Vec2& point : points) {
+        xs.push_back(point.x);
+        ys.push_back(point.y);
+    }
+
+    std::vector<std::int8_t> orientations(points.size());
+    orientation_kernel(xs.data(), ys.data(), points.size(), A, B, orientations.data());
+    std::size_t left = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        const int expected = orient2d(A, B, points[i]);
+        left += expected > 0;
+        EXPECT_EQ(orientations[i], expected) << simd_kernel_name() << ", point " << i;
+    }
+
+    std::vector<float> leftXs(points.size()), leftYs(points.size());
+    EXPECT_EQ(partition_kernel(xs.data(), ys.data(), points.size(), A, B, leftXs.data(), leftYs.data()), left)
+        << simd_kernel_name();
+}
+
+TEST(PredicatesTest, SimdQuickHullMatchesMonotoneChainOnUnderflowingInput)
+{
+    for (std::uint32_t seed = 0; seed < 20; ++seed) {
+        const std::vector<ei::Vec2> points = underflowingPoints(1000, seed);
+        EXPECT_EQ(sortedVertices(quick_hull_simd(points)), sortedVertices(monotone_chain_performance(points)))
+            << simd_kernel_name() << ", seed " << seed;
+    }
+}
@@ -0,0 +1,184 @@
+﻿#include "gtest/gtest.h"
+#include "Predicates.h"
+#include "QuickHull3D.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+static ei::Vec3 point(float x, float y, float z)
+{
+    return ei::Vec3(x, y, z);
+}
+
+/**
+ * Checks the triangle list of quick_hull_3d: no point lies above a face (every face is counterclockwise seen from
+ * outside), every face has a point below it (no degenerate faces), the mesh is closed (every directed edge has exactly
+ * one twin in the opposite direction) and Euler's formula V - E + F = 2 holds.
+ * @return Number of hull vertices.
+ */
+static std::size_t expectValidHull(const std::vector<ei::Vec3>& points, const std::vector<std::uint32_t>& triangles)
+{
+    EXPECT_EQ(triangles.size() % 3, 0u);
+    EXPECT_GE(triangles.size(), 12u);
+    const std::size_t faceCount = triangles.size() / 3;
+
+    std::map<std::pair<std::uint32_t, std::uint32_t>, int> edges;
+    std::set<std::uint32_t> vertices;
+    for (std::size_t face = 0; face < faceCount; ++face) {
+        const std::uint32_t* vertex = &triangles[3 * face];
+        for (int i = 0; i < 3; ++i) {
+            if (vertex[i] >= points.size()) {
+                ADD_FAILURE() << "index " << vertex[i] << " of face " << face << " out of range";
+                return vertices.size();
+            }
+            vertices.insert(vertex[i]);
+            ++edges[{vertex[i], vertex[(i + 1) % 3]}];
+        }
+    }
+
+    for (const auto& [edge, count] : edges) {
+        EXPECT_EQ(count, 1) << "edge " << edge.first << " -> " << edge.second;
+        const auto twin = edges.find({edge.second, edge.first});
+        EXPECT_TRUE(twin != edges.end() && twin->second == 1) << "edge " << edge.first << " -> " << edge.second;
+    }
+    EXPECT_EQ(static_cast<long long>(vertices.size()) - static_cast<long long>(edges.size() / 2) +
+                  static_cast<long long>(faceCount), 2);
+
+    for (std::size_t face = 0; face < faceCount; ++face) {
+        const ei::Vec3& a = points[triangles[3 * face]];
+        const ei::Vec3& b = points[triangles[3 * face + 1]];
+        const ei::Vec3& c = points[triangles[3 * face + 2]];
+        bool below = false;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            const int orientation = orient3d(a, b, c, points[i]);
+            if (orientation < 0) {
+                ADD_FAILURE() << "point " << i << " above face " << face;
+                return vertices.size();
+            }
+            below |= orientation > 0;
+        }
+        EXPECT_TRUE(below) << "degenerate face " << face;
+    }
+    return vertices.size();
+}
+
+static std::vector<ei::Vec3> cubeCorners(float size)
+{
+    std::vector<ei::Vec3> corners;
+    for (int i = 0; i < 8; ++i)
+        corners.push_back(point(i & 1 ? size : 0.0f, i & 2 ? size : 0.0f, i & 4 ? size : 0.0f));
+    return corners;
+}
+
+// Test-Suite 1: Valid Hulls
+
+TEST(QuickHull3DTest, Tetrahedron)
+{
+    const std::vector<ei::Vec3> points = {point(0, 0, 0), point(1, 0, 0), point(0, 1, 0), point(0, 0, 1)};
+    const std::vector<std::uint32_t> triangles = quick_hull_3d(points);
+    EXPECT_EQ(triangles.size(), 12u);
+    EXPECT_EQ(expectValidHull(points, triangles), 4u);
+}
+
+TEST(QuickHull3DTest, RandomPoints)
+{
+    std::mt19937 gen(53);
+    std::normal_distribution<float> normal(0.0f, 100.0f);
+    for (std::size_t size : {4, 5, 10, 100, 3000}) {
+        std::vector<ei::Vec3> gaussian, sphere;
+        for (std::size_t i = 0; i < size; ++i) {
+            const ei::Vec3 p = point(normal(gen), normal(gen), normal(gen));
+            gaussian.push_back(p);
+            const float length = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+            sphere.push_back(point(p.x / length, p.y / length, p.z / length));
+        }
+        expectValidHull(gaussian, quick_hull_3d(gaussian));
+        expectValidHull(sphere, quick_hull_3d(sphere));
+    }
+}
+
+TEST(QuickHull3DTest, CoplanarFacesOfCube)
+{
+    // Corners, points on the edges and sides and inside: every corner is a hull vertex, every other vertex lies on the
+    // surface (a coplanar side may be split at points of the initial tetrahedron)
+    std::mt19937 gen(59);
+    std::uniform_int_distribution<int> coordinate(0, 8);
+    std::vector<ei::Vec3> points;
+    for (int i = 0; i < 5000; ++i)
+        points.push_back(point(float(coordinate(gen)), float(coordinate(gen)), float(coordinate(gen))));
+    for (const ei::Vec3& corner : cubeCorners(8.0f))
+        points.push_back(corner);
+    const std::vector<std::uint32_t> triangles = quick_hull_3d(points);
+    expectValidHull(points, triangles);
+    std::set<std::tuple<float, float, float>> corners;
+    for (const std::uint32_t index : triangles) {
+        const ei::Vec3& p = points[index];
+        EXPECT_TRUE(p.x == 0 || p.x == 8 || p.y == 0 || p.y == 8 || p.z == 0 || p.z == 8);
+        if ((p.x == 0 || p.x == 8) && (p.y == 0 || p.y == 8) && (p.z == 0 || p.z == 8))
+            corners.emplace(p.x, p.y, p.z);
+    }
+    EXPECT_EQ(corners.size(), 8u);
+}
+
+TEST(QuickHull3DTest, DuplicatePoints)
+{
+    // Every corner of the cube many times: one vertex per corner
+    std::mt19937 gen(61);
+    std::vector<ei::Vec3> points;
+    for (int repeat = 0; repeat < 50; ++repeat) {
+        for (const ei::Vec3& corner : cubeCorners(1.0f))
+            points.push_back(corner);
+    }
+    std::shuffle(points.begin(), points.end(), gen);
+    const std::vector<std::uint32_t> triangles = quick_hull_3d(points);
+    EXPECT_EQ(expectValidHull(points, triangles), 8u);
+    std::set<std::tuple<float, float, float>> corners;
+    for (const std::uint32_t index : triangles)
+        corners.emplace(points[index].x, points[index].y, points[index].z);
+    EXPECT_EQ(corners.size(), 8u);
+
+    // Tetrahedron with repeated corners in front of the interior points
+    std::vector<ei::Vec3> tetrahedron(20, point(0, 0, 0));
+    tetrahedron.insert(tetrahedron.end(), 20, point(4, 0, 0));
+    tetrahedron.insert(tetrahedron.end(), 20, point(0, 4, 0));
+    tetrahedron.insert(tetrahedron.end(), 20, point(0, 0, 4));
+    tetrahedron.insert(tetrahedron.end(), 20, point(1, 1, 1));
+    EXPECT_EQ(expectValidHull(tetrahedron, quick_hull_3d(tetrahedron)), 4u);
+}
+
+// Test-Suite 2: Degenerate Input
+
+TEST(QuickHull3DTest, FewerThanFourPoints)
+{
+    EXPECT_TRUE(quick_hull_3d(std::vector<ei::Vec3>{}).empty());
+    EXPECT_TRUE(quick_hull_3d(std::vector<ei::Vec3>{point(1, 2, 3)}).empty());
+    EXPECT_TRUE(quick_hull_3d(std::vector<ei::Vec3>{point(1, 2, 3), point(4, 5, 6)}).empty());
+    EXPECT_TRUE(quick_hull_3d(std::vector<ei::Vec3>{point(0, 0, 0), point(1, 0, 0), point(0, 1, 0)}).empty());
+}
+
+TEST(QuickHull3DTest, CoplanarPointsGiveNoHull)
+{
+    std::mt19937 gen(67);
+    std::uniform_int_distribution<int> coordinate(-100, 100);
+    std::vector<ei::Vec3> horizontal, tilted, line;
+    for (int i = 0; i < 10000; ++i) {
+        const float u = float(coordinate(gen)), v = float(coordinate(gen));
+        horizontal.push_back(point(u, v, 3.0f));
+        // The plane x + 2y - z = 5 with exactly representable coordinates
+        tilted.push_back(point(u, v, u + 2.0f * v - 5.0f));
+        line.push_back(point(u, 2.0f * u, -u));
+    }
+    EXPECT_TRUE(quick_hull_3d(horizontal).empty());
+    EXPECT_TRUE(quick_hull_3d(tilted).empty());
+    EXPECT_TRUE(quick_hull_3d(line).empty());
+    EXPECT_TRUE(quick_hull_3d(std::vector<ei::Vec3>(100, point(7, 8, 9))).empty());
+
+    // One point off the plane is enough for a hull
+    tilted.push_back(point(0, 0, 1000));
+    expectValidHull(tilted, quick_hull_3d(tilted));
+}
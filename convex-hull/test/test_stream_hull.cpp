@@ -0,0 +1,212 @@
+﻿#include "gtest/gtest.h"
+#include "ConvexHull.h"
+#include "MonotoneChain.h"
+#include "PointIO.h"
+#include "StreamHull.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Chunk sizes from the smallest one up, most of them not a multiple of the binary or text record size
+static const std::vector<std::size_t> CHUNK_SIZES = {MIN_STREAM_CHUNK_BYTES, 4100, 5003, 65536, 1 << 20};
+
+// Width of a text line written by textFile ("%+.8e %+.8e\n")
+static constexpr std::size_t TEXT_LINE_BYTES = 32;
+
+// Test files in the temporary directory, removed after every test
+class StreamHullTest : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        for (const std::string& file : files)
+            std::filesystem::remove(file);
+    }
+
+    std::string path(const std::string& name)
+    {
+        files.push_back((std::filesystem::temp_directory_path() / ("convex_hull_test_" + name)).string());
+        return files.back();
+    }
+
+    // Text point file with lines of TEXT_LINE_BYTES (nine significant digits read back to the same float)
+    std::string textFile(const std::string& name, const std::vector<ei::Vec2>& points)
+    {
+        const std::string filename = path(name);
+        std::ofstream output(filename, std::ios::binary | std::ios::trunc);
+        output << points.size() << '\n';
+        char line[64];
+        for (const ei::Vec2& point : points) {
+            std::snprintf(line, sizeof(line), "%+.8e %+.8e\n", point.x, point.y);
+            output << line;
+        }
+        return filename;
+    }
+
+    std::string binaryFile(const std::string& name, const std::vector<ei::Vec2>& points)
+    {
+        const std::string filename = path(name);
+        save_points_binary(filename, points);
+        return filename;
+    }
+
+    /**
+     * Streams both file formats with every chunk size and compares the hull with monotone chain on all points:
+     * exactly for MONOTONE_CHAIN, as vertex set for the other algorithms.
+     */
+    void expectMatchesMonotoneChain(const std::vector<ei::Vec2>& points,
+                                    const std::vector<Algorithm>& algorithms = {MONOTONE_CHAIN})
+    {
+        const std::vector<ei::Vec2> expected = monotone_chain_performance(points);
+        for (const std::string& filename : {binaryFile("stream.bin", points), textFile("stream.txt", points)}) {
+            for (const std::size_t chunkBytes : CHUNK_SIZES) {
+                for (const Algorithm algorithm : algorithms) {
+                    StreamHullStats stats;
+                    const std::vector<ei::Vec2> hull = stream_hull(algorithm, filename, chunkBytes, &stats);
+                    if (algorithm == MONOTONE_CHAIN)
+                        EXPECT_EQ(hull, expected) << filename << " in chunks of " << chunkBytes;
+                    else
+                        EXPECT_EQ(sortedVertices(hull), sortedVertices(expected))
+                            << filename << " in chunks of " << chunkBytes << " with algorithm " << algorithm;
+                    EXPECT_EQ(stats.points, points.size());
+                    EXPECT_EQ(stats.bytes, std::filesystem::file_size(filename));
+                    EXPECT_GE(stats.chunks, stats.bytes / chunkBytes);
+                }
+            }
+        }
+    }
+
+    static std::vector<ei::Vec2> sortedVertices(std::vector<ei::Vec2> hull)
+    {
+        std::sort(hull.begin(), hull.end(), [](const ei::Vec2& a, const ei::Vec2& b) {
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+        });
+        return hull;
+    }
+
+    std::vector<std::string> files;
+};
+
+// Indices of the records of recordBytes (behind headerBytes) that span the end of a chunk read by PointFileReader
+static std::vector<std::size_t> straddlingRecords(std::size_t headerBytes, std::size_t recordBytes, std::size_t count,
+                                                  std::size_t chunkBytes)
+{
+    std::vector<std::size_t> records;
+    for (std::size_t bound = chunkBytes; bound < headerBytes + recordBytes * count; bound += chunkBytes) {
+        if (bound > headerBytes && (bound - headerBytes) % recordBytes != 0)
+            records.push_back((bound - headerBytes) / recordBytes);
+    }
+    return records;
+}
+
+// Points close to the origin with the given records on a circle of radius 1000
+static std::vector<ei::Vec2> hullAtRecords(std::size_t count, const std::vector<std::size_t>& records,
+                                           std::uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::vector<ei::Vec2> points;
+    for (std::size_t i = 0; i < count; ++i)
+        points.emplace_back(normal(gen), normal(gen));
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const float angle = 6.2831853f * static_cast<float>(i) / static_cast<float>(records.size());
+        points[records[i]] = ei::Vec2(1000.0f * std::cos(angle), 1000.0f * std::sin(angle));
+    }
+    return points;
+}
+
+// Test-Suite 1: Stream Hull against Monotone Chain
+
+TEST_F(StreamHullTest, RandomPointsMatchMonotoneChain)
+{
+    std::mt19937 gen(31);
+    std::normal_distribution<float> normal(0.0f, 100.0f);
+    for (std::size_t size : {1, 2, 3, 100, 20000}) {
+        std::vector<ei::Vec2> points;
+        for (std::size_t i = 0; i < size; ++i)
+            points.emplace_back(normal(gen), normal(gen));
+        expectMatchesMonotoneChain(points);
+    }
+}
+
+TEST_F(StreamHullTest, EveryAlgorithmMatchesMonotoneChain)
+{
+    std::mt19937 gen(37);
+    std::uniform_real_distribution<float> uniform(-500.0f, 500.0f);
+    std::vector<ei::Vec2> points;
+    for (int i = 0; i < 5000; ++i)
+        points.emplace_back(uniform(gen), uniform(gen));
+    expectMatchesMonotoneChain(points, {QUICK_HULL, JARVIS_MARCH, DIVIDE_AND_CONQUER, QUICK_HULL_INPLACE,
+                                        QUICK_HULL_PARALLEL, MONOTONE_CHAIN, CHANS_ALGORITHM, QUICK_HULL_SIMD});
+}
+
+TEST_F(StreamHullTest, HullLargerThanChunk)
+{
+    // Every point is a hull point: a chunk of 4096 bytes holds at most 512 of them
+    std::vector<ei::Vec2> circle;
+    for (int i = 0; i < 3000; ++i) {
+        const float angle = 6.2831853f * static_cast<float>(i) / 3000.0f;
+        circle.emplace_back(1e4f * std::cos(angle), 1e4f * std::sin(angle));
+    }
+    std::shuffle(circle.begin(), circle.end(), std::mt19937(41));
+    expectMatchesMonotoneChain(circle);
+}
+
+TEST_F(StreamHullTest, HullPointsStraddlingChunkBoundaries)
+{
+    // Binary records are 8 bytes behind a 16 byte header, text lines have a fixed width behind the count line
+    const std::size_t count = 20000;
+    const std::size_t textHeaderBytes = std::to_string(count).size() + 1;
+    for (const std::size_t chunkBytes : CHUNK_SIZES) {
+        for (const auto& [headerBytes, recordBytes] : {std::pair{POINT_FILE_HEADER_SIZE, std::size_t{8}},
+                                                       std::pair{textHeaderBytes, TEXT_LINE_BYTES}}) {
+            const std::vector<std::size_t> records = straddlingRecords(headerBytes, recordBytes, count, chunkBytes);
+            if (records.size() < 3)
+                continue;
+            const std::vector<ei::Vec2> points = hullAtRecords(count, records, 43);
+            const std::string filename = recordBytes == TEXT_LINE_BYTES ? textFile("straddle.txt", points)
+                                                                        : binaryFile("straddle.bin", points);
+            ASSERT_EQ(std::filesystem::file_size(filename), headerBytes + recordBytes * count);
+            EXPECT_EQ(stream_hull(MONOTONE_CHAIN, filename, chunkBytes), monotone_chain_performance(points))
+                << filename << " in chunks of " << chunkBytes;
+            EXPECT_EQ(sortedVertices(stream_hull(QUICK_HULL, filename, chunkBytes)),
+                      sortedVertices(monotone_chain_performance(points)));
+        }
+    }
+}
+
+TEST_F(StreamHullTest, CollinearAndDuplicatePoints)
+{
+    std::mt19937 gen(47);
+    std::uniform_int_distribution<int> step(0, 2000), coordinate(-3, 3);
+    std::vector<ei::Vec2> line, grid;
+    for (int i = 0; i < 10000; ++i) {
+        const float s = static_cast<float>(step(gen));
+        line.emplace_back(s * 3.0f - 7.0f, s * -2.0f + 11.0f);
+        grid.emplace_back(static_cast<float>(coordinate(gen)), static_cast<float>(coordinate(gen)));
+    }
+    expectMatchesMonotoneChain(line);
+    expectMatchesMonotoneChain(grid);
+}
+
+// Test-Suite 2: Reader Errors
+
+TEST_F(StreamHullTest, ReaderErrors)
+{
+    const std::string filename = binaryFile("errors.bin", {{1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 0.0f}});
+    EXPECT_THROW(PointFileReader(filename, MIN_STREAM_CHUNK_BYTES - 1), std::invalid_argument);
+    EXPECT_THROW(stream_hull(MONOTONE_CHAIN, path("missing.bin")), std::runtime_error);
+
+    // Header announces more points than the file holds
+    std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - 4);
+    EXPECT_THROW(stream_hull(MONOTONE_CHAIN, filename, MIN_STREAM_CHUNK_BYTES), std::runtime_error);
+
+    // The empty point file streams to an empty hull
+    EXPECT_TRUE(stream_hull(MONOTONE_CHAIN, textFile("empty.txt", {}), MIN_STREAM_CHUNK_BYTES).empty());
+}
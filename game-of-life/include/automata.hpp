@@ -0,0 +1,47 @@
+﻿//
+// Created by RINI on 19/10/2026.
+// Multi-state rules running on the generic cellular automaton core
+//
+
+#ifndef AUTOMATA_H
+#define AUTOMATA_H
+
+#include "cellular_automaton.hpp"
+
+// Brian's Brain: 0 ... off, 1 ... on (firing), 2 ... dying
+#define BRIANS_BRAIN_OFF 0
+#define BRIANS_BRAIN_ON 1
+#define BRIANS_BRAIN_DYING 2
+
+constexpr unsigned char briansBrainTransition(unsigned char state, unsigned int firingNeighbors)
+{
+    // Rule: Off cells with exactly 2 firing neighbors fire, firing cells start dying, dying cells turn off
+    switch (state) {
+        case BRIANS_BRAIN_OFF: return firingNeighbors == 2 ? BRIANS_BRAIN_ON : BRIANS_BRAIN_OFF;
+        case BRIANS_BRAIN_ON: return BRIANS_BRAIN_DYING;
+        default: return BRIANS_BRAIN_OFF;
+    }
+}
+
+using BriansBrain = CellularAutomaton<unsigned char, 3, briansBrainTransition>;
+
+// Wireworld: 0 ... empty, 1 ... electron head, 2 ... electron tail, 3 ... conductor
+#define WIREWORLD_EMPTY 0
+#define WIREWORLD_HEAD 1
+#define WIREWORLD_TAIL 2
+#define WIREWORLD_CONDUCTOR 3
+
+constexpr unsigned char wireworldTransition(unsigned char state, unsigned int headNeighbors)
+{
+    // Rule: Heads become tails, tails become conductors, conductors with 1 or 2 neighboring heads become heads
+    switch (state) {
+        case WIREWORLD_HEAD: return WIREWORLD_TAIL;
+        case WIREWORLD_TAIL: return WIREWORLD_CONDUCTOR;
+        case WIREWORLD_CONDUCTOR: return (headNeighbors == 1 || headNeighbors == 2) ? WIREWORLD_HEAD : WIREWORLD_CONDUCTOR;
+        default: return WIREWORLD_EMPTY;
+    }
+}
+
+using Wireworld = CellularAutomaton<unsigned char, 4, wireworldTransition>;
+
+#endif //AUTOMATA_H
@@ -0,0 +1,57 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+
+#ifndef AUTOTUNER_H
+#define AUTOTUNER_H
+
+#include <string>
+#include <vector>
+#include "engine.hpp"
+#include "game_of_life.hpp"
+
+// Engine and thread count picked for a board (either benchmarked or taken from the profile)
+struct TuningChoice {
+    Engine engine;
+    unsigned int threads;
+    double msPerGeneration;
+    int generationsDone; // Generations the game was already advanced by while benchmarking
+    bool cached;         // Choice was read from the on-disk profile
+};
+
+/**
+ * Selects the fastest engine for a board (--mode auto).
+ * Candidates are micro-benchmarked on copies of the actual board for a few generations.
+ * The winning copy replaces the board, so no generation is computed twice.
+ * Decisions are cached in a small text profile keyed by (size, density bucket, threads, CPU model).
+ */
+class AutoTuner {
+public:
+    explicit AutoTuner(std::string profileFile, int sampleGenerations = 4);
+
+    TuningChoice tune(GameOfLife& game, unsigned int maxThreads, int generations);
+
+    static std::string profileKey(const GameOfLife& game, unsigned int maxThreads);
+    static std::string cpuModel();
+
+private:
+    struct Candidate {
+        Engine engine;
+        unsigned int threads;
+    };
+    struct ProfileEntry {
+        std::string key;
+        Engine engine;
+        unsigned int threads;
+        double msPerGeneration;
+    };
+
+    std::string profileFile;
+    int sampleGenerations;
+
+    static std::vector<Candidate> candidates(unsigned int maxThreads);
+    std::vector<ProfileEntry> loadProfile() const;
+    void storeProfile(const std::vector<ProfileEntry>& entries) const;
+};
+
+#endif //AUTOTUNER_H
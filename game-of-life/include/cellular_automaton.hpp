@@ -0,0 +1,388 @@
+﻿//
+// Created by RINI on 19/10/2026.
+// Generalization of the counter-cell engine of GameOfLife (see game_of_life.hpp)
+//
+
+#ifndef CELLULAR_AUTOMATON_H
+#define CELLULAR_AUTOMATON_H
+
+#include <omp.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <type_traits>
+#include <vector>
+
+class MaxThreadExceededException : public std::exception
+{
+public:
+    virtual const char* what() const throw()
+    {
+        return "Number of threads exceeds the maximum number of threads available";
+    }
+};
+
+// NOTE Captured once, since omp_set_num_threads() changes what omp_get_max_threads() reports afterwards
+inline unsigned int maxAvailableThreads()
+{
+    static const unsigned int maxThreads = omp_get_max_threads();
+    return maxThreads;
+}
+
+// Number of bits required to store the given value
+constexpr unsigned int bitsForValue(unsigned int value)
+{
+    unsigned int bits = 0;
+    while (value > 0) {
+        ++bits;
+        value >>= 1;
+    }
+    return bits;
+}
+
+// Next state for every possible raw cell value (state bits + neighbor counter), evaluated at compile time
+template<typename Cell, unsigned int States, auto Transition>
+constexpr std::array<Cell, (1u << (bitsForValue(States - 1) + 4))> buildTransitionTable()
+{
+    constexpr unsigned int stateBits = bitsForValue(States - 1);
+    std::array<Cell, (1u << (stateBits + 4))> table{};
+    for (unsigned int cell = 0; cell < table.size(); ++cell) {
+        const unsigned int state = cell & ((1u << stateBits) - 1);
+        const unsigned int count = cell >> stateBits;
+        // NOTE Unreachable combinations (invalid state or more than 8 neighbors) keep their state
+        table[cell] = (state < States && count <= 8) ? static_cast<Cell>(Transition(static_cast<Cell>(state), count))
+                                                     : static_cast<Cell>(state);
+    }
+    return table;
+}
+
+/**
+ * Generic 2D cellular automaton on a torus (wrap-around) with Moore neighborhood.
+ *
+ * Every cell stores its state in the lowest bits and the number of neighbors in the excited state (state 1,
+ * e.g. alive) in the 4 bits above. Only cells entering or leaving the excited state touch the counters of
+ * their neighbors, and cells which are 0 (quiescent without excited neighbors) are skipped entirely.
+ *
+ * Cell       ... Unsigned integer type storing state and neighbor counter
+ * States     ... Number of states (0 == quiescent, 1 == excited, others are rule specific)
+ * Transition ... constexpr function (state, excited neighbors) -> next state, compiled into a lookup table
+ */
+template<typename Cell, unsigned int States, auto Transition>
+class CellularAutomaton {
+public:
+    static_assert(std::is_integral<Cell>::value && std::is_unsigned<Cell>::value, "Cell type must be an unsigned integer.");
+    static_assert(States >= 2, "At least two states are required.");
+
+    static constexpr unsigned int STATE_BITS = bitsForValue(States - 1);
+    static constexpr Cell STATE_MASK = static_cast<Cell>((1u << STATE_BITS) - 1);
+    static constexpr Cell COUNTER_INCREMENT = static_cast<Cell>(1u << STATE_BITS);
+    static constexpr unsigned int EXCITED_STATE = 1;
+
+    static_assert(STATE_BITS + 4 <= sizeof(Cell) * 8, "Cell type is too small for state and neighbor counter (0-8).");
+    static_assert(Transition(static_cast<Cell>(0), 0u) == 0, "Quiescent cells without excited neighbors must stay quiescent.");
+
+    CellularAutomaton(unsigned int rows, unsigned int columns, bool parallel = false, unsigned int threads = 1);
+    CellularAutomaton(const CellularAutomaton& other); // Deep copy of the grid (e.g. to benchmark engines on the same board)
+    CellularAutomaton& operator=(const CellularAutomaton& other);
+    ~CellularAutomaton();
+
+    void next(); // Advance to the next generation (sequential)
+    void nextP(); // Advance to the next generation (parallel)
+    void update(int generations); // Advance X generations
+
+    void setState(unsigned int row, unsigned int col, unsigned int state); // Set cell state (sequential)
+    unsigned int getState(unsigned int row, unsigned int col) const; // Get cell state (sequential)
+    unsigned long long count(unsigned int state) const; // Count cells in the given state (parallel)
+
+    void loadStates(const unsigned char* states); // Replace all cells by row-major states (parallel)
+    void storeStates(unsigned char* states) const; // Write all cells as row-major states (parallel)
+
+    inline unsigned int getRows() const { return rows; }
+    inline unsigned int getColumns() const { return columns; }
+    inline unsigned int getThreads() const { return threads; }
+    void setThreads(unsigned int threads); // Change number of threads used by nextP()
+
+protected:
+    static constexpr auto TRANSITIONS = buildTransitionTable<Cell, States, Transition>();
+
+    unsigned int rows;
+    unsigned int columns;
+    size_t gridSize;
+    bool parallel;
+    unsigned int threads;
+    Cell *grid; // Current grid
+    Cell *prevGrid; // Previous grid (unaltered)
+
+    inline void addToNeighbors(unsigned int row, unsigned int col, Cell delta); // Change counters of the 8 neighbors
+    inline void processRow(unsigned int row); // Apply transitions to a row (reads prevGrid, writes grid)
+    void initialize_neighbor_counts(); // Derive neighbor counters from plain cell states in grid
+};
+
+template<typename Cell, unsigned int States, auto Transition>
+CellularAutomaton<Cell, States, Transition>::CellularAutomaton(unsigned int rows, unsigned int columns, bool parallel, unsigned int threads)
+    : rows(rows), columns(columns), gridSize(static_cast<size_t>(rows) * columns), parallel(parallel), threads(1)
+{
+    if (threads > maxAvailableThreads()) {
+        throw MaxThreadExceededException();
+    }
+    grid = new Cell[gridSize];
+    prevGrid = new Cell[gridSize];
+    std::memset(grid, 0, gridSize * sizeof(Cell));
+    std::memset(prevGrid, 0, gridSize * sizeof(Cell));
+    setThreads(threads);
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+CellularAutomaton<Cell, States, Transition>::CellularAutomaton(const CellularAutomaton& other)
+    : rows(other.rows), columns(other.columns), gridSize(other.gridSize), parallel(other.parallel), threads(other.threads)
+{
+    grid = new Cell[gridSize];
+    prevGrid = new Cell[gridSize];
+    std::memcpy(grid, other.grid, gridSize * sizeof(Cell));
+    std::memset(prevGrid, 0, gridSize * sizeof(Cell));
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+CellularAutomaton<Cell, States, Transition>& CellularAutomaton<Cell, States, Transition>::operator=(const CellularAutomaton& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+    if (gridSize != other.gridSize) {
+        delete[] grid;
+        delete[] prevGrid;
+        grid = new Cell[other.gridSize];
+        prevGrid = new Cell[other.gridSize];
+    }
+    rows = other.rows;
+    columns = other.columns;
+    gridSize = other.gridSize;
+    parallel = other.parallel;
+    threads = other.threads;
+    std::memcpy(grid, other.grid, gridSize * sizeof(Cell));
+    std::memset(prevGrid, 0, gridSize * sizeof(Cell));
+    return *this;
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+CellularAutomaton<Cell, States, Transition>::~CellularAutomaton()
+{
+    delete[] grid;
+    delete[] prevGrid;
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+void CellularAutomaton<Cell, States, Transition>::setThreads(unsigned int threads)
+{
+    if (threads > maxAvailableThreads()) {
+        throw MaxThreadExceededException();
+    }
+    this->threads = threads;
+    omp_set_num_threads(this->threads);
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+inline void CellularAutomaton<Cell, States, Transition>::addToNeighbors(unsigned int row, unsigned int col, Cell delta)
+{
+    const ptrdiff_t w = columns; // Width
+    const ptrdiff_t size = static_cast<ptrdiff_t>(gridSize);
+
+    // Offsets to calculate the eight neighboring cells (accounting for wrap-around)
+    const ptrdiff_t cellOffsetLeft = (col == 0) ? w - 1 : -1;
+    const ptrdiff_t cellOffsetRight = (col == columns - 1) ? -(w - 1) : 1;
+    const ptrdiff_t cellOffsetUp = (row == 0) ? size - w : -w;
+    const ptrdiff_t cellOffsetDown = (row == rows - 1) ? -(size - w) : w;
+
+    Cell *cellPtr = grid + static_cast<ptrdiff_t>(row) * w + col;
+
+    /* NOTE The eight neighboring cells are:
+     * AL A AR
+     * L  x  R
+     * BL B BR
+     * NOTE Adding the two's complement of the increment decrements the counters (unsigned wrap-around)
+     */
+    *(cellPtr + cellOffsetLeft) += delta; // L
+    *(cellPtr + cellOffsetRight) += delta; // R
+    *(cellPtr + cellOffsetUp) += delta; // A
+    *(cellPtr + cellOffsetDown) += delta; // B
+    *(cellPtr + cellOffsetUp + cellOffsetLeft) += delta; // AL
+    *(cellPtr + cellOffsetUp + cellOffsetRight) += delta; // AR
+    *(cellPtr + cellOffsetDown + cellOffsetLeft) += delta; // BL
+    *(cellPtr + cellOffsetDown + cellOffsetRight) += delta; // BR
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+inline void CellularAutomaton<Cell, States, Transition>::processRow(unsigned int row)
+{
+    const size_t rowStart = static_cast<size_t>(row) * columns;
+    const Cell *cellPtr = prevGrid + rowStart;
+    for (unsigned int col = 0; col < columns; ++col, ++cellPtr) {
+        const Cell cell = *cellPtr;
+        // Skip quiescent cells without excited neighbors
+        if (cell == 0) {
+            continue;
+        }
+        const Cell state = cell & STATE_MASK;
+        const Cell nextState = TRANSITIONS[cell];
+        if (nextState == state) {
+            continue;
+        }
+        Cell& target = grid[rowStart + col];
+        target = static_cast<Cell>((target & ~STATE_MASK) | nextState);
+        if (state == EXCITED_STATE) {
+            addToNeighbors(row, col, static_cast<Cell>(-COUNTER_INCREMENT));
+        } else if (nextState == EXCITED_STATE) {
+            addToNeighbors(row, col, COUNTER_INCREMENT);
+        }
+    }
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+void CellularAutomaton<Cell, States, Transition>::next()
+{
+    // Make copy of the current grid (unaltered)
+    std::memcpy(prevGrid, grid, gridSize * sizeof(Cell));
+
+    for (unsigned int row = 0; row < rows; ++row) {
+        processRow(row);
+    }
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+void CellularAutomaton<Cell, States, Transition>::nextP()
+{
+    // Calculate the number of threads based on the board size
+    const int max_possible_threads = static_cast<int>(rows / 3); // Minimum rows per thread (1 data row + 2 ghost rows)
+    const int num_threads = std::min(static_cast<int>(threads), max_possible_threads);
+    if (num_threads < 1) {
+        next(); // Board is too small to be split
+        return;
+    }
+
+    std::memcpy(prevGrid, grid, gridSize * sizeof(Cell));
+
+    // ghostRowCount is the amount of leftover rows that are not assigned to any thread
+    // Additionally, we calculate the number of rows each thread will handle
+    // Lastly, we calculate the leftover rows that are not divisible by the number of threads (i.e. remainder)
+    const unsigned int ghostRowCount = num_threads + num_threads;
+    const unsigned int numOfRowsForEachThread = (rows - ghostRowCount) / num_threads;
+    const unsigned int leftover = (rows - ghostRowCount) % num_threads;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        // NOTE Chunks are distributed round-robin, so all of them are processed even if OpenMP provides fewer threads
+        for (int chunk = omp_get_thread_num(); chunk < num_threads; chunk += omp_get_num_threads()) {
+            // Every chunk is followed by 2 ghost rows and then the next chunk starts
+            const unsigned int start = chunk * numOfRowsForEachThread + (chunk * 2);
+            const unsigned int end = start + numOfRowsForEachThread;
+            for (unsigned int row = start; row < end; ++row) {
+                processRow(row);
+            }
+        }
+    } // end parallel region
+
+    // Process the ghost rows of every chunk and the leftover rows sequentially
+    for (int chunk = 0; chunk < num_threads; ++chunk) {
+        const unsigned int firstGhostRow = numOfRowsForEachThread * (chunk + 1) + (chunk * 2);
+        processRow(firstGhostRow);
+        processRow(firstGhostRow + 1);
+    }
+    for (unsigned int row = rows - leftover; row < rows; ++row) {
+        processRow(row);
+    }
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+void CellularAutomaton<Cell, States, Transition>::update(int generations)
+{
+    if (parallel) {
+        for (int i = 0; i < generations; ++i) {
+            nextP();
+        }
+    } else {
+        for (int i = 0; i < generations; ++i) {
+            next();
+        }
+    }
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+void CellularAutomaton<Cell, States, Transition>::setState(unsigned int row, unsigned int col, unsigned int state)
+{
+    Cell& cell = grid[static_cast<size_t>(row) * columns + col];
+    const unsigned int previousState = cell & STATE_MASK;
+    if (state == previousState) {
+        return;
+    }
+    cell = static_cast<Cell>((cell & ~STATE_MASK) | state);
+    if (previousState == EXCITED_STATE) {
+        addToNeighbors(row, col, static_cast<Cell>(-COUNTER_INCREMENT));
+    } else if (state == EXCITED_STATE) {
+        addToNeighbors(row, col, COUNTER_INCREMENT);
+    }
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+unsigned int CellularAutomaton<Cell, States, Transition>::getState(unsigned int row, unsigned int col) const
+{
+    return grid[static_cast<size_t>(row) * columns + col] & STATE_MASK;
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+unsigned long long CellularAutomaton<Cell, States, Transition>::count(unsigned int state) const
+{
+    unsigned long long cells = 0;
+    #pragma omp parallel for reduction(+:cells)
+    for (long long i = 0; i < static_cast<long long>(gridSize); ++i) {
+        cells += (grid[i] & STATE_MASK) == state;
+    }
+    return cells;
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+void CellularAutomaton<Cell, States, Transition>::loadStates(const unsigned char* states)
+{
+    #pragma omp parallel for num_threads(omp_get_num_procs()) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(gridSize); ++i) {
+        grid[i] = static_cast<Cell>(states[i] & STATE_MASK);
+    }
+    initialize_neighbor_counts();
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+void CellularAutomaton<Cell, States, Transition>::storeStates(unsigned char* states) const
+{
+    #pragma omp parallel for num_threads(omp_get_num_procs()) schedule(static)
+    for (long long i = 0; i < static_cast<long long>(gridSize); ++i) {
+        states[i] = static_cast<unsigned char>(grid[i] & STATE_MASK);
+    }
+}
+
+template<typename Cell, unsigned int States, auto Transition>
+void CellularAutomaton<Cell, States, Transition>::initialize_neighbor_counts()
+{
+    // NOTE Gathering (instead of scattering via addToNeighbors) lets every row be processed independently
+    // Wrap-around is handled the same way as in addToNeighbors, so small boards count duplicate neighbors identically
+    const Cell *states = grid;
+    Cell *cells = prevGrid;
+    #pragma omp parallel for num_threads(omp_get_num_procs()) schedule(static)
+    for (long long row = 0; row < static_cast<long long>(rows); ++row) {
+        const Cell *above = states + static_cast<size_t>(row == 0 ? rows - 1 : row - 1) * columns;
+        const Cell *current = states + static_cast<size_t>(row) * columns;
+        const Cell *below = states + static_cast<size_t>(row == rows - 1 ? 0 : row + 1) * columns;
+        Cell *cellPtr = cells + static_cast<size_t>(row) * columns;
+        for (unsigned int col = 0; col < columns; ++col) {
+            const unsigned int left = (col == 0) ? columns - 1 : col - 1;
+            const unsigned int right = (col == columns - 1) ? 0 : col + 1;
+            const unsigned int count = (above[left] == EXCITED_STATE) + (above[col] == EXCITED_STATE) + (above[right] == EXCITED_STATE)
+                                     + (current[left] == EXCITED_STATE) + (current[right] == EXCITED_STATE)
+                                     + (below[left] == EXCITED_STATE) + (below[col] == EXCITED_STATE) + (below[right] == EXCITED_STATE);
+            cellPtr[col] = static_cast<Cell>(count * COUNTER_INCREMENT | current[col]);
+        }
+    }
+    std::swap(grid, prevGrid);
+}
+
+#endif //CELLULAR_AUTOMATON_H
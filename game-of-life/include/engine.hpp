@@ -0,0 +1,26 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <string>
+#include <vector>
+#include "game_of_life.hpp"
+
+// Generation engines which can be selected via --mode
+enum class Engine {
+    SEQUENTIAL, // Counter-cell engine on a single thread (next)
+    PARALLEL,     // Counter-cell engine on OpenMP row chunks (nextP)
+    MULTI_PROCESS // Counter-cell engine on worker processes exchanging halo rows (multiprocess.hpp, Linux only)
+};
+
+std::string engineToString(Engine engine);
+bool engineFromString(const std::string& mode, Engine& engine); // Accepts 'seq'/'sequential', 'par'/'parallel', 'omp' & 'mp'/'multi'
+bool engineIsParallel(Engine engine); // Whether the engine makes use of the --threads option (worker processes in 'mp')
+const std::vector<Engine>& allEngines(); // All engines supported on this platform in the order they are benchmarked
+
+void runEngine(GameOfLife& game, Engine engine, int generations); // Advance X generations using the given engine
+
+#endif //ENGINE_H
@@ -6,8 +6,11 @@
 #ifndef GAME_OF_LIFE_H
 #define GAME_OF_LIFE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
+#include "cellular_automaton.hpp"
 
 #define RULE_BECOME_ALIVE_NEIGHBORS 3
 #define RULE_STAY_ALIVE_MIN 2
@@ -25,37 +28,35 @@
 #define CELL_DEACTIVATE(x) (x &= 0xFE)
 
 
-class GameOfLife {
+// Game of Life rules (B3/S23), compiled into the transition table of the generic automaton core
+constexpr unsigned char lifeTransition(unsigned char alive, unsigned int neighbors)
+{
+    return alive ? (neighbors >= RULE_STAY_ALIVE_MIN && neighbors <= RULE_STAY_ALIVE_MAX)
+                 : (neighbors == RULE_BECOME_ALIVE_NEIGHBORS);
+}
+
+using LifeAutomaton = CellularAutomaton<unsigned char, 2, lifeTransition>;
+static_assert(LifeAutomaton::COUNTER_INCREMENT == CELL_COUNTER_INCREMENT, "Cell layout must match the CELL_* macros.");
+
+class GameOfLife : public LifeAutomaton {
 public:
     GameOfLife(unsigned int rows, unsigned int columns, bool parallel = false, unsigned int threads = 1);
     GameOfLife(unsigned int rows, unsigned int columns, bool parallel, unsigned int threads, const std::vector<std::vector<char>>& seed);
-    ~GameOfLife();
-
-    void next(); // Advance to the next generation (sequential)
-    void nextP(); // Advance to the next generation (parallel)
-    void update(int generations); // Advance X generations
 
     void setCell(unsigned int row, unsigned int col); // Set cell state (sequential)
     void clearCell(unsigned int row, unsigned int col); // Clear cell state (sequential)
     char cellState(unsigned int row, unsigned int col) const; // Get cell state (sequential)
+    unsigned long long population() const; // Count living cells (parallel)
 
     std::vector<std::vector<char>> getGrid() const; // Get current grid as 2D character vector
 
     static GameOfLife* fromFile(const std::string& filename, bool parallel = false, unsigned int threads = 1); // Initialize game from file
+    static GameOfLife* fromRandom(unsigned int rows, unsigned int columns, double density, uint64_t seed, bool parallel = false, unsigned int threads = 1); // Initialize game with reproducible random cells
     void toFile(const std::string& filename) const; // Save current grid to file
-
-    inline unsigned int getRows() const { return rows; }
-    inline unsigned int getColumns() const { return columns; }
+    static GameOfLife* fromBuffer(const char* data, size_t size, bool parallel = false, unsigned int threads = 1); // Initialize game from file contents in memory
+    size_t toBuffer(char* data, size_t size) const; // Write file contents to memory (if size suffices), returns required bytes
 
 private:
-    unsigned int rows;
-    unsigned int columns;
-    unsigned int gridSize;
-    bool parallel;
-    unsigned int threads;
-    unsigned char *grid; // Current grid
-    unsigned char *prevGrid; // Previous grid (unaltered)
-
     void initialize_from_seed(const std::vector<std::vector<char>>& seed); // Initialize grid from seed
 };
 
@@ -0,0 +1,105 @@
+﻿//
+// Created by RINI on 19/10/2026.
+// Header-only RAII wrapper of the C API (gol_c_api.h) for C++ programs embedding the shared library
+//
+
+#ifndef GOL_H
+#define GOL_H
+
+#include "gol_c_api.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gol {
+
+// Thrown for every status other than GOL_OK
+class Error : public std::runtime_error {
+public:
+    Error(gol_status status, const std::string& message) : std::runtime_error(message), status(status) {}
+    gol_status code() const { return status; }
+
+private:
+    gol_status status;
+};
+
+inline void check(gol_status status)
+{
+    if (status != GOL_OK) {
+        throw Error(status, gol_last_error());
+    }
+}
+
+// Owning, move-only handle of a board
+class Game {
+public:
+    Game(unsigned int rows, unsigned int columns, unsigned int threads = 1)
+    {
+        gol_game* created = nullptr;
+        check(gol_create(rows, columns, threads, &created));
+        handle.reset(created);
+    }
+
+    static Game load(std::string_view text, unsigned int threads = 1)
+    {
+        gol_game* loaded = nullptr;
+        check(gol_load(text.data(), text.size(), threads, &loaded));
+        return Game(loaded);
+    }
+
+    void step(unsigned int generations = 1) { check(gol_step(handle.get(), generations)); }
+
+    unsigned int rows() const { return gol_rows(handle.get()); }
+    unsigned int columns() const { return gol_columns(handle.get()); }
+    unsigned long long population() const { return gol_population(handle.get()); }
+    bool alive(unsigned int row, unsigned int col) const
+    {
+        const int state = gol_cell(handle.get(), row, col);
+        if (state < 0) {
+            throw Error(GOL_ERROR_INVALID_ARGUMENT, "Cell out of range.");
+        }
+        return state == 1;
+    }
+
+    // Row-major cells (0 == dead, 1 == alive) in caller-owned memory
+    void setCells(const unsigned char* cells, size_t size) { check(gol_set_cells(handle.get(), cells, size)); }
+    void getCells(unsigned char* cells, size_t size) const { check(gol_get_cells(handle.get(), cells, size)); }
+
+    // .gol file contents written into caller-owned memory, returns the number of bytes written
+    size_t exportTo(char* text, size_t size) const
+    {
+        size_t written = 0;
+        check(gol_export(handle.get(), text, size, &written));
+        return written;
+    }
+
+    size_t exportSize() const
+    {
+        size_t required = 0;
+        gol_export(handle.get(), nullptr, 0, &required);
+        return required;
+    }
+
+    std::string exportText() const
+    {
+        std::string text(exportSize(), '\0');
+        exportTo(text.data(), text.size());
+        return text;
+    }
+
+    gol_game* get() const { return handle.get(); }
+
+private:
+    struct Deleter {
+        void operator()(gol_game* game) const { gol_destroy(game); }
+    };
+    std::unique_ptr<gol_game, Deleter> handle;
+
+    explicit Game(gol_game* game) : handle(game) {}
+};
+
+} // namespace gol
+
+#endif //GOL_H
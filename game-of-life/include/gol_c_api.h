@@ -0,0 +1,72 @@
+﻿/*
+ * Created by RINI on 19/10/2026.
+ * Stable C interface of the Game of Life engine (shared library "gol"), e.g. for Python (ctypes/cffi) or Go (cgo).
+ * All functions are exception-free. Errors are reported as gol_status and described by gol_last_error().
+ * Board buffers always belong to the caller and are read/written in place.
+ */
+
+#ifndef GOL_C_API_H
+#define GOL_C_API_H
+
+#include <stddef.h>
+
+#if defined(GOL_STATIC)
+    #define GOL_API
+#elif defined(_WIN32)
+    #ifdef GOL_BUILDING_LIBRARY
+        #define GOL_API __declspec(dllexport)
+    #else
+        #define GOL_API __declspec(dllimport)
+    #endif
+#else
+    #define GOL_API __attribute__((visibility("default")))
+#endif
+
+#define GOL_API_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct gol_game gol_game; /* Opaque handle, released with gol_destroy() */
+
+typedef enum gol_status {
+    GOL_OK = 0,
+    GOL_ERROR_INVALID_ARGUMENT = 1, /* NULL handle/buffer, zero dimensions or coordinates out of range */
+    GOL_ERROR_INVALID_FORMAT = 2,   /* Board text does not follow the .gol file format */
+    GOL_ERROR_BUFFER_TOO_SMALL = 3, /* Required size is reported through the size output parameter */
+    GOL_ERROR_THREADS = 4,          /* Requested threads exceed the available threads */
+    GOL_ERROR_OUT_OF_MEMORY = 5,
+    GOL_ERROR_INTERNAL = 6
+} gol_status;
+
+GOL_API int gol_api_version(void); /* GOL_API_VERSION the library was built with */
+GOL_API const char* gol_last_error(void); /* Message of the last failed call on this thread ("" if none) */
+
+/* Create an empty (all dead) board. threads > 1 selects the parallel engine. */
+GOL_API gol_status gol_create(unsigned int rows, unsigned int columns, unsigned int threads, gol_game** game);
+/* Create a board from .gol file contents ("<columns>,<rows>\n" followed by rows of '.'/'x'). */
+GOL_API gol_status gol_load(const char* text, size_t size, unsigned int threads, gol_game** game);
+GOL_API void gol_destroy(gol_game* game); /* Accepts NULL */
+
+/* Replace / read all cells as rows * columns bytes in row-major order (0 == dead, 1 == alive). */
+GOL_API gol_status gol_set_cells(gol_game* game, const unsigned char* cells, size_t size);
+GOL_API gol_status gol_get_cells(const gol_game* game, unsigned char* cells, size_t size);
+
+/* Advance the board by the given number of generations. */
+GOL_API gol_status gol_step(gol_game* game, unsigned int generations);
+
+GOL_API unsigned int gol_rows(const gol_game* game); /* 0 for NULL */
+GOL_API unsigned int gol_columns(const gol_game* game); /* 0 for NULL */
+GOL_API unsigned long long gol_population(const gol_game* game); /* Number of living cells, 0 for NULL */
+GOL_API int gol_cell(const gol_game* game, unsigned int row, unsigned int col); /* 1 alive, 0 dead, -1 invalid */
+
+/* Write the board as .gol file contents. *written receives the bytes written, or the required size if
+ * the buffer is too small (call with text == NULL to query the size). The text is not NUL-terminated. */
+GOL_API gol_status gol_export(const gol_game* game, char* text, size_t size, size_t* written);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GOL_C_API_H */
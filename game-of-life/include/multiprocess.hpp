@@ -0,0 +1,26 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+
+#ifndef MULTIPROCESS_H
+#define MULTIPROCESS_H
+
+#include "game_of_life.hpp"
+
+// Configuration of the multi-process engine (--mode mp)
+struct MultiProcessConfig {
+    unsigned int workers; // Number of worker processes, each one owns a horizontal slab of rows
+    bool pin;             // Pin every worker to its own contiguous share of the allowed CPUs
+};
+
+bool multiProcessSupported(); // Requires Linux (POSIX shared memory, futex, fork)
+
+/**
+ * Advance X generations using worker processes on the local machine.
+ * Every worker simulates its slab framed by one halo row above and below. After each generation the
+ * boundary rows are published through double-buffered POSIX shared memory and signalled via futex,
+ * so the neighbors can continue while the interior of the slab is computed.
+ */
+void runMultiProcess(GameOfLife& game, int generations, const MultiProcessConfig& config);
+
+#endif //MULTIPROCESS_H
@@ -0,0 +1,24 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SweepConfig {
+    std::vector<int> sizes;   // Square board sizes (columns == rows)
+    std::vector<int> threads; // Thread counts for parallel engines
+    int generations;
+    double density;
+    uint64_t seed;
+    std::string reportFile;
+};
+
+// Run every engine across all sizes and thread counts on generated boards and write one scaling report (CSV)
+int runSweep(const SweepConfig& config);
+
+#endif //SWEEP_H
@@ -0,0 +1,169 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+
+#include "autotuner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+AutoTuner::AutoTuner(std::string profileFile, int sampleGenerations)
+    : profileFile(std::move(profileFile)), sampleGenerations(sampleGenerations)
+{
+}
+
+TuningChoice AutoTuner::tune(GameOfLife& game, unsigned int maxThreads, int generations)
+{
+    const std::string key = profileKey(game, maxThreads);
+    std::vector<ProfileEntry> entries = loadProfile();
+    for (const ProfileEntry& entry : entries) {
+        if (entry.key == key) {
+            std::clog << "Auto-tuner: Using cached choice '" << engineToString(entry.engine) << "' with " << entry.threads
+                      << " threads (" << entry.msPerGeneration << " ms/generation) for " << key << std::endl;
+            game.setThreads(entry.threads);
+            return TuningChoice{entry.engine, entry.threads, entry.msPerGeneration, 0, true};
+        }
+    }
+
+    const int samples = std::min(sampleGenerations, generations);
+    if (samples <= 0) {
+        // Nothing to measure on, fall back to the sequential engine without caching anything
+        game.setThreads(1);
+        return TuningChoice{Engine::SEQUENTIAL, 1, 0.0, 0, false};
+    }
+
+    // Benchmark every candidate on a copy of the board and keep the copy of the fastest one
+    std::unique_ptr<GameOfLife> fastest;
+    TuningChoice choice{Engine::SEQUENTIAL, 1, 0.0, samples, false};
+    for (const Candidate& candidate : candidates(maxThreads)) {
+        std::unique_ptr<GameOfLife> trial(new GameOfLife(game));
+        trial->setThreads(candidate.threads);
+        const auto start = std::chrono::high_resolution_clock::now();
+        runEngine(*trial, candidate.engine, samples);
+        const auto end = std::chrono::high_resolution_clock::now();
+        const double msPerGeneration = std::chrono::duration<double, std::milli>(end - start).count() / samples;
+
+        std::clog << "Auto-tuner: '" << engineToString(candidate.engine) << "' with " << candidate.threads << " threads: "
+                  << msPerGeneration << " ms/generation" << std::endl;
+        if (!fastest || msPerGeneration < choice.msPerGeneration) {
+            fastest = std::move(trial);
+            choice.engine = candidate.engine;
+            choice.threads = candidate.threads;
+            choice.msPerGeneration = msPerGeneration;
+        }
+    }
+
+    // Continue from the state of the fastest candidate (all engines compute identical generations)
+    game = *fastest;
+    game.setThreads(choice.threads);
+    std::clog << "Auto-tuner: Selected '" << engineToString(choice.engine) << "' with " << choice.threads
+              << " threads for " << key << std::endl;
+
+    entries.push_back(ProfileEntry{key, choice.engine, choice.threads, choice.msPerGeneration});
+    storeProfile(entries);
+    return choice;
+}
+
+std::string AutoTuner::profileKey(const GameOfLife& game, unsigned int maxThreads)
+{
+    // Density is bucketed in steps of 10%, since the exact population changes every generation
+    const unsigned long long cells = static_cast<unsigned long long>(game.getRows()) * game.getColumns();
+    const unsigned long long densityBucket = cells > 0 ? game.population() * 10 / cells : 0;
+
+    std::ostringstream key;
+    key << game.getColumns() << "x" << game.getRows() << ";d" << densityBucket << ";t" << maxThreads << ";" << cpuModel();
+    return key.str();
+}
+
+std::string AutoTuner::cpuModel()
+{
+    std::string model;
+#ifdef _WIN32
+    const char* identifier = std::getenv("PROCESSOR_IDENTIFIER");
+    if (identifier) {
+        model = identifier;
+    }
+#else
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            const size_t start = line.find_first_not_of(" \t", line.find(':') + 1);
+            if (start != std::string::npos) {
+                model = line.substr(start);
+            }
+            break;
+        }
+    }
+#endif
+    if (model.empty()) {
+        return "unknown";
+    }
+    // NOTE ';' separates the fields of the profile
+    std::replace(model.begin(), model.end(), ';', ',');
+    return model;
+}
+
+std::vector<AutoTuner::Candidate> AutoTuner::candidates(unsigned int maxThreads)
+{
+    std::vector<Candidate> result;
+    result.push_back(Candidate{Engine::SEQUENTIAL, 1});
+    // Powers of two up to the allowed thread count, since more threads are not always faster on small boards
+    for (unsigned int threads = 1; threads < maxThreads; threads *= 2) {
+        result.push_back(Candidate{Engine::PARALLEL, threads});
+    }
+    if (maxThreads > 0) {
+        result.push_back(Candidate{Engine::PARALLEL, maxThreads});
+    }
+    return result;
+}
+
+std::vector<AutoTuner::ProfileEntry> AutoTuner::loadProfile() const
+{
+    std::vector<ProfileEntry> entries;
+    std::ifstream profile(profileFile);
+    std::string line;
+    while (std::getline(profile, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        // Format: <key>;<engine>;<threads>;<ms per generation> (the key itself contains ';')
+        const size_t msPos = line.rfind(';');
+        const size_t threadsPos = msPos == std::string::npos ? std::string::npos : line.rfind(';', msPos - 1);
+        const size_t enginePos = threadsPos == std::string::npos ? std::string::npos : line.rfind(';', threadsPos - 1);
+        if (enginePos == std::string::npos) {
+            continue;
+        }
+        ProfileEntry entry;
+        entry.key = line.substr(0, enginePos);
+        try {
+            if (!engineFromString(line.substr(enginePos + 1, threadsPos - enginePos - 1), entry.engine)) {
+                continue;
+            }
+            entry.threads = std::stoi(line.substr(threadsPos + 1, msPos - threadsPos - 1));
+            entry.msPerGeneration = std::stod(line.substr(msPos + 1));
+        } catch (const std::exception&) {
+            continue; // Ignore broken entries, they are re-tuned
+        }
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+void AutoTuner::storeProfile(const std::vector<ProfileEntry>& entries) const
+{
+    std::ofstream profile(profileFile);
+    if (!profile.is_open()) {
+        std::cerr << "Warning: Failed to write auto-tuner profile " << profileFile << std::endl;
+        return;
+    }
+    profile << "# columns x rows;density bucket;threads;cpu model;engine;engine threads;ms per generation" << std::endl;
+    for (const ProfileEntry& entry : entries) {
+        profile << entry.key << ";" << engineToString(entry.engine) << ";" << entry.threads << ";" << entry.msPerGeneration << std::endl;
+    }
+}
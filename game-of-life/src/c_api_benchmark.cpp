@@ -0,0 +1,131 @@
+﻿//
+// Created by RINI on 19/10/2026.
+// Compares embedding the engine (shared library, C API) with spawning the CLI per request (file round-trip)
+//
+
+#include "cxxopts.hpp"
+#include "gol.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Random board in .gol format, built through the C API itself
+static std::string generateBoard(unsigned int size, double density, unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::bernoulli_distribution alive(density);
+    std::vector<unsigned char> cells(static_cast<size_t>(size) * size);
+    for (unsigned char& cell : cells) {
+        cell = alive(generator) ? 1 : 0;
+    }
+    gol::Game game(size, size);
+    game.setCells(cells.data(), cells.size());
+    return game.exportText();
+}
+
+static std::string readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+int main(int argc, char* argv[]) {
+    cxxopts::Options options(argv[0], " - Benchmark the in-process C API against spawning the CLI");
+    options.add_options()
+        ("cli", "Path of the game_of_life executable used for the CLI path", cxxopts::value<std::string>()->default_value("./game_of_life"))
+        ("size", "Board size (square)", cxxopts::value<int>()->default_value("250"))
+        ("density", "Probability of a cell being alive", cxxopts::value<double>()->default_value("0.3"))
+        ("g,generations", "Number of generations per request", cxxopts::value<int>()->default_value("10"))
+        ("r,requests", "Number of requests per path", cxxopts::value<int>()->default_value("20"))
+        ("h,help", "Print usage");
+
+    cxxopts::ParseResult result;
+    try {
+        result = options.parse(argc, argv);
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cerr << "Error parsing options: " << e.what() << std::endl;
+        return 1;
+    }
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return 0;
+    }
+
+    const std::string cli = result["cli"].as<std::string>();
+    const int size = result["size"].as<int>();
+    const int generations = result["generations"].as<int>();
+    const int requests = result["requests"].as<int>();
+    if (size <= 0 || generations < 0 || requests <= 0) {
+        std::cerr << "Error: Size and requests must be positive, generations must not be negative." << std::endl;
+        return 1;
+    }
+
+    try {
+        const std::string board = generateBoard(size, result["density"].as<double>(), 42);
+
+        // In-process: parse from memory, step, export into a reused buffer
+        std::vector<char> output(board.size());
+        std::string inProcessResult;
+        const auto inProcessStart = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < requests; ++i) {
+            gol::Game game = gol::Game::load(board);
+            game.step(generations);
+            const size_t written = game.exportTo(output.data(), output.size());
+            if (i == 0) {
+                inProcessResult.assign(output.data(), written);
+            }
+        }
+        const auto inProcessEnd = std::chrono::high_resolution_clock::now();
+
+        // CLI: write the board to a file, spawn the executable, read the saved board back
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::filesystem::path inputFile = directory / "gol_c_api_benchmark_in.gol";
+        const std::filesystem::path outputFile = directory / "gol_c_api_benchmark_out.gol";
+        const std::string command = "\"" + cli + "\" --load \"" + inputFile.string() + "\" --save \"" + outputFile.string()
+                                  + "\" --generations " + std::to_string(generations);
+        std::string cliResult;
+        const auto cliStart = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < requests; ++i) {
+            std::ofstream(inputFile, std::ios::binary) << board;
+            if (std::system(command.c_str()) != 0) {
+                std::cerr << "Error: Failed to run '" << command << "'" << std::endl;
+                return 1;
+            }
+            const std::string saved = readFile(outputFile);
+            if (i == 0) {
+                cliResult = saved;
+            }
+        }
+        const auto cliEnd = std::chrono::high_resolution_clock::now();
+        std::filesystem::remove(inputFile);
+        std::filesystem::remove(outputFile);
+
+        // NOTE The CLI writes std::endl, which are "\r\n" on Windows
+        cliResult.erase(std::remove(cliResult.begin(), cliResult.end(), '\r'), cliResult.end());
+        if (cliResult != inProcessResult) {
+            std::cerr << "Warning: CLI and in-process results differ" << std::endl;
+        }
+
+        const double inProcessMs = std::chrono::duration<double, std::milli>(inProcessEnd - inProcessStart).count() / requests;
+        const double cliMs = std::chrono::duration<double, std::milli>(cliEnd - cliStart).count() / requests;
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Board " << size << "x" << size << ", " << generations << " generations, " << requests << " requests" << std::endl
+                  << std::left << std::setw(12) << "in-process" << inProcessMs << " ms/request" << std::endl
+                  << std::left << std::setw(12) << "cli" << cliMs << " ms/request" << std::endl
+                  << std::left << std::setw(12) << "speedup" << (inProcessMs > 0.0 ? cliMs / inProcessMs : 0.0) << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
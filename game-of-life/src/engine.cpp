@@ -0,0 +1,76 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+
+#include "engine.hpp"
+#include "multiprocess.hpp"
+
+std::string engineToString(Engine engine)
+{
+    switch (engine)
+    {
+    case Engine::SEQUENTIAL:
+        return "seq";
+    case Engine::PARALLEL:
+        return "omp";
+    case Engine::MULTI_PROCESS:
+        return "mp";
+    default:
+        return "unknown";
+    }
+}
+
+bool engineFromString(const std::string& mode, Engine& engine)
+{
+    // NOTE Only the prefix is checked, so e.g. 'sequential' and 'parallel' are accepted as well
+    if (mode.rfind("seq", 0) == 0)
+    {
+        engine = Engine::SEQUENTIAL;
+        return true;
+    }
+    if (mode.rfind("par", 0) == 0 || mode.rfind("omp", 0) == 0)
+    {
+        engine = Engine::PARALLEL;
+        return true;
+    }
+    if (mode.rfind("mp", 0) == 0 || mode.rfind("multi", 0) == 0)
+    {
+        engine = Engine::MULTI_PROCESS;
+        return true;
+    }
+    return false;
+}
+
+bool engineIsParallel(Engine engine)
+{
+    return engine != Engine::SEQUENTIAL;
+}
+
+const std::vector<Engine>& allEngines()
+{
+    static const std::vector<Engine> engines = multiProcessSupported()
+        ? std::vector<Engine>{Engine::SEQUENTIAL, Engine::PARALLEL, Engine::MULTI_PROCESS}
+        : std::vector<Engine>{Engine::SEQUENTIAL, Engine::PARALLEL};
+    return engines;
+}
+
+void runEngine(GameOfLife& game, Engine engine, int generations)
+{
+    switch (engine)
+    {
+    case Engine::SEQUENTIAL:
+        for (int i = 0; i < generations; ++i) {
+            game.next();
+        }
+        break;
+    case Engine::PARALLEL:
+        for (int i = 0; i < generations; ++i) {
+            game.nextP();
+        }
+        break;
+    case Engine::MULTI_PROCESS:
+        // NOTE The thread count of the game is used as number of worker processes
+        runMultiProcess(game, generations, MultiProcessConfig{game.getThreads(), false});
+        break;
+    }
+}
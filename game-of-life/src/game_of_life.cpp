@@ -5,35 +5,33 @@
 
 #include "game_of_life.hpp"
 #include <omp.h>
+#include <algorithm>
+#include <charconv>
 #include <cstring>
 #include <fstream>
+#include <memory>
 #include <stdexcept>
 #include <iostream>
 
 // PUBLIC
 
-class MaxThreadExceededException : public std::exception
+// Counter-based random number generator (SplitMix64 finalizer)
+// NOTE The n-th number only depends on (key, n), so every thread can generate any cell independently
+static inline uint64_t mix64(uint64_t z)
 {
-    virtual const char* what() const throw()
-    {
-        return "Number of threads exceeds the maximum number of threads available";
-    }
-};
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t counterRandom(uint64_t key, uint64_t counter)
+{
+    return mix64(key + counter * 0x9E3779B97F4A7C15ULL);
+}
 
 GameOfLife::GameOfLife(unsigned int rows, unsigned int columns, bool parallel, unsigned int threads)
-    : rows(rows),columns(columns),parallel(parallel)
+    : LifeAutomaton(rows, columns, parallel, threads)
 {
-    gridSize = rows * columns;
-    grid = new unsigned char[gridSize];
-    prevGrid = new unsigned char[gridSize];
-    memset(grid, 0, gridSize);
-    memset(prevGrid, 0, gridSize);
-    if(threads > omp_get_max_threads())
-    {
-        throw MaxThreadExceededException();
-    }
-    this->threads = threads;
-    omp_set_num_threads(this->threads);
 }
 
 GameOfLife::GameOfLife(unsigned int rows, unsigned int columns, bool parallel, unsigned int threads, const std::vector<std::vector<char>>& seed)
@@ -41,80 +39,23 @@ GameOfLife::GameOfLife(unsigned int rows, unsigned int columns, bool parallel, u
     initialize_from_seed(seed);
 }
 
-GameOfLife::~GameOfLife()
-{
-    delete[] grid;
-    delete[] prevGrid;
-}
-
 void GameOfLife::setCell(unsigned int row, unsigned int col)
 {
-    const int w = static_cast<int>(columns); // Width
-    const int h = static_cast<int>(rows);   // Height
-    const unsigned int gridSize = rows * columns;
-
-    // Offsets to calculate the eight neighboring cells (accounting for wrap-around)
-    const int cellOffsetLeft = (col == 0) ? w - 1 : -1;
-    const int cellOffsetRight = (col == w - 1) ? -(w - 1) : 1;
-    const int cellOffsetUp = (row == 0) ? static_cast<int>(gridSize - w) : -w;
-    const int cellOffsetDown = (row == h - 1) ? -static_cast<int>(gridSize - w) : w;
-
-    unsigned char *cellPtr = grid + (row * w) + col;
-
     // Activate cell
-    CELL_ACTIVATE(*cellPtr);
+    CELL_ACTIVATE(grid[static_cast<size_t>(row) * columns + col]);
 
-    /* NOTE The eight neighboring cells are:
-     * AL A AR
-     * L  x  R
-     * BL B BR
-     * A ... Above
-     * B ... Below
-     * L ... Left
-     * R ... Right
-     */
     /* NOTE we do not need to increment the alive counter of this cell
      * since starting from the first living cell
      * each subsequent cell will increment the counters of all its neighbors
      */
-
-    // Change the live counter of neighbor cells
-    *(cellPtr + cellOffsetLeft) += CELL_COUNTER_INCREMENT; // L
-    *(cellPtr + cellOffsetRight) += CELL_COUNTER_INCREMENT; // R
-    *(cellPtr + cellOffsetUp) += CELL_COUNTER_INCREMENT; // A
-    *(cellPtr + cellOffsetDown) += CELL_COUNTER_INCREMENT; // B
-    *(cellPtr + cellOffsetUp + cellOffsetLeft) += CELL_COUNTER_INCREMENT; // AL
-    *(cellPtr + cellOffsetUp + cellOffsetRight) += CELL_COUNTER_INCREMENT; // AR
-    *(cellPtr + cellOffsetDown + cellOffsetLeft) += CELL_COUNTER_INCREMENT; // BL
-    *(cellPtr + cellOffsetDown + cellOffsetRight) += CELL_COUNTER_INCREMENT; // BR
+    addToNeighbors(row, col, CELL_COUNTER_INCREMENT);
 }
 
 void GameOfLife::clearCell(unsigned int row, unsigned int col)
 {
-    const int w = static_cast<int>(columns); // Width
-    const int h = static_cast<int>(rows);   // Height
-    const unsigned int gridSize = rows * columns;
-
-    // Offsets to calculate the eight neighboring cells (accounting for wrap-around)
-    const int cellOffsetLeft = (col == 0) ? w - 1 : -1;
-    const int cellOffsetRight = (col == w - 1) ? -(w - 1) : 1;
-    const int cellOffsetUp = (row == 0) ? static_cast<int>(gridSize - w) : -w;
-    const int cellOffsetDown = (row == h - 1) ? -static_cast<int>(gridSize - w) : w;
-
-    unsigned char *cellPtr = grid + (row * w) + col;
-
     // Deactivate cell
-    CELL_DEACTIVATE(*cellPtr);
-
-    // Change the live counter of neighbor cells
-    *(cellPtr + cellOffsetLeft) -= CELL_COUNTER_INCREMENT; // L
-    *(cellPtr + cellOffsetRight) -= CELL_COUNTER_INCREMENT; // R
-    *(cellPtr + cellOffsetUp) -= CELL_COUNTER_INCREMENT; // A
-    *(cellPtr + cellOffsetDown) -= CELL_COUNTER_INCREMENT; // B
-    *(cellPtr + cellOffsetUp + cellOffsetLeft) -= CELL_COUNTER_INCREMENT; // AL
-    *(cellPtr + cellOffsetUp + cellOffsetRight) -= CELL_COUNTER_INCREMENT; // AR
-    *(cellPtr + cellOffsetDown + cellOffsetLeft) -= CELL_COUNTER_INCREMENT; // BL
-    *(cellPtr + cellOffsetDown + cellOffsetRight) -= CELL_COUNTER_INCREMENT; // BR
+    CELL_DEACTIVATE(grid[static_cast<size_t>(row) * columns + col]);
+    addToNeighbors(row, col, static_cast<unsigned char>(-CELL_COUNTER_INCREMENT));
 }
 
 char GameOfLife::cellState(unsigned int row, unsigned int col) const
@@ -122,6 +63,11 @@ char GameOfLife::cellState(unsigned int row, unsigned int col) const
     return CELL_IS_ALIVE(grid[row * columns + col]) ? LIVE_CELL : DEAD_CELL;
 }
 
+unsigned long long GameOfLife::population() const
+{
+    return count(1);
+}
+
 std::vector<std::vector<char>> GameOfLife::getGrid() const
 {
     std::vector<std::vector<char>> gridVector(rows, std::vector<char>(columns));
@@ -133,174 +79,6 @@ std::vector<std::vector<char>> GameOfLife::getGrid() const
     return gridVector;
 }
 
-void GameOfLife::next()
-{
-    // Make copy of the current grid (unaltered)
-    memcpy(prevGrid, grid, gridSize);
-
-    // Process all cells in this grid
-    unsigned char *cellPtr = prevGrid;
-    for(unsigned int row = 0; row < rows; ++row)
-    {
-        unsigned int col = 0;
-        do
-        {
-            // Skip dead cells with no living neighbors
-            while(*cellPtr == CELL_DEAD_NO_NEIGHBORS)
-            {
-                ++cellPtr; // Move to the next cell
-                if(++col >= columns) // Check if we reached the end of the row
-                {
-                    goto RowDone;
-                }
-            }
-
-            // Cell is active or has neighbors
-            const unsigned int count = CELL_GET_COUNT(*cellPtr);
-            if(CELL_IS_ALIVE(*cellPtr))
-            {
-                // Rule: Any cell with fewer than 2 or more than 3 neighbors dies
-                if(count < RULE_STAY_ALIVE_MIN || count > RULE_STAY_ALIVE_MAX)
-                {
-                    clearCell(row, col);
-                }
-            }
-            else
-            {
-                // Rule: Any dead cell with exactly 3 neighbors becomes alive
-                if(count == RULE_BECOME_ALIVE_NEIGHBORS)
-                {
-                    setCell(row, col);
-                }
-            }
-            ++cellPtr; // Move to the next cell
-        } while(++col < columns);
-    RowDone:;
-    }
-}
-
-void GameOfLife::nextP()
-{
-    std::memcpy(prevGrid, grid, gridSize);
-
-    // Calculate the number of threads based on the board size
-    int max_possible_threads = rows / 3; // Minimum rows per thread (1 data row + 2 ghost rows)
-    int num_threads = std::min(omp_get_max_threads(), max_possible_threads);
-
-    // ghostRowCount is the amount of leftover rows that are not assigned to any thread
-    // Additionally, we calculate the number of rows each thread will handle
-    // Lastly, we calculate the leftover rows that are not divisible by the number of threads (i.e. remainder)
-    int ghostRowCount = num_threads + num_threads;
-    int numOfRowsForEachThread = (rows - ghostRowCount) / num_threads;
-    unsigned int leftover = (rows - ghostRowCount) % num_threads;
-
-    // Dynamically create a vector of the row numbers, which will be handled after the parallel region
-    std::vector<unsigned int> ghostAndLastRowArray;
-    ghostAndLastRowArray.reserve(ghostRowCount + leftover);
-
-    // Dividable by two because of num_threads + num_threads (above)
-    for (unsigned int i = 0; i < ghostRowCount / 2; ++i) {
-        ghostAndLastRowArray.push_back(numOfRowsForEachThread * (i + 1) + (i * 2)); // NOTE We choose to have 2 ghost rows
-        ghostAndLastRowArray.push_back(numOfRowsForEachThread * (i + 1) + (i * 2) + 1); // Second ghost row from above
-    }
-
-    // Add the leftover rows
-    for (unsigned int row = rows - leftover; row < rows; ++row) {
-        ghostAndLastRowArray.push_back(row);
-    }
-
-    #pragma omp parallel num_threads(num_threads)
-    {
-        // This is a private section for each thread
-        int thread_id = omp_get_thread_num();
-
-        // Calculate chunk for this thread
-        unsigned int start = thread_id * numOfRowsForEachThread + (thread_id * 2);
-        unsigned int end   = start + numOfRowsForEachThread; // +2 ghost rows and then the next thread starts
-
-        // Pointer to data
-        unsigned char* cellPtr = prevGrid + (start * columns);
-
-        // Perform next operation (same as sequential, only with a chunk of rows)
-        for (unsigned int row = start; row < end; ++row) {
-            for (unsigned int col = 0; col < columns; ++col) {
-                if (*cellPtr == CELL_DEAD_NO_NEIGHBORS) {
-                    ++cellPtr;
-                    continue;
-                }
-
-                // Cell is active or has neighbors
-                const unsigned int count = CELL_GET_COUNT(*cellPtr);
-                if(CELL_IS_ALIVE(*cellPtr))
-                {
-                    // Rule: Any cell with fewer than 2 or more than 3 neighbors dies
-                    if(count < RULE_STAY_ALIVE_MIN || count > RULE_STAY_ALIVE_MAX)
-                    {
-                        clearCell(row, col);
-                    }
-                }
-                else
-                {
-                    // Rule: Any dead cell with exactly 3 neighbors becomes alive
-                    if(count == RULE_BECOME_ALIVE_NEIGHBORS)
-                    {
-                        setCell(row, col);
-                    }
-                }
-                ++cellPtr;
-            }
-        }
-    } // end parallel region
-
-    // Perform next() operation on all unhandled rows
-    for (unsigned int row : ghostAndLastRowArray) {
-        unsigned char* cellPtr = prevGrid + (row * columns);
-        for (unsigned int col = 0; col < columns; ++col) {
-            if (*cellPtr == CELL_DEAD_NO_NEIGHBORS) {
-                ++cellPtr;
-                continue;
-            }
-
-            // Cell is active or has neighbors
-            const unsigned int count = CELL_GET_COUNT(*cellPtr);
-            if(CELL_IS_ALIVE(*cellPtr))
-            {
-                // Rule: Any cell with fewer than 2 or more than 3 neighbors dies
-                if(count < RULE_STAY_ALIVE_MIN || count > RULE_STAY_ALIVE_MAX)
-                {
-                    clearCell(row, col);
-                }
-            }
-            else
-            {
-                // Rule: Any dead cell with exactly 3 neighbors becomes alive
-                if(count == RULE_BECOME_ALIVE_NEIGHBORS)
-                {
-                    setCell(row, col);
-                }
-            }
-            ++cellPtr;
-        }
-    }
-}
-
-
-
-void GameOfLife::update(int generations) {
-    if(parallel)
-    {
-        for (int i = 0; i < generations; ++i) {
-            nextP();
-        }
-    }
-    else
-    {
-        for (int i = 0; i < generations; ++i) {
-            next();
-        }
-    }
-}
-
 GameOfLife* GameOfLife::fromFile(const std::string& filename, bool parallel, unsigned int threads) {
     std::ifstream inputFile(filename);
     if (!inputFile.is_open()) {
@@ -348,6 +126,33 @@ GameOfLife* GameOfLife::fromFile(const std::string& filename, bool parallel, uns
     return game;
 }
 
+GameOfLife* GameOfLife::fromRandom(unsigned int rows, unsigned int columns, double density, uint64_t seed, bool parallel, unsigned int threads) {
+    if (rows == 0 || columns == 0) {
+        throw std::runtime_error("Invalid dimensions.");
+    }
+    if (density < 0.0 || density > 1.0) {
+        throw std::runtime_error("Invalid density (expected value between 0.0 and 1.0).");
+    }
+    const auto game = new GameOfLife(rows, columns, parallel, threads);
+
+    // A cell is alive if its random number falls below density * 2^64
+    const uint64_t key = mix64(seed);
+    const bool allAlive = density >= 1.0;
+    const uint64_t threshold = allAlive ? UINT64_MAX : static_cast<uint64_t>(density * 18446744073709551616.0);
+
+    // NOTE Generation is setup work, so it always uses all cores (independent of the configured thread count)
+    unsigned char *cells = game->grid;
+    #pragma omp parallel for num_threads(omp_get_num_procs()) schedule(static)
+    for (long long row = 0; row < static_cast<long long>(rows); ++row) {
+        const uint64_t rowStart = static_cast<uint64_t>(row) * columns;
+        for (unsigned int col = 0; col < columns; ++col) {
+            cells[rowStart + col] = (allAlive || counterRandom(key, rowStart + col) < threshold) ? 1 : 0;
+        }
+    }
+    game->initialize_neighbor_counts();
+    return game;
+}
+
 void GameOfLife::toFile(const std::string& filename) const {
     std::ofstream outputFile(filename);
     if (!outputFile.is_open()) {
@@ -364,6 +169,66 @@ void GameOfLife::toFile(const std::string& filename) const {
     outputFile.close();
 }
 
+GameOfLife* GameOfLife::fromBuffer(const char* data, size_t size, bool parallel, unsigned int threads) {
+    // NOTE Same format as fromFile, parsed in place (no copy of the caller's buffer)
+    const char* const end = data + size;
+    const char* lineEnd = std::find(data, end, '\n');
+    const char* commaPos = std::find(data, lineEnd, ',');
+    if (commaPos == lineEnd) {
+        throw std::runtime_error("Invalid format: Missing dimensions.");
+    }
+
+    int rows = 0, columns = 0;
+    if (std::from_chars(data, commaPos, columns).ec != std::errc() || std::from_chars(commaPos + 1, lineEnd, rows).ec != std::errc()) {
+        throw std::runtime_error("Invalid dimensions format.");
+    }
+    if (rows <= 0 || columns <= 0) {
+        throw std::runtime_error("Invalid dimensions.");
+    }
+    std::unique_ptr<GameOfLife> game(new GameOfLife(rows, columns, parallel, threads));
+
+    unsigned char *cells = game->grid;
+    const char* line = (lineEnd == end) ? end : lineEnd + 1;
+    for (int i = 0; i < rows; ++i) {
+        lineEnd = std::find(line, end, '\n');
+        size_t length = lineEnd - line;
+        if (length > 0 && line[length - 1] == '\r') {
+            --length;
+        }
+        if (length != static_cast<size_t>(columns)) {
+            throw std::runtime_error("[Row " + std::to_string(i) + "] Size of row (" + std::to_string(length) + ") does not match expected columns (" + std::to_string(columns) + ").");
+        }
+        unsigned char *rowCells = cells + static_cast<size_t>(i) * columns;
+        for (int j = 0; j < columns; ++j) {
+            rowCells[j] = (line[j] == LIVE_CELL) ? 1 : 0;
+        }
+        line = (lineEnd == end) ? end : lineEnd + 1;
+    }
+    game->initialize_neighbor_counts();
+    return game.release();
+}
+
+size_t GameOfLife::toBuffer(char* data, size_t size) const {
+    const std::string dimensions = std::to_string(columns) + "," + std::to_string(rows) + "\n";
+    const size_t required = dimensions.size() + static_cast<size_t>(rows) * (columns + 1);
+    if (data == nullptr || size < required) {
+        return required;
+    }
+
+    std::memcpy(data, dimensions.data(), dimensions.size());
+    char *rowsStart = data + dimensions.size();
+    #pragma omp parallel for num_threads(omp_get_num_procs()) schedule(static)
+    for (long long row = 0; row < static_cast<long long>(rows); ++row) {
+        const unsigned char *rowCells = grid + static_cast<size_t>(row) * columns;
+        char *out = rowsStart + static_cast<size_t>(row) * (columns + 1);
+        for (unsigned int col = 0; col < columns; ++col) {
+            out[col] = CELL_IS_ALIVE(rowCells[col]) ? LIVE_CELL : DEAD_CELL;
+        }
+        out[columns] = '\n';
+    }
+    return required;
+}
+
 // PRIVATE
 
 void GameOfLife::initialize_from_seed(const std::vector<std::vector<char>>& seed)
@@ -377,4 +242,4 @@ void GameOfLife::initialize_from_seed(const std::vector<std::vector<char>>& seed
             // NOTE Cells are initialized as dead by default
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,169 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+
+#include "gol_c_api.h"
+#include "game_of_life.hpp"
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+struct gol_game {
+    std::unique_ptr<GameOfLife> game;
+};
+
+static thread_local std::string lastError;
+
+static gol_status fail(gol_status status, const std::string& message)
+{
+    lastError = message;
+    return status;
+}
+
+// NOTE Exceptions must never cross the C boundary, so every entry point translates them into a status
+template<typename Function>
+static gol_status guarded(Function&& function)
+{
+    try {
+        lastError.clear();
+        return function();
+    } catch (const MaxThreadExceededException& e) {
+        return fail(GOL_ERROR_THREADS, e.what());
+    } catch (const std::bad_alloc&) {
+        return fail(GOL_ERROR_OUT_OF_MEMORY, "Out of memory.");
+    } catch (const std::runtime_error& e) {
+        // NOTE GameOfLife reports malformed boards as runtime_error
+        return fail(GOL_ERROR_INVALID_FORMAT, e.what());
+    } catch (const std::exception& e) {
+        return fail(GOL_ERROR_INTERNAL, e.what());
+    } catch (...) {
+        return fail(GOL_ERROR_INTERNAL, "Unknown error.");
+    }
+}
+
+static size_t cellCount(const GameOfLife& game)
+{
+    return static_cast<size_t>(game.getRows()) * game.getColumns();
+}
+
+extern "C" {
+
+int gol_api_version(void)
+{
+    return GOL_API_VERSION;
+}
+
+const char* gol_last_error(void)
+{
+    return lastError.c_str();
+}
+
+gol_status gol_create(unsigned int rows, unsigned int columns, unsigned int threads, gol_game** game)
+{
+    return guarded([&] {
+        if (game == nullptr || rows == 0 || columns == 0 || threads == 0) {
+            return fail(GOL_ERROR_INVALID_ARGUMENT, "Invalid dimensions, thread count or handle.");
+        }
+        *game = new gol_game{std::make_unique<GameOfLife>(rows, columns, threads > 1, threads)};
+        return GOL_OK;
+    });
+}
+
+gol_status gol_load(const char* text, size_t size, unsigned int threads, gol_game** game)
+{
+    return guarded([&] {
+        if (game == nullptr || (text == nullptr && size > 0) || threads == 0) {
+            return fail(GOL_ERROR_INVALID_ARGUMENT, "Invalid buffer, thread count or handle.");
+        }
+        *game = new gol_game{std::unique_ptr<GameOfLife>(GameOfLife::fromBuffer(text, size, threads > 1, threads))};
+        return GOL_OK;
+    });
+}
+
+void gol_destroy(gol_game* game)
+{
+    delete game;
+}
+
+gol_status gol_set_cells(gol_game* game, const unsigned char* cells, size_t size)
+{
+    return guarded([&] {
+        if (game == nullptr || cells == nullptr || size != cellCount(*game->game)) {
+            return fail(GOL_ERROR_INVALID_ARGUMENT, "Buffer must hold rows * columns cells.");
+        }
+        game->game->loadStates(cells);
+        return GOL_OK;
+    });
+}
+
+gol_status gol_get_cells(const gol_game* game, unsigned char* cells, size_t size)
+{
+    return guarded([&] {
+        if (game == nullptr || cells == nullptr) {
+            return fail(GOL_ERROR_INVALID_ARGUMENT, "Invalid buffer or handle.");
+        }
+        if (size < cellCount(*game->game)) {
+            return fail(GOL_ERROR_BUFFER_TOO_SMALL, "Buffer must hold rows * columns cells.");
+        }
+        game->game->storeStates(cells);
+        return GOL_OK;
+    });
+}
+
+gol_status gol_step(gol_game* game, unsigned int generations)
+{
+    return guarded([&] {
+        if (game == nullptr) {
+            return fail(GOL_ERROR_INVALID_ARGUMENT, "Invalid handle.");
+        }
+        // NOTE update() takes an int, so very large requests are split
+        while (generations > 0) {
+            const int chunk = static_cast<int>(std::min(generations, 1u << 30));
+            game->game->update(chunk);
+            generations -= chunk;
+        }
+        return GOL_OK;
+    });
+}
+
+unsigned int gol_rows(const gol_game* game)
+{
+    return game ? game->game->getRows() : 0;
+}
+
+unsigned int gol_columns(const gol_game* game)
+{
+    return game ? game->game->getColumns() : 0;
+}
+
+unsigned long long gol_population(const gol_game* game)
+{
+    return game ? game->game->population() : 0;
+}
+
+int gol_cell(const gol_game* game, unsigned int row, unsigned int col)
+{
+    if (game == nullptr || row >= game->game->getRows() || col >= game->game->getColumns()) {
+        return -1;
+    }
+    return game->game->getState(row, col);
+}
+
+gol_status gol_export(const gol_game* game, char* text, size_t size, size_t* written)
+{
+    return guarded([&] {
+        if (game == nullptr || written == nullptr) {
+            return fail(GOL_ERROR_INVALID_ARGUMENT, "Invalid handle or size output.");
+        }
+        const size_t required = game->game->toBuffer(text, size);
+        *written = required;
+        if (text == nullptr || size < required) {
+            return fail(GOL_ERROR_BUFFER_TOO_SMALL, "Buffer requires " + std::to_string(required) + " bytes.");
+        }
+        return GOL_OK;
+    });
+}
+
+} // extern "C"
@@ -7,12 +7,37 @@
 #include <fstream>
 #include <string>
 #include "game_of_life.hpp"
+#include "engine.hpp"
+#include "autotuner.hpp"
+#include "multiprocess.hpp"
+#include "sweep.hpp"
 #include "Timing.h"
 
 #ifdef GUI
 #include "gui.hpp"
 #endif
 
+// Parse board dimensions in the form WIDTHxHEIGHT (e.g. 1000x250)
+static bool parseDimensions(const std::string& text, unsigned int& columns, unsigned int& rows)
+{
+    const size_t separator = text.find_first_of("xX");
+    if (separator == std::string::npos) {
+        return false;
+    }
+    try {
+        const int width = std::stoi(text.substr(0, separator));
+        const int height = std::stoi(text.substr(separator + 1));
+        if (width <= 0 || height <= 0) {
+            return false;
+        }
+        columns = width;
+        rows = height;
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
 int main(int argc, char* argv[]) {
     // Initialize cxxopts
     std::unique_ptr<cxxopts::Options> options(new cxxopts::Options(argv[0], " - Simulate Conway's Game of Life"));
@@ -22,13 +47,23 @@ int main(int argc, char* argv[]) {
     {
         opts.add_options()
             ("l,load", "Filename to read input board", cxxopts::value<std::string>())
+            ("generate", "Generate a random input board instead of loading one (arg==WIDTHxHEIGHT)", cxxopts::value<std::string>())
+            ("density", "Probability of a cell being alive in generated boards", cxxopts::value<double>()->default_value("0.5"))
+            ("seed", "Seed for generated boards (same seed == same board)", cxxopts::value<uint64_t>()->default_value("0"))
             ("s,save", "Filename to save output board", cxxopts::value<std::string>()->default_value("output.gol"))
             ("g,generations", "Number of generations to simulate", cxxopts::value<int>()->default_value("100"))
             ("m,measure", "Print time measurements", cxxopts::value<bool>()->default_value("false"))
             ("p,pretty", "Pretty print the measurement results", cxxopts::value<bool>()->default_value("false"))
             ("csv", "Write time measurements to a CSV file", cxxopts::value<bool>()->default_value("false"))
-            ("mode", "Configure execution mode ('seq'=='sequential', 'par'|'omp'=='parallel')", cxxopts::value<std::string>()->default_value("seq"))
-            ("threads", "Number of threads to use in parallel mode", cxxopts::value<int>()->default_value("4"))
+            ("mode", "Configure execution mode ('seq'=='sequential', 'par'|'omp'=='parallel', 'mp'==worker processes (Linux), 'auto'==fastest engine for the board)", cxxopts::value<std::string>()->default_value("seq"))
+            ("threads", "Number of threads to use in parallel mode (upper limit in auto mode, worker processes in mp mode)", cxxopts::value<int>()->default_value("4"))
+            ("pin", "Pin the worker processes of mp mode to separate CPUs", cxxopts::value<bool>()->default_value("false"))
+            ("profile", "Profile file caching the engine choices of auto mode", cxxopts::value<std::string>()->default_value("game_of_life_autotune.profile"))
+            ("tune-generations", "Number of generations benchmarked per engine in auto mode", cxxopts::value<int>()->default_value("4"))
+            ("sweep", "Run all engines across sizes and thread counts on generated boards and write a scaling report", cxxopts::value<bool>()->default_value("false"))
+            ("sweep-sizes", "Board sizes (square) used by --sweep", cxxopts::value<std::vector<int>>()->default_value("250,500,1000,2000,4000"))
+            ("sweep-threads", "Thread counts used by --sweep for parallel engines", cxxopts::value<std::vector<int>>()->default_value("1,2,4,8"))
+            ("report", "Filename of the --sweep scaling report", cxxopts::value<std::string>()->default_value("scaling_report.csv"))
 #ifdef GUI
             ("gui", "Enable graphical user interface (arg==cell size)", cxxopts::value<int>()->default_value("25"))
 #endif
@@ -57,14 +92,39 @@ int main(int argc, char* argv[]) {
             return 0;
         }
 
-        // Validate input file
-        if (!result.count("load")) {
-            std::cerr << "Error: Input file (--load) is required." << std::endl;
+        // Scaling sweep on generated boards (no input file required)
+        if (result["sweep"].as<bool>()) {
+            SweepConfig config;
+            config.sizes = result["sweep-sizes"].as<std::vector<int>>();
+            config.threads = result["sweep-threads"].as<std::vector<int>>();
+            config.generations = result["generations"].as<int>();
+            config.density = result["density"].as<double>();
+            config.seed = result["seed"].as<uint64_t>();
+            config.reportFile = result["report"].as<std::string>();
+            return runSweep(config);
+        }
+
+        // Validate input board
+        const bool generate = result.count("generate") > 0;
+        if (!result.count("load") && !generate) {
+            std::cerr << "Error: Input file (--load) or generated board (--generate) is required." << std::endl;
             return 1;
         }
+        if (result.count("load") && generate) {
+            std::cerr << "Error: Options --load and --generate are mutually exclusive." << std::endl;
+            return 1;
+        }
+        unsigned int generateColumns = 0;
+        unsigned int generateRows = 0;
+        if (generate && !parseDimensions(result["generate"].as<std::string>(), generateColumns, generateRows)) {
+            std::cerr << "Error: Invalid board dimensions for --generate. Use WIDTHxHEIGHT (e.g. 1000x250)." << std::endl;
+            return 1;
+        }
+        const double density = result["density"].as<double>();
+        const uint64_t seed = result["seed"].as<uint64_t>();
 
         // Parse arguments
-        std::string inputFile = result["load"].as<std::string>();
+        std::string inputFile = generate ? "" : result["load"].as<std::string>();
         std::string outputFile = result["save"].as<std::string>();
         int generations = result["generations"].as<int>();
         bool measure = result["measure"].as<bool>();
@@ -77,7 +137,8 @@ int main(int argc, char* argv[]) {
         int cell_size = result["gui"].as<int>();
         if(result.count("gui"))
         {
-            return runGui(*GameOfLife::fromFile(inputFile), cell_size);
+            return runGui(generate ? *GameOfLife::fromRandom(generateRows, generateColumns, density, seed)
+                                   : *GameOfLife::fromFile(inputFile), cell_size);
         }
 #endif
 
@@ -88,19 +149,26 @@ int main(int argc, char* argv[]) {
             timing->startSetup();
         }
 
-        if(mode.rfind("seq",0) == 0)
+        Engine engine = Engine::SEQUENTIAL;
+        const bool autoMode = mode == "auto";
+        if(!autoMode && !engineFromString(mode, engine))
         {
-            game = GameOfLife::fromFile(inputFile, parallel);
+            std::cerr << "Error: Invalid mode. Use 'seq' for sequential mode, 'par' for parallel mode, 'mp' for multi-process mode or 'auto' to select the fastest engine." << std::endl;
+            return 1;
         }
-        else if(mode.rfind("par",0) == 0 || mode.rfind("omp",0) == 0) // Check if mode starts with 'par' or 'omp'
+        parallel = autoMode || engineIsParallel(engine);
+        if(!parallel)
         {
-            parallel = true;
-            game = GameOfLife::fromFile(inputFile, parallel, threads);
+            threads = 1;
+        }
+
+        if(generate)
+        {
+            game = GameOfLife::fromRandom(generateRows, generateColumns, density, seed, parallel, threads);
         }
         else
         {
-            std::cerr << "Error: Invalid mode. Use 'seq' for sequential mode or 'par' for parallel mode." << std::endl;
-            return 1;
+            game = GameOfLife::fromFile(inputFile, parallel, threads);
         }
 
         if (measure) {
@@ -108,8 +176,23 @@ int main(int argc, char* argv[]) {
             timing->startComputation();
         }
 
-        // Run generations
-        game->update(generations);
+        // Run generations (auto mode already advances the board while benchmarking the engines)
+        int remainingGenerations = generations;
+        if(autoMode)
+        {
+            AutoTuner tuner(result["profile"].as<std::string>(), result["tune-generations"].as<int>());
+            const TuningChoice choice = tuner.tune(*game, threads, generations);
+            engine = choice.engine;
+            remainingGenerations -= choice.generationsDone;
+        }
+        if(engine == Engine::MULTI_PROCESS)
+        {
+            runMultiProcess(*game, remainingGenerations, MultiProcessConfig{static_cast<unsigned int>(threads), result["pin"].as<bool>()});
+        }
+        else
+        {
+            runEngine(*game, engine, remainingGenerations);
+        }
 
         if (measure) {
             timing->stopComputation();
@@ -0,0 +1,371 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+
+#include "multiprocess.hpp"
+#include <stdexcept>
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+static constexpr size_t CACHE_LINE = 64;
+static constexpr unsigned int HALO_TOP = 0; // First row of a slab (bottom halo of the worker above)
+static constexpr unsigned int HALO_BOTTOM = 1; // Last row of a slab (top halo of the worker below)
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Futex words have to be lock-free.");
+
+// NOTE One cache line per worker, so signalling does not cause false sharing between processes
+struct alignas(CACHE_LINE) WorkerControl {
+    std::atomic<uint32_t> published{0}; // Number of generations whose boundary rows are available
+};
+
+struct alignas(CACHE_LINE) SharedHeader {
+    std::atomic<uint32_t> aborted{0}; // Set if a worker failed, so nobody waits forever
+};
+
+static size_t alignToCacheLine(size_t size)
+{
+    return (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+}
+
+// NOTE Timeout, so waiting workers periodically check the abort flag
+static void futexWait(std::atomic<uint32_t>& word, uint32_t expected)
+{
+    const timespec timeout{0, 100 * 1000 * 1000};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+static void futexWakeAll(std::atomic<uint32_t>& word)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+/* Layout of the shared memory segment:
+ * header | control block per worker | halo rows [worker][top/bottom][generation parity] | board
+ * The board holds the plain cell states, it is filled by the parent and written back by the workers.
+ */
+class SharedRegion {
+public:
+    SharedRegion(unsigned int workers, unsigned int rows, unsigned int columns)
+        : workers(workers), haloStride(alignToCacheLine(columns))
+    {
+        const size_t controlsOffset = sizeof(SharedHeader);
+        const size_t halosOffset = controlsOffset + workers * sizeof(WorkerControl);
+        const size_t boardOffset = halosOffset + static_cast<size_t>(workers) * 4 * haloStride;
+        size = boardOffset + alignToCacheLine(static_cast<size_t>(rows) * columns);
+
+        // NOTE Unlinked right away, the mapping is inherited by the forked workers and vanishes with the last of them
+        static std::atomic<unsigned int> segments{0};
+        const std::string name = "/game_of_life_mp_" + std::to_string(getpid()) + "_" + std::to_string(segments++);
+        const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to create shared memory (" + std::string(std::strerror(errno)) + ").");
+        }
+        shm_unlink(name.c_str());
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            close(fd);
+            throw std::runtime_error("Failed to size shared memory (" + std::string(std::strerror(errno)) + ").");
+        }
+        void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED) {
+            throw std::runtime_error("Failed to map shared memory (" + std::string(std::strerror(errno)) + ").");
+        }
+
+        base = static_cast<unsigned char*>(memory);
+        header = new (base) SharedHeader();
+        controls = reinterpret_cast<WorkerControl*>(base + controlsOffset);
+        for (unsigned int worker = 0; worker < workers; ++worker) {
+            new (&controls[worker]) WorkerControl();
+        }
+        halos = base + halosOffset;
+        board = base + boardOffset;
+    }
+
+    ~SharedRegion()
+    {
+        munmap(base, size);
+    }
+
+    SharedRegion(const SharedRegion&) = delete;
+    SharedRegion& operator=(const SharedRegion&) = delete;
+
+    unsigned char* halo(unsigned int worker, unsigned int side, uint32_t generation)
+    {
+        return halos + ((static_cast<size_t>(worker) * 2 + side) * 2 + (generation & 1)) * haloStride;
+    }
+
+    void abort()
+    {
+        header->aborted.store(1, std::memory_order_release);
+        for (unsigned int worker = 0; worker < workers; ++worker) {
+            futexWakeAll(controls[worker].published);
+        }
+    }
+
+    SharedHeader* header;
+    WorkerControl* controls;
+    unsigned char* board;
+
+private:
+    unsigned int workers;
+    size_t haloStride;
+    size_t size;
+    unsigned char* base;
+    unsigned char* halos;
+};
+
+// Rows of a worker, framed by a halo row above (row 0) and below (last row)
+class Slab : public LifeAutomaton {
+public:
+    Slab(unsigned int slabRows, unsigned int columns) : LifeAutomaton(slabRows + 2, columns) {}
+
+    // Replace a halo row by the boundary row of a neighbor (only changed cells touch the counters)
+    void setHalo(unsigned int haloRow, const unsigned char* states)
+    {
+        const unsigned char *cellPtr = grid + static_cast<size_t>(haloRow) * columns;
+        for (unsigned int col = 0; col < columns; ++col) {
+            if ((cellPtr[col] & STATE_MASK) != states[col]) {
+                setState(haloRow, col, states[col]);
+            }
+        }
+    }
+
+    void storeRow(unsigned int row, unsigned char* states) const
+    {
+        const unsigned char *cellPtr = grid + static_cast<size_t>(row) * columns;
+        for (unsigned int col = 0; col < columns; ++col) {
+            states[col] = cellPtr[col] & STATE_MASK;
+        }
+    }
+
+    // Same as next(), split into phases so the boundary rows can be published before the interior is done
+    void beginGeneration() { std::memcpy(prevGrid, grid, gridSize); }
+    void computeRow(unsigned int row) { processRow(row); }
+};
+
+static bool waitForGeneration(SharedRegion& shared, unsigned int worker, uint32_t generation)
+{
+    std::atomic<uint32_t>& published = shared.controls[worker].published;
+    for (int spin = 0; ; ++spin) {
+        const uint32_t current = published.load(std::memory_order_acquire);
+        if (current >= generation) {
+            return true;
+        }
+        if (shared.header->aborted.load(std::memory_order_acquire)) {
+            return false;
+        }
+        // NOTE Spin briefly first, neighbors usually publish within the time of computing an interior
+        if (spin >= 256) {
+            futexWait(published, current);
+        }
+    }
+}
+
+static std::vector<int> allowedCpus()
+{
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    return cpus;
+}
+
+static void pinWorker(unsigned int worker, unsigned int workers, const std::vector<int>& cpus)
+{
+    if (cpus.empty()) {
+        return;
+    }
+    // Contiguous share of the allowed CPUs (on most machines the cores of one socket are numbered contiguously)
+    const size_t first = static_cast<size_t>(worker) * cpus.size() / workers;
+    const size_t last = std::max(first + 1, static_cast<size_t>(worker + 1) * cpus.size() / workers);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t i = first; i < last; ++i) {
+        CPU_SET(cpus[i % cpus.size()], &set);
+    }
+    sched_setaffinity(0, sizeof(set), &set);
+}
+
+// NOTE Runs in a forked child, so it must not use OpenMP (the thread pool of the parent does not exist here)
+static int runWorker(SharedRegion& shared, unsigned int worker, unsigned int workers, unsigned int rows, unsigned int columns,
+                     int generations, const std::vector<int>& cpus)
+{
+    pinWorker(worker, workers, cpus); // Before allocating, so the slab is placed in memory close to the CPUs
+
+    const unsigned int firstRow = static_cast<unsigned int>(static_cast<unsigned long long>(worker) * rows / workers);
+    const unsigned int endRow = static_cast<unsigned int>(static_cast<unsigned long long>(worker + 1) * rows / workers);
+    const unsigned int slabRows = endRow - firstRow;
+    const unsigned int above = (worker + workers - 1) % workers;
+    const unsigned int below = (worker + 1) % workers;
+
+    Slab slab(slabRows, columns);
+    for (unsigned int row = 0; row < slabRows; ++row) {
+        const unsigned char *states = shared.board + static_cast<size_t>(firstRow + row) * columns;
+        for (unsigned int col = 0; col < columns; ++col) {
+            if (states[col]) {
+                slab.setState(row + 1, col, 1);
+            }
+        }
+    }
+    slab.setHalo(0, shared.board + static_cast<size_t>((firstRow + rows - 1) % rows) * columns);
+    slab.setHalo(slabRows + 1, shared.board + static_cast<size_t>(endRow % rows) * columns);
+
+    for (uint32_t generation = 0; generation < static_cast<uint32_t>(generations); ++generation) {
+        if (generation > 0) {
+            if (!waitForGeneration(shared, above, generation)) {
+                return 1;
+            }
+            slab.setHalo(0, shared.halo(above, HALO_BOTTOM, generation));
+            if (!waitForGeneration(shared, below, generation)) {
+                return 1;
+            }
+            slab.setHalo(slabRows + 1, shared.halo(below, HALO_TOP, generation));
+        }
+
+        // Boundary rows first and publish them, the neighbors exchange halos while the interior is computed
+        slab.beginGeneration();
+        slab.computeRow(1);
+        if (slabRows > 1) {
+            slab.computeRow(slabRows);
+        }
+        // NOTE Double-buffered by parity: a neighbor can only be one generation behind, since it has
+        // to read these rows before it publishes the generation which is required for the next step here
+        slab.storeRow(1, shared.halo(worker, HALO_TOP, generation + 1));
+        slab.storeRow(slabRows, shared.halo(worker, HALO_BOTTOM, generation + 1));
+        shared.controls[worker].published.store(generation + 1, std::memory_order_release);
+        futexWakeAll(shared.controls[worker].published);
+
+        for (unsigned int row = 2; row < slabRows; ++row) {
+            slab.computeRow(row);
+        }
+    }
+
+    // The neighbors read their initial halos from the board, so wait until they are past that point
+    if (!waitForGeneration(shared, above, 1) || !waitForGeneration(shared, below, 1)) {
+        return 1;
+    }
+    for (unsigned int row = 0; row < slabRows; ++row) {
+        slab.storeRow(row + 1, shared.board + static_cast<size_t>(firstRow + row) * columns);
+    }
+    return 0;
+}
+
+bool multiProcessSupported()
+{
+    return true;
+}
+
+void runMultiProcess(GameOfLife& game, int generations, const MultiProcessConfig& config)
+{
+    if (generations <= 0) {
+        return;
+    }
+    if (config.workers == 0) {
+        throw std::runtime_error("Multi-process mode requires at least one worker.");
+    }
+    const unsigned int rows = game.getRows();
+    const unsigned int columns = game.getColumns();
+    const unsigned int workers = std::min(config.workers, rows); // Every worker needs at least one row
+
+    SharedRegion shared(workers, rows, columns);
+    game.storeStates(shared.board);
+    const std::vector<int> cpus = config.pin ? allowedCpus() : std::vector<int>();
+
+    // NOTE Flush buffered output, otherwise it might be duplicated by the children
+    std::cout.flush();
+    std::clog.flush();
+
+    std::vector<pid_t> pids;
+    bool failed = false;
+    for (unsigned int worker = 0; worker < workers; ++worker) {
+        const pid_t pid = fork();
+        if (pid < 0) {
+            failed = true;
+            shared.abort();
+            break;
+        }
+        if (pid == 0) {
+            int status = 1;
+            try {
+                status = runWorker(shared, worker, workers, rows, columns, generations, cpus);
+            } catch (...) {
+                status = 1;
+            }
+            if (status != 0) {
+                shared.abort();
+            }
+            _exit(status);
+        }
+        pids.push_back(pid);
+    }
+
+    // Reap the workers, if one of them fails (or crashes) the others are aborted instead of waiting forever
+    size_t remaining = pids.size();
+    while (remaining > 0) {
+        for (pid_t& pid : pids) {
+            if (pid <= 0) {
+                continue;
+            }
+            int status = 0;
+            const pid_t result = waitpid(pid, &status, WNOHANG);
+            if (result == 0) {
+                continue;
+            }
+            if (result < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                if (!failed) {
+                    failed = true;
+                    shared.abort();
+                }
+            }
+            pid = 0;
+            --remaining;
+        }
+        if (remaining > 0) {
+            usleep(200);
+        }
+    }
+
+    if (failed) {
+        throw std::runtime_error("Multi-process worker failed.");
+    }
+    game.loadStates(shared.board);
+}
+
+#else
+
+bool multiProcessSupported()
+{
+    return false;
+}
+
+void runMultiProcess(GameOfLife&, int, const MultiProcessConfig&)
+{
+    throw std::runtime_error("Multi-process mode is only supported on Linux.");
+}
+
+#endif
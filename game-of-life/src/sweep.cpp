@@ -0,0 +1,79 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+
+#include "sweep.hpp"
+#include "engine.hpp"
+#include "game_of_life.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+int runSweep(const SweepConfig& config)
+{
+    std::ofstream report(config.reportFile);
+    if (!report.is_open()) {
+        std::cerr << "Error: Failed to open report file " << config.reportFile << std::endl;
+        return 1;
+    }
+    report << "engine;columns;rows;threads;generations;setup_ms;computation_ms;cells_per_second;speedup;population" << std::endl;
+
+    std::cout << std::left << std::setw(8) << "engine" << std::setw(8) << "size" << std::setw(9) << "threads"
+              << std::setw(14) << "setup_ms" << std::setw(16) << "computation_ms" << std::setw(18) << "cells_per_second"
+              << "speedup" << std::endl;
+
+    for (const int size : config.sizes) {
+        if (size <= 0) {
+            std::cerr << "Skipping invalid board size " << size << std::endl;
+            continue;
+        }
+        // Speedup and population are compared against the sequential engine on the same board
+        double sequentialMs = 0.0;
+        unsigned long long sequentialPopulation = 0;
+
+        for (const Engine engine : allEngines()) {
+            const std::vector<int> threadCounts = engineIsParallel(engine) ? config.threads : std::vector<int>{1};
+            for (const int threads : threadCounts) {
+                std::unique_ptr<GameOfLife> game;
+                const auto setupStart = std::chrono::high_resolution_clock::now();
+                try {
+                    game.reset(GameOfLife::fromRandom(size, size, config.density, config.seed, engineIsParallel(engine), threads));
+                } catch (const std::exception& e) {
+                    std::cerr << "Skipping " << engineToString(engine) << " with " << threads << " threads: " << e.what() << std::endl;
+                    continue;
+                }
+                const auto setupEnd = std::chrono::high_resolution_clock::now();
+                runEngine(*game, engine, config.generations);
+                const auto computationEnd = std::chrono::high_resolution_clock::now();
+
+                const double setupMs = std::chrono::duration<double, std::milli>(setupEnd - setupStart).count();
+                const double computationMs = std::chrono::duration<double, std::milli>(computationEnd - setupEnd).count();
+                const double cellsPerSecond = computationMs > 0.0
+                    ? static_cast<double>(size) * size * config.generations / (computationMs / 1000.0)
+                    : 0.0;
+                const unsigned long long population = game->population();
+
+                if (engine == Engine::SEQUENTIAL) {
+                    sequentialMs = computationMs;
+                    sequentialPopulation = population;
+                } else if (population != sequentialPopulation) {
+                    std::cerr << "Warning: " << engineToString(engine) << " with " << threads << " threads ended with population "
+                              << population << " instead of " << sequentialPopulation << std::endl;
+                }
+                const double speedup = computationMs > 0.0 ? sequentialMs / computationMs : 0.0;
+
+                std::cout << std::left << std::setw(8) << engineToString(engine) << std::setw(8) << size << std::setw(9) << threads
+                          << std::setw(14) << setupMs << std::setw(16) << computationMs << std::setw(18) << cellsPerSecond
+                          << speedup << std::endl;
+                report << engineToString(engine) << ";" << size << ";" << size << ";" << threads << ";" << config.generations << ";"
+                       << setupMs << ";" << computationMs << ";" << cellsPerSecond << ";" << speedup << ";" << population << std::endl;
+            }
+        }
+    }
+
+    report.close();
+    std::cout << "Scaling report written to " << config.reportFile << std::endl;
+    return 0;
+}
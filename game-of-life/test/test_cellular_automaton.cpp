@@ -0,0 +1,133 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+#include "gtest/gtest.h"
+#include "automata.hpp"
+#include "game_of_life.hpp"
+#include <random>
+#include <vector>
+
+// Test-Suite 5: Generic Cellular Automaton Core
+
+// Straightforward (recount every neighborhood) reference implementation of one generation
+template<auto Transition>
+static std::vector<unsigned char> referenceNext(const std::vector<unsigned char>& states, unsigned int rows, unsigned int columns)
+{
+    std::vector<unsigned char> result(states.size());
+    for (unsigned int row = 0; row < rows; ++row) {
+        for (unsigned int col = 0; col < columns; ++col) {
+            unsigned int excited = 0;
+            for (int dr = -1; dr <= 1; ++dr) {
+                for (int dc = -1; dc <= 1; ++dc) {
+                    if (dr == 0 && dc == 0) {
+                        continue;
+                    }
+                    const unsigned int r = (row + rows + dr) % rows;
+                    const unsigned int c = (col + columns + dc) % columns;
+                    excited += states[r * columns + c] == 1;
+                }
+            }
+            result[row * columns + col] = Transition(states[row * columns + col], excited);
+        }
+    }
+    return result;
+}
+
+static std::vector<unsigned char> randomStates(unsigned int rows, unsigned int columns, unsigned int states, unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<unsigned int> distribution(0, states - 1);
+    std::vector<unsigned char> result(static_cast<size_t>(rows) * columns);
+    for (unsigned char& state : result) {
+        state = static_cast<unsigned char>(distribution(generator));
+    }
+    return result;
+}
+
+template<typename Automaton>
+static std::vector<unsigned char> statesOf(const Automaton& automaton)
+{
+    std::vector<unsigned char> states(static_cast<size_t>(automaton.getRows()) * automaton.getColumns());
+    automaton.storeStates(states.data());
+    return states;
+}
+
+template<typename Automaton, auto Transition>
+static void expectMatchesReference(unsigned int states, bool parallel)
+{
+    const unsigned int rows = 61;
+    const unsigned int columns = 47;
+    std::vector<unsigned char> expected = randomStates(rows, columns, states, 17);
+    Automaton automaton(rows, columns, parallel, parallel ? std::min(4u, maxAvailableThreads()) : 1);
+    automaton.loadStates(expected.data());
+    for (int generation = 0; generation < 30; ++generation) {
+        automaton.update(1);
+        expected = referenceNext<Transition>(expected, rows, columns);
+        ASSERT_EQ(statesOf(automaton), expected) << "Generation " << generation + 1;
+    }
+}
+
+TEST(CellularAutomatonTest, GameOfLifeMatchesReference) {
+    expectMatchesReference<LifeAutomaton, lifeTransition>(2, false);
+    expectMatchesReference<LifeAutomaton, lifeTransition>(2, true);
+}
+
+TEST(CellularAutomatonTest, BriansBrainMatchesReference) {
+    expectMatchesReference<BriansBrain, briansBrainTransition>(3, false);
+    expectMatchesReference<BriansBrain, briansBrainTransition>(3, true);
+}
+
+TEST(CellularAutomatonTest, WireworldMatchesReference) {
+    expectMatchesReference<Wireworld, wireworldTransition>(4, false);
+    expectMatchesReference<Wireworld, wireworldTransition>(4, true);
+}
+
+TEST(CellularAutomatonTest, WireworldElectronTravelsAlongWire) {
+    Wireworld wire(5, 10);
+    for (unsigned int col = 1; col < 9; ++col) {
+        wire.setState(2, col, WIREWORLD_CONDUCTOR);
+    }
+    wire.setState(2, 1, WIREWORLD_TAIL);
+    wire.setState(2, 2, WIREWORLD_HEAD);
+
+    wire.update(3);
+    EXPECT_EQ(wire.getState(2, 4), WIREWORLD_TAIL);
+    EXPECT_EQ(wire.getState(2, 5), WIREWORLD_HEAD);
+    EXPECT_EQ(wire.count(WIREWORLD_HEAD), 1u);
+    EXPECT_EQ(wire.count(WIREWORLD_EMPTY), 5u * 10u - 8u);
+}
+
+TEST(CellularAutomatonTest, BriansBrainCellsFireOnlyOnce) {
+    BriansBrain brain(8, 8);
+    brain.setState(3, 3, BRIANS_BRAIN_ON);
+    brain.setState(3, 4, BRIANS_BRAIN_ON);
+
+    brain.next();
+    EXPECT_EQ(brain.getState(3, 3), BRIANS_BRAIN_DYING);
+    EXPECT_EQ(brain.getState(3, 4), BRIANS_BRAIN_DYING);
+    // The cells above and below the pair have exactly 2 firing neighbors
+    EXPECT_EQ(brain.count(BRIANS_BRAIN_ON), 4u);
+    EXPECT_EQ(brain.getState(2, 3), BRIANS_BRAIN_ON);
+    EXPECT_EQ(brain.getState(4, 4), BRIANS_BRAIN_ON);
+
+    brain.next();
+    EXPECT_EQ(brain.getState(3, 3), BRIANS_BRAIN_OFF);
+}
+
+TEST(CellularAutomatonTest, StatesRoundTrip) {
+    const std::vector<unsigned char> states = randomStates(20, 30, 4, 3);
+    Wireworld first(20, 30);
+    first.loadStates(states.data());
+    EXPECT_EQ(statesOf(first), states);
+
+    // Building the board cell by cell (setState) has to derive the same neighbor counters
+    Wireworld second(20, 30);
+    for (unsigned int row = 0; row < 20; ++row) {
+        for (unsigned int col = 0; col < 30; ++col) {
+            second.setState(row, col, states[row * 30 + col]);
+        }
+    }
+    first.update(10);
+    second.update(10);
+    EXPECT_EQ(statesOf(first), statesOf(second));
+}
@@ -0,0 +1,74 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+#include "gtest/gtest.h"
+#include "game_of_life.hpp"
+#include "autotuner.hpp"
+#include <filesystem>
+#include <memory>
+
+// Test-Suite 4: Engine Auto-Tuner
+class AutoTunerTest : public ::testing::Test {
+protected:
+    std::string profileFile;
+
+    void SetUp() override {
+        profileFile = (std::filesystem::temp_directory_path() / "game_of_life_autotuner_test.profile").string();
+        std::filesystem::remove(profileFile);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(profileFile);
+    }
+};
+
+TEST_F(AutoTunerTest, CopyIsIndependentOfOriginal) {
+    std::unique_ptr<GameOfLife> original(GameOfLife::fromRandom(64, 64, 0.5, 1));
+    GameOfLife copy(*original);
+    const auto initialGrid = original->getGrid();
+    copy.update(5);
+    EXPECT_EQ(original->getGrid(), initialGrid);
+    EXPECT_NE(copy.getGrid(), initialGrid);
+}
+
+TEST_F(AutoTunerTest, TunedRunMatchesSequentialRun) {
+    const int generations = 20;
+    std::unique_ptr<GameOfLife> tuned(GameOfLife::fromRandom(200, 300, 0.5, 9, true, 1));
+    std::unique_ptr<GameOfLife> reference(GameOfLife::fromRandom(200, 300, 0.5, 9));
+
+    AutoTuner tuner(profileFile, 3);
+    const TuningChoice choice = tuner.tune(*tuned, 1, generations);
+    EXPECT_FALSE(choice.cached);
+    EXPECT_EQ(choice.generationsDone, 3);
+    runEngine(*tuned, choice.engine, generations - choice.generationsDone);
+
+    reference->update(generations);
+    EXPECT_EQ(tuned->getGrid(), reference->getGrid());
+}
+
+TEST_F(AutoTunerTest, ChoiceIsCachedInProfile) {
+    std::unique_ptr<GameOfLife> first(GameOfLife::fromRandom(128, 128, 0.45, 3));
+    std::unique_ptr<GameOfLife> second(GameOfLife::fromRandom(128, 128, 0.45, 4));
+
+    AutoTuner tuner(profileFile, 2);
+    const TuningChoice tuned = tuner.tune(*first, 1, 10);
+    ASSERT_TRUE(std::filesystem::exists(profileFile));
+
+    // Same size, density bucket, threads and CPU: the decision is taken from the profile
+    AutoTuner otherTuner(profileFile, 2);
+    const TuningChoice cached = otherTuner.tune(*second, 1, 10);
+    EXPECT_TRUE(cached.cached);
+    EXPECT_EQ(cached.generationsDone, 0);
+    EXPECT_EQ(cached.engine, tuned.engine);
+    EXPECT_EQ(cached.threads, tuned.threads);
+}
+
+TEST_F(AutoTunerTest, ProfileKeyDependsOnSizeAndDensity) {
+    std::unique_ptr<GameOfLife> sparse(GameOfLife::fromRandom(100, 100, 0.05, 1));
+    std::unique_ptr<GameOfLife> dense(GameOfLife::fromRandom(100, 100, 0.55, 1));
+    std::unique_ptr<GameOfLife> larger(GameOfLife::fromRandom(100, 200, 0.05, 1));
+    EXPECT_NE(AutoTuner::profileKey(*sparse, 1), AutoTuner::profileKey(*dense, 1));
+    EXPECT_NE(AutoTuner::profileKey(*sparse, 1), AutoTuner::profileKey(*larger, 1));
+    EXPECT_NE(AutoTuner::profileKey(*sparse, 1), AutoTuner::profileKey(*sparse, 2));
+    EXPECT_EQ(AutoTuner::profileKey(*sparse, 1).rfind("100x100;d0;t1;", 0), 0u);
+}
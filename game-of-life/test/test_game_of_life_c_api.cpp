@@ -0,0 +1,109 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+#include "gtest/gtest.h"
+#include "gol.hpp"
+#include "game_of_life.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Test-Suite 6: C API (shared library interface)
+static const std::string GLIDER =
+    "6,5\n"
+    "......\n"
+    "..x...\n"
+    "...x..\n"
+    ".xxx..\n"
+    "......\n";
+
+TEST(CApiTest, LoadExportRoundTrip) {
+    gol::Game game = gol::Game::load(GLIDER);
+    EXPECT_EQ(game.rows(), 5u);
+    EXPECT_EQ(game.columns(), 6u);
+    EXPECT_EQ(game.population(), 5u);
+    EXPECT_TRUE(game.alive(1, 2));
+    EXPECT_FALSE(game.alive(0, 0));
+    EXPECT_EQ(game.exportText(), GLIDER);
+}
+
+TEST(CApiTest, AcceptsWindowsLineEndings) {
+    gol::Game game = gol::Game::load("3,2\r\n.x.\r\nxx.\r\n");
+    EXPECT_EQ(game.population(), 3u);
+    EXPECT_EQ(game.exportText(), "3,2\n.x.\nxx.\n");
+}
+
+TEST(CApiTest, StepMatchesGameOfLife) {
+    std::unique_ptr<GameOfLife> reference(GameOfLife::fromRandom(120, 80, 0.4, 5));
+    std::vector<char> text(reference->toBuffer(nullptr, 0));
+    reference->toBuffer(text.data(), text.size());
+
+    gol::Game game = gol::Game::load(std::string(text.data(), text.size()));
+    game.step(25);
+    reference->update(25);
+
+    std::vector<unsigned char> cells(120 * 80);
+    game.getCells(cells.data(), cells.size());
+    for (unsigned int row = 0; row < 120; ++row) {
+        for (unsigned int col = 0; col < 80; ++col) {
+            ASSERT_EQ(cells[row * 80 + col] == 1, reference->cellState(row, col) == LIVE_CELL);
+        }
+    }
+    EXPECT_EQ(game.population(), reference->population());
+}
+
+TEST(CApiTest, CellsRoundTrip) {
+    std::vector<unsigned char> cells(4 * 7, 0);
+    cells[3] = cells[10] = cells[17] = 1; // Vertical blinker
+    gol::Game game(4, 7);
+    game.setCells(cells.data(), cells.size());
+    EXPECT_EQ(game.population(), 3u);
+
+    std::vector<unsigned char> exported(cells.size());
+    game.getCells(exported.data(), exported.size());
+    EXPECT_EQ(exported, cells);
+
+    game.step(2);
+    game.getCells(exported.data(), exported.size());
+    EXPECT_EQ(exported, cells);
+}
+
+TEST(CApiTest, ExportReportsRequiredSize) {
+    gol::Game game = gol::Game::load(GLIDER);
+    size_t required = 0;
+    EXPECT_EQ(gol_export(game.get(), nullptr, 0, &required), GOL_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_EQ(required, GLIDER.size());
+
+    std::vector<char> small(required - 1);
+    EXPECT_EQ(gol_export(game.get(), small.data(), small.size(), &required), GOL_ERROR_BUFFER_TOO_SMALL);
+    EXPECT_NE(std::string(gol_last_error()), "");
+
+    std::vector<char> exact(required);
+    size_t written = 0;
+    EXPECT_EQ(gol_export(game.get(), exact.data(), exact.size(), &written), GOL_OK);
+    EXPECT_EQ(std::string(exact.data(), written), GLIDER);
+    EXPECT_STREQ(gol_last_error(), "");
+}
+
+TEST(CApiTest, ErrorsAreReportedAsStatus) {
+    gol_game* game = nullptr;
+    EXPECT_EQ(gol_create(0, 10, 1, &game), GOL_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(gol_create(10, 10, 0, &game), GOL_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(gol_create(10, 10, maxAvailableThreads() + 1, &game), GOL_ERROR_THREADS);
+    EXPECT_EQ(game, nullptr);
+
+    const std::string broken = "3,2\n...\n..\n";
+    EXPECT_EQ(gol_load(broken.data(), broken.size(), 1, &game), GOL_ERROR_INVALID_FORMAT);
+    EXPECT_EQ(gol_load("x", 1, 1, &game), GOL_ERROR_INVALID_FORMAT);
+    EXPECT_EQ(game, nullptr);
+
+    EXPECT_EQ(gol_step(nullptr, 1), GOL_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(gol_cell(nullptr, 0, 0), -1);
+    EXPECT_EQ(gol_population(nullptr), 0u);
+    gol_destroy(nullptr);
+
+    gol::Game wrapped(3, 3);
+    EXPECT_THROW(wrapped.alive(3, 0), gol::Error);
+    unsigned char tooFew[4] = {};
+    EXPECT_THROW(wrapped.setCells(tooFew, sizeof(tooFew)), gol::Error);
+}
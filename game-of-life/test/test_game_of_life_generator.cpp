@@ -0,0 +1,81 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+#include "gtest/gtest.h"
+#include "game_of_life.hpp"
+#include "engine.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+// Test-Suite 3: Generated Boards
+struct GeneratorTestParams {
+    unsigned int rows;
+    unsigned int columns;
+    double density;
+    uint64_t seed;
+};
+
+class GeneratorTest : public ::testing::TestWithParam<GeneratorTestParams> {};
+
+TEST_P(GeneratorTest, SameSeedGeneratesSameBoard) {
+    GeneratorTestParams params = GetParam();
+    std::unique_ptr<GameOfLife> first(GameOfLife::fromRandom(params.rows, params.columns, params.density, params.seed));
+    std::unique_ptr<GameOfLife> second(GameOfLife::fromRandom(params.rows, params.columns, params.density, params.seed));
+    EXPECT_EQ(first->getGrid(), second->getGrid());
+}
+
+TEST_P(GeneratorTest, DifferentSeedGeneratesDifferentBoard) {
+    GeneratorTestParams params = GetParam();
+    std::unique_ptr<GameOfLife> first(GameOfLife::fromRandom(params.rows, params.columns, params.density, params.seed));
+    std::unique_ptr<GameOfLife> second(GameOfLife::fromRandom(params.rows, params.columns, params.density, params.seed + 1));
+    EXPECT_NE(first->getGrid(), second->getGrid());
+}
+
+TEST_P(GeneratorTest, PopulationMatchesDensity) {
+    GeneratorTestParams params = GetParam();
+    std::unique_ptr<GameOfLife> game(GameOfLife::fromRandom(params.rows, params.columns, params.density, params.seed));
+    const double cells = static_cast<double>(params.rows) * params.columns;
+    // NOTE Tolerance of three standard deviations (binomial distribution), at least 1%
+    const double tolerance = std::max(0.01, 3.0 * std::sqrt(params.density * (1.0 - params.density) / cells));
+    EXPECT_NEAR(static_cast<double>(game->population()) / cells, params.density, tolerance);
+}
+
+TEST_P(GeneratorTest, NeighborCountsMatchSeededBoard) {
+    // A board built cell by cell (setCell) from the generated states has to evolve identically
+    GeneratorTestParams params = GetParam();
+    std::unique_ptr<GameOfLife> generated(GameOfLife::fromRandom(params.rows, params.columns, params.density, params.seed));
+    GameOfLife seeded(params.rows, params.columns, false, 1, generated->getGrid());
+    generated->update(10);
+    seeded.update(10);
+    EXPECT_EQ(generated->getGrid(), seeded.getGrid());
+}
+
+TEST_P(GeneratorTest, EnginesAgreeOnGeneratedBoard) {
+    GeneratorTestParams params = GetParam();
+    std::unique_ptr<GameOfLife> sequential(GameOfLife::fromRandom(params.rows, params.columns, params.density, params.seed));
+    std::unique_ptr<GameOfLife> parallel(GameOfLife::fromRandom(params.rows, params.columns, params.density, params.seed, true, 1));
+    runEngine(*sequential, Engine::SEQUENTIAL, 25);
+    runEngine(*parallel, Engine::PARALLEL, 25);
+    EXPECT_EQ(sequential->getGrid(), parallel->getGrid());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    GameOfLifeGeneratorTests,
+    GeneratorTest,
+    ::testing::Values(
+        GeneratorTestParams{250, 1000, 0.5, 0},
+        GeneratorTestParams{100, 100, 0.3, 42},
+        GeneratorTestParams{512, 256, 0.1, 1234567890123ULL},
+        GeneratorTestParams{3, 7, 0.5, 7}
+    )
+);
+
+TEST(GeneratorEdgeCases, DensityBounds) {
+    std::unique_ptr<GameOfLife> empty(GameOfLife::fromRandom(64, 64, 0.0, 1));
+    std::unique_ptr<GameOfLife> full(GameOfLife::fromRandom(64, 64, 1.0, 1));
+    EXPECT_EQ(empty->population(), 0u);
+    EXPECT_EQ(full->population(), 64u * 64u);
+    EXPECT_THROW(GameOfLife::fromRandom(64, 64, 1.5, 1), std::runtime_error);
+    EXPECT_THROW(GameOfLife::fromRandom(0, 64, 0.5, 1), std::runtime_error);
+}
@@ -0,0 +1,50 @@
+﻿//
+// Created by RINI on 19/10/2026.
+//
+#include "gtest/gtest.h"
+#include "game_of_life.hpp"
+#include "multiprocess.hpp"
+#include <memory>
+
+// Test-Suite 7: Multi-Process Engine
+struct MultiProcessTestParams {
+    unsigned int rows;
+    unsigned int columns;
+    unsigned int workers;
+    int generations;
+    bool pin;
+};
+
+class MultiProcessTest : public ::testing::TestWithParam<MultiProcessTestParams> {
+protected:
+    void SetUp() override {
+        if (!multiProcessSupported()) {
+            GTEST_SKIP() << "Multi-process mode is not supported on this platform";
+        }
+    }
+};
+
+TEST_P(MultiProcessTest, MatchesSequentialEngine) {
+    MultiProcessTestParams params = GetParam();
+    std::unique_ptr<GameOfLife> sequential(GameOfLife::fromRandom(params.rows, params.columns, 0.35, 11));
+    std::unique_ptr<GameOfLife> distributed(GameOfLife::fromRandom(params.rows, params.columns, 0.35, 11));
+
+    sequential->update(params.generations);
+    runMultiProcess(*distributed, params.generations, MultiProcessConfig{params.workers, params.pin});
+    EXPECT_EQ(distributed->getGrid(), sequential->getGrid());
+    EXPECT_EQ(distributed->population(), sequential->population());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    GameOfLifeMultiProcessTests,
+    MultiProcessTest,
+    ::testing::Values(
+        MultiProcessTestParams{200, 150, 4, 50, false},
+        MultiProcessTestParams{101, 67, 3, 40, true},
+        MultiProcessTestParams{64, 64, 1, 25, false},
+        MultiProcessTestParams{9, 20, 9, 30, false},   // One row per worker
+        MultiProcessTestParams{5, 12, 8, 10, false},   // More workers than rows
+        MultiProcessTestParams{120, 90, 2, 1, false},
+        MultiProcessTestParams{120, 90, 2, 0, false}
+    )
+);